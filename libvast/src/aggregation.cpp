@@ -0,0 +1,261 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/aggregation.hpp"
+
+#include "vast/bitmap_algorithms.hpp"
+#include "vast/concept/hashable/uhash.hpp"
+#include "vast/concept/hashable/xxhash.hpp"
+#include "vast/detail/assert.hpp"
+#include "vast/detail/type_traits.hpp"
+#include "vast/table_slice.hpp"
+#include "vast/view.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace vast {
+
+namespace {
+
+// Adds a value to a partial sum. Ignores values that cannot be summed up.
+void accumulate(data& sum, data_view x) {
+  auto f = [&](auto y) {
+    using value_type = std::decay_t<decltype(y)>;
+    if constexpr (detail::is_any_v<value_type, integer, count, real,
+                                   duration>) {
+      if (auto s = caf::get_if<value_type>(&sum))
+        *s += y;
+      else if (caf::holds_alternative<caf::none_t>(sum))
+        sum = y;
+    }
+  };
+  caf::visit(f, x);
+}
+
+// Replaces the current extremum if the value is smaller or larger,
+// respectively. Ignores nil values.
+template <class Compare>
+void update_extremum(data& current, data_view x, Compare compare) {
+  if (caf::holds_alternative<caf::none_t>(x))
+    return;
+  auto value = materialize(x);
+  if (caf::holds_alternative<caf::none_t>(current) || compare(value, current))
+    current = std::move(value);
+}
+
+uint64_t digest(data_view x) {
+  return uhash<xxhash64>{}(materialize(x));
+}
+
+} // namespace
+
+aggregation::aggregation(aggregation_spec spec) : spec_{std::move(spec)} {
+  // nop
+}
+
+void aggregation::add(const table_slice& slice, const ids& selection) {
+  VAST_ASSERT(slice.encoding() != table_slice_encoding::none);
+  const auto& columns = columns_for(slice.layout());
+  // A field that resolves to several columns has the list of their values as
+  // key, and its aggregates include the values of all columns.
+  auto key_at = [&](size_t row, const std::vector<size_t>& xs) {
+    if (xs.empty())
+      return data{};
+    if (xs.size() == 1)
+      return materialize(slice.at(row, xs[0]));
+    auto result = list{};
+    result.reserve(xs.size());
+    for (auto column : xs)
+      result.push_back(materialize(slice.at(row, column)));
+    return data{std::move(result)};
+  };
+  auto range = make_ids({{slice.offset(), slice.offset() + slice.rows()}});
+  for (auto id : select(selection & range)) {
+    auto row = id - slice.offset();
+    auto key = data{};
+    if (columns.keys.size() == 1) {
+      key = key_at(row, columns.keys[0]);
+    } else {
+      auto xs = list{};
+      xs.reserve(columns.keys.size());
+      for (auto& field : columns.keys)
+        xs.push_back(key_at(row, field));
+      key = std::move(xs);
+    }
+    auto& g = find_or_add(std::move(key));
+    ++g.count;
+    for (size_t i = 0; i < columns.sum.size(); ++i)
+      for (auto column : columns.sum[i])
+        accumulate(g.sum[i], slice.at(row, column));
+    for (size_t i = 0; i < columns.min.size(); ++i)
+      for (auto column : columns.min[i])
+        update_extremum(g.min[i], slice.at(row, column), std::less<>{});
+    for (size_t i = 0; i < columns.max.size(); ++i)
+      for (auto column : columns.max[i])
+        update_extremum(g.max[i], slice.at(row, column), std::greater<>{});
+    for (size_t i = 0; i < columns.distinct.size(); ++i)
+      for (auto column : columns.distinct[i])
+        if (auto x = slice.at(row, column);
+            !caf::holds_alternative<caf::none_t>(x))
+          g.distinct[i].add(digest(x));
+  }
+  prune();
+}
+
+void aggregation::merge(const aggregation& other) {
+  // Groups that the other aggregation does not keep track of may have been
+  // evicted there, so their count grows by up to its threshold.
+  if (other.threshold_ > 0)
+    for (auto& [key, g] : groups_)
+      if (other.groups_.count(key) == 0) {
+        g.count += other.threshold_;
+        g.error += other.threshold_;
+      }
+  for (auto& [key, x] : other.groups_) {
+    auto [it, inserted] = groups_.try_emplace(key);
+    auto& g = it->second;
+    if (inserted) {
+      g = x;
+      g.count += threshold_;
+      g.error += threshold_;
+      continue;
+    }
+    g.count += x.count;
+    g.error += x.error;
+    for (size_t i = 0; i < g.sum.size(); ++i)
+      accumulate(g.sum[i], make_view(x.sum[i]));
+    for (size_t i = 0; i < g.min.size(); ++i)
+      update_extremum(g.min[i], make_view(x.min[i]), std::less<>{});
+    for (size_t i = 0; i < g.max.size(); ++i)
+      update_extremum(g.max[i], make_view(x.max[i]), std::greater<>{});
+    for (size_t i = 0; i < g.distinct.size(); ++i)
+      g.distinct[i].merge(x.distinct[i]);
+  }
+  threshold_ += other.threshold_;
+  prune();
+}
+
+const aggregation_spec& aggregation::spec() const {
+  return spec_;
+}
+
+size_t aggregation::size() const {
+  return groups_.size();
+}
+
+bool aggregation::empty() const {
+  return groups_.empty();
+}
+
+uint64_t aggregation::threshold() const {
+  return threshold_;
+}
+
+std::vector<record> aggregation::make_records() const {
+  std::vector<const std::pair<const data, group>*> sorted;
+  sorted.reserve(groups_.size());
+  for (auto& x : groups_)
+    sorted.push_back(&x);
+  std::sort(sorted.begin(), sorted.end(), [](auto lhs, auto rhs) {
+    if (lhs->second.count != rhs->second.count)
+      return lhs->second.count > rhs->second.count;
+    return lhs->first < rhs->first;
+  });
+  std::vector<record> result;
+  result.reserve(sorted.size());
+  for (auto x : sorted) {
+    auto& [key, g] = *x;
+    auto r = record{};
+    if (spec_.keys.size() == 1) {
+      r.emplace(spec_.keys[0], key);
+    } else {
+      auto& xs = caf::get<list>(key);
+      for (size_t i = 0; i < spec_.keys.size(); ++i)
+        r.emplace(spec_.keys[i], xs[i]);
+    }
+    r.emplace("count", count{g.count});
+    if (g.error > 0)
+      r.emplace("error", count{g.error});
+    auto add = [&](const char* function, const std::string& field, data y) {
+      r.emplace(function + ('(' + field + ')'), std::move(y));
+    };
+    for (size_t i = 0; i < g.sum.size(); ++i)
+      add("sum", spec_.sum[i], g.sum[i]);
+    for (size_t i = 0; i < g.min.size(); ++i)
+      add("min", spec_.min[i], g.min[i]);
+    for (size_t i = 0; i < g.max.size(); ++i)
+      add("max", spec_.max[i], g.max[i]);
+    for (size_t i = 0; i < g.distinct.size(); ++i)
+      add("distinct", spec_.distinct[i],
+          count{static_cast<count>(std::llround(g.distinct[i].estimate()))});
+    result.push_back(std::move(r));
+  }
+  return result;
+}
+
+const aggregation::columns&
+aggregation::columns_for(const record_type& layout) {
+  auto t = type{layout};
+  if (auto it = columns_.find(t); it != columns_.end())
+    return it->second;
+  auto resolve = [&](const std::vector<std::string>& fields) {
+    std::vector<std::vector<size_t>> result;
+    result.reserve(fields.size());
+    for (auto& field : fields)
+      result.push_back(resolve_columns(layout, {field}));
+    return result;
+  };
+  auto result = columns{resolve(spec_.keys), resolve(spec_.sum),
+                        resolve(spec_.min), resolve(spec_.max),
+                        resolve(spec_.distinct)};
+  return columns_.emplace(std::move(t), std::move(result)).first->second;
+}
+
+aggregation::group& aggregation::find_or_add(data&& key) {
+  auto [it, inserted] = groups_.try_emplace(std::move(key));
+  auto& g = it->second;
+  if (inserted) {
+    // The group may have been evicted before, so its count can be as high as
+    // the threshold.
+    g.count = threshold_;
+    g.error = threshold_;
+    g.sum.resize(spec_.sum.size());
+    g.min.resize(spec_.min.size());
+    g.max.resize(spec_.max.size());
+    g.distinct.resize(spec_.distinct.size());
+  }
+  return g;
+}
+
+void aggregation::prune() {
+  if (spec_.max_groups == 0 || groups_.size() <= spec_.max_groups)
+    return;
+  // Keep the most frequent half, such that evictions happen rarely.
+  auto keep = std::max(spec_.max_groups / 2, uint64_t{1});
+  std::vector<decltype(groups_)::iterator> xs;
+  xs.reserve(groups_.size());
+  for (auto it = groups_.begin(); it != groups_.end(); ++it)
+    xs.push_back(it);
+  auto more_frequent = [](auto lhs, auto rhs) {
+    return lhs->second.count > rhs->second.count;
+  };
+  std::nth_element(xs.begin(), xs.begin() + keep, xs.end(), more_frequent);
+  for (auto it = xs.begin() + keep; it != xs.end(); ++it) {
+    threshold_ = std::max(threshold_, (*it)->second.count);
+    groups_.erase(*it);
+  }
+}
+
+} // namespace vast
@@ -461,15 +461,6 @@ table_slice arrow_table_slice_builder::finish(
         : builder_.CreateVector(
           reinterpret_cast<const unsigned char*>(serialized_layout.data()),
           serialized_layout.size());
-  // Pack schema.
-#if ARROW_VERSION_MAJOR >= 2
-  auto flat_schema = arrow::ipc::SerializeSchema(*schema_).ValueOrDie();
-#else
-  auto flat_schema
-    = arrow::ipc::SerializeSchema(*schema_, nullptr).ValueOrDie();
-#endif
-  auto schema_buffer
-    = builder_.CreateVector(flat_schema->data(), flat_schema->size());
   // Pack record batch.
   auto columns = std::vector<std::shared_ptr<arrow::Array>>{};
   columns.reserve(column_builders_.size());
@@ -477,25 +468,56 @@ table_slice arrow_table_slice_builder::finish(
     columns.emplace_back(builder->finish());
   auto record_batch
     = arrow::RecordBatch::Make(schema_, rows_, std::move(columns));
+  // Reset the builder state.
+  rows_ = {};
+  return pack(builder_, layout_buffer, *record_batch, layout());
+}
+
+table_slice
+arrow_table_slice_builder::create(const arrow::RecordBatch& record_batch,
+                                  const record_type& layout,
+                                  size_t initial_buffer_size) {
+  VAST_ASSERT(record_batch.num_columns()
+              == detail::narrow_cast<int>(flatten(layout).fields.size()));
+  auto builder = flatbuffers::FlatBufferBuilder{initial_buffer_size};
+  auto layout_buffer = fbs::serialize_bytes(builder, layout);
+  if (!layout_buffer)
+    die("failed to serialize the layout of a record batch");
+  return pack(builder, *layout_buffer, record_batch, layout);
+}
+
+table_slice arrow_table_slice_builder::pack(
+  flatbuffers::FlatBufferBuilder& builder,
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> layout_buffer,
+  const arrow::RecordBatch& record_batch, const record_type& layout) {
+  // Pack schema.
+#if ARROW_VERSION_MAJOR >= 2
+  auto flat_schema
+    = arrow::ipc::SerializeSchema(*record_batch.schema()).ValueOrDie();
+#else
+  auto flat_schema
+    = arrow::ipc::SerializeSchema(*record_batch.schema(), nullptr).ValueOrDie();
+#endif
+  auto schema_buffer
+    = builder.CreateVector(flat_schema->data(), flat_schema->size());
+  // Pack record batch.
   auto flat_record_batch
-    = arrow::ipc::SerializeRecordBatch(*record_batch,
+    = arrow::ipc::SerializeRecordBatch(record_batch,
                                        arrow::ipc::IpcWriteOptions::Defaults())
         .ValueOrDie();
-  auto record_batch_buffer = builder_.CreateVector(flat_record_batch->data(),
-                                                   flat_record_batch->size());
+  auto record_batch_buffer = builder.CreateVector(flat_record_batch->data(),
+                                                  flat_record_batch->size());
   // Create Arrow-encoded table slices.
   auto arrow_table_slice_buffer = fbs::table_slice::arrow::Createv0(
-    builder_, layout_buffer, schema_buffer, record_batch_buffer);
+    builder, layout_buffer, schema_buffer, record_batch_buffer);
   // Create and finish table slice.
   auto table_slice_buffer
-    = fbs::CreateTableSlice(builder_, fbs::table_slice::TableSlice::arrow_v0,
+    = fbs::CreateTableSlice(builder, fbs::table_slice::TableSlice::arrow_v0,
                             arrow_table_slice_buffer.Union());
-  fbs::FinishTableSliceBuffer(builder_, table_slice_buffer);
-  // Reset the builder state.
-  rows_ = {};
+  fbs::FinishTableSliceBuffer(builder, table_slice_buffer);
   // Create the table slice from the chunk.
-  auto chunk = fbs::release(builder_);
-  return table_slice{std::move(chunk), table_slice::verify::no, layout()};
+  auto chunk = fbs::release(builder);
+  return table_slice{std::move(chunk), table_slice::verify::no, layout};
 }
 
 size_t arrow_table_slice_builder::rows() const noexcept {
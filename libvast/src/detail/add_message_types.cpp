@@ -13,6 +13,7 @@
 
 #include "vast/detail/add_message_types.hpp"
 
+#include "vast/aggregation.hpp"
 #include "vast/bitmap.hpp"
 #include "vast/command.hpp"
 #include "vast/config.hpp"
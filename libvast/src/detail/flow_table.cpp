@@ -0,0 +1,116 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/detail/flow_table.hpp"
+
+#include "vast/detail/assert.hpp"
+#include "vast/detail/narrow.hpp"
+
+namespace vast::detail {
+
+flow_table::flow_table(size_t max_size, bool community_id)
+  : max_size_{max_size}, community_id_{community_id} {
+  VAST_ASSERT(max_size_ > 0);
+  VAST_ASSERT(max_size_ < nil);
+}
+
+flow_state& flow_table::touch(const flow& x, uint64_t timestamp) {
+  if (auto i = index_.find(x); i != index_.end()) {
+    auto slot = i->second;
+    if (slot != tail_) {
+      unlink(slot);
+      link_back(slot);
+    }
+    auto& st = entries_[slot].state;
+    st.last = timestamp;
+    return st;
+  }
+  // Make room for the new flow by evicting the least recently used one.
+  if (index_.size() >= max_size_)
+    erase(head_);
+  index_type slot;
+  if (free_.empty()) {
+    slot = narrow_cast<index_type>(entries_.size());
+    entries_.emplace_back();
+  } else {
+    slot = free_.back();
+    free_.pop_back();
+  }
+  auto& e = entries_[slot];
+  e.key = x;
+  e.state.bytes = 0;
+  e.state.last = timestamp;
+  e.state.community_id_size = 0;
+  if (community_id_) {
+    auto n = community_id::compute<policy::base64>(
+      e.state.community_id_buffer.data(), x);
+    e.state.community_id_size = narrow_cast<uint8_t>(n);
+  }
+  index_.emplace(x, slot);
+  link_back(slot);
+  return e.state;
+}
+
+size_t flow_table::expire(uint64_t now, uint64_t max_age) {
+  // The age list is ordered by last access, so the first entry that is still
+  // active terminates the scan.
+  size_t result = 0;
+  while (head_ != nil && now > entries_[head_].state.last
+         && now - entries_[head_].state.last > max_age) {
+    erase(head_);
+    ++result;
+  }
+  return result;
+}
+
+void flow_table::clear() {
+  index_.clear();
+  entries_.clear();
+  free_.clear();
+  head_ = nil;
+  tail_ = nil;
+}
+
+void flow_table::unlink(index_type i) {
+  auto& e = entries_[i];
+  if (e.prev != nil)
+    entries_[e.prev].next = e.next;
+  else
+    head_ = e.next;
+  if (e.next != nil)
+    entries_[e.next].prev = e.prev;
+  else
+    tail_ = e.prev;
+  e.prev = nil;
+  e.next = nil;
+}
+
+void flow_table::link_back(index_type i) {
+  auto& e = entries_[i];
+  e.prev = tail_;
+  e.next = nil;
+  if (tail_ != nil)
+    entries_[tail_].next = i;
+  else
+    head_ = i;
+  tail_ = i;
+}
+
+void flow_table::erase(index_type i) {
+  VAST_ASSERT(i != nil);
+  unlink(i);
+  index_.erase(entries_[i].key);
+  free_.push_back(i);
+}
+
+} // namespace vast::detail
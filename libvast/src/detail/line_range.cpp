@@ -13,35 +13,73 @@
 
 #include "vast/detail/line_range.hpp"
 
-#include "vast/detail/absorb_line.hpp"
+#include "vast/detail/assert.hpp"
 #include "vast/detail/fdinbuf.hpp"
-#include "vast/logger.hpp"
+#include "vast/detail/string.hpp"
+
+#include <algorithm>
+#include <cstring>
 
 namespace vast {
 namespace detail {
 
-line_range::line_range(std::istream& input) : input_{input} {
+namespace {
+
+// The amount of input that the range tries to read at once.
+constexpr size_t chunk_size = 65'536;
+
+} // namespace
+
+line_range::line_range(std::istream& input)
+  : input_{input}, buffer_(chunk_size + padding) {
 }
 
-const std::string& line_range::get() const {
+std::string_view line_range::get() const {
   return line_;
 }
 
 void line_range::next_impl() {
-  if (!input_)
-    return;
+  line_ = {};
+  timed_out_ = false;
   // Get the next non-empty line.
-  do {
-    if (detail::absorb_line(input_, line_))
+  while (true) {
+    if (skip_newline_ && begin_ < end_) {
+      skip_newline_ = false;
+      if (buffer_[begin_] == '\n')
+        scanned_ = std::max(scanned_, ++begin_);
+    }
+    auto data = std::string_view{buffer_.data(), end_};
+    auto pos = find_first_of(data, '\n', '\r', scanned_);
+    if (pos != std::string_view::npos) {
+      auto line = data.substr(begin_, pos - begin_);
+      begin_ = scanned_ = pos + 1;
+      if (data[pos] == '\r') {
+        if (begin_ == end_)
+          skip_newline_ = true;
+        else if (data[begin_] == '\n')
+          scanned_ = ++begin_;
+      }
       ++line_number_;
-    else
-      break;
-  } while (line_.empty());
+      if (line.empty())
+        continue;
+      line_ = line;
+      return;
+    }
+    scanned_ = end_;
+    if (!fill()) {
+      // The last line may lack a line break.
+      if (!input_ && begin_ < end_) {
+        line_ = std::string_view{buffer_.data() + begin_, end_ - begin_};
+        begin_ = scanned_ = end_;
+        ++line_number_;
+      }
+      return;
+    }
+  }
 }
 
 void line_range::next() {
   VAST_ASSERT(!done());
-  line_.clear();
   next_impl();
 }
 
@@ -49,20 +87,11 @@ bool line_range::next_timeout(std::chrono::milliseconds timeout) {
   auto* p = dynamic_cast<fdinbuf*>(input_.rdbuf());
   if (p)
     p->read_timeout() = timeout;
-  // Clear if the previous read did not time out.
-  if (!timed_out_)
-    line_.clear();
-  // Try to read next line.
+  // Try to read next line. A partial line stays in the buffer until the rest
+  // of it arrives.
   next_impl();
-  timed_out_ = false;
-  if (p) {
-    timed_out_ = p->timed_out();
+  if (p)
     p->read_timeout() = std::nullopt;
-    // Clear error state if the read timed out
-    if (timed_out_) {
-      input_.clear();
-    }
-  }
   return timed_out_;
 }
 
@@ -70,13 +99,43 @@ bool line_range::done() const {
   return line_.empty() && !input_;
 }
 
-std::string& line_range::line() {
-  return line_;
-}
-
 size_t line_range::line_number() const {
   return line_number_;
 }
 
+bool line_range::fill() {
+  if (!input_)
+    return false;
+  // Move the unconsumed input to the front of the buffer.
+  if (begin_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+    scanned_ -= begin_;
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  // Grow the buffer for lines that exceed the chunk size.
+  if (buffer_.size() - padding - end_ < chunk_size / 2)
+    buffer_.resize(buffer_.size() * 2);
+  // Wait until input is available. This is where a detail::fdinbuf may time
+  // out.
+  auto* sb = input_.rdbuf();
+  using traits = std::istream::traits_type;
+  if (traits::eq_int_type(sb->sgetc(), traits::eof())) {
+    auto* p = dynamic_cast<fdinbuf*>(sb);
+    if (p && p->timed_out())
+      timed_out_ = true;
+    else
+      input_.setstate(std::ios::eofbit | std::ios::failbit);
+    return false;
+  }
+  // Take everything the stream buffer holds without blocking again.
+  auto space = buffer_.size() - padding - end_;
+  auto available = std::max(sb->in_avail(), std::streamsize{1});
+  auto n = sb->sgetn(buffer_.data() + end_,
+                     std::min(static_cast<size_t>(available), space));
+  end_ += static_cast<size_t>(n);
+  return n > 0;
+}
+
 } // namespace detail
 } // namespace vast
@@ -0,0 +1,242 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/detail/pcap_trace.hpp"
+
+#include "vast/detail/byte_swap.hpp"
+#include "vast/error.hpp"
+#include "vast/path.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+namespace vast::detail {
+
+namespace {
+
+// Magic numbers of the classic PCAP file header.
+constexpr uint32_t pcap_magic_microseconds = 0xa1b2c3d4;
+constexpr uint32_t pcap_magic_nanoseconds = 0xa1b23c4d;
+
+// Block types and constants of the PCAPNG format.
+constexpr uint32_t pcapng_section_header_block = 0x0a0d0d0a;
+constexpr uint32_t pcapng_interface_description_block = 0x00000001;
+constexpr uint32_t pcapng_enhanced_packet_block = 0x00000006;
+constexpr uint32_t pcapng_byte_order_magic = 0x1a2b3c4d;
+constexpr uint16_t pcapng_option_end = 0;
+constexpr uint16_t pcapng_option_if_tsresol = 9;
+
+// The only link type that the PCAP reader can decapsulate.
+constexpr uint32_t linktype_ethernet = 1;
+
+constexpr size_t pcap_file_header_size = 24;
+constexpr size_t pcap_record_header_size = 16;
+constexpr size_t pcapng_block_header_size = 8;
+
+constexpr uint64_t nanoseconds_per_second = 1'000'000'000;
+
+// Rounds up to the next multiple of 4, which PCAPNG uses for padding.
+constexpr size_t pad(size_t x) {
+  return (x + 3) & ~size_t{3};
+}
+
+// Converts a timestamp in ticks at a given resolution to nanoseconds.
+vast::time make_timestamp(uint64_t ticks, uint64_t ticks_per_second) {
+  auto secs = ticks / ticks_per_second;
+  auto frac = ticks % ticks_per_second;
+  auto ns = secs * nanoseconds_per_second;
+  if (ticks_per_second <= nanoseconds_per_second)
+    ns += frac * nanoseconds_per_second / ticks_per_second;
+  else
+    ns += frac / (ticks_per_second / nanoseconds_per_second);
+  return vast::time{duration{static_cast<duration::rep>(ns)}};
+}
+
+} // namespace
+
+template <class T>
+T pcap_trace::load(size_t offset) const {
+  static_assert(std::is_unsigned_v<T>);
+  T result;
+  std::memcpy(&result, chunk_->data() + offset, sizeof(T));
+  return swap_ ? byte_swap(result) : result;
+}
+
+size_t pcap_trace::remaining() const {
+  return chunk_->size() - offset_;
+}
+
+caf::expected<pcap_trace> pcap_trace::make(const path& filename) {
+  auto chk = chunk::mmap(filename);
+  if (!chk)
+    return make_error(ec::filesystem_error, "failed to mmap trace", filename);
+  // We walk the trace front to back exactly once.
+  ::madvise(const_cast<byte*>(chk->data()), chk->size(), MADV_SEQUENTIAL);
+  auto result = pcap_trace{std::move(chk)};
+  if (result.remaining() < sizeof(uint32_t))
+    return make_error(ec::format_error, "trace too short", filename);
+  auto magic = result.load<uint32_t>(0);
+  if (magic == pcapng_section_header_block) {
+    result.format_ = file_format::pcapng;
+    if (auto err = result.read_section_header())
+      return err;
+    return result;
+  }
+  if (magic == byte_swap(pcap_magic_microseconds)
+      || magic == byte_swap(pcap_magic_nanoseconds)) {
+    result.swap_ = true;
+    magic = byte_swap(magic);
+  }
+  if (magic != pcap_magic_microseconds && magic != pcap_magic_nanoseconds)
+    return make_error(ec::format_error, "unknown trace file magic", filename);
+  if (result.remaining() < pcap_file_header_size)
+    return make_error(ec::format_error, "truncated pcap file header");
+  if (result.load<uint32_t>(20) != linktype_ethernet)
+    return make_error(ec::format_error, "unsupported pcap link type");
+  result.resolutions_.push_back(magic == pcap_magic_nanoseconds
+                                  ? nanoseconds_per_second
+                                  : 1'000'000);
+  result.offset_ = pcap_file_header_size;
+  return result;
+}
+
+caf::expected<pcap_trace::packet> pcap_trace::next() {
+  if (format_ == file_format::pcapng)
+    return next_pcapng();
+  return next_pcap();
+}
+
+pcap_trace::pcap_trace(chunk_ptr chunk) : chunk_{std::move(chunk)} {
+  // nop
+}
+
+caf::expected<pcap_trace::packet> pcap_trace::next_pcap() {
+  if (remaining() == 0)
+    return make_error(ec::end_of_input, "reached end of trace");
+  if (remaining() < pcap_record_header_size)
+    return make_error(ec::format_error, "truncated pcap record header");
+  auto secs = load<uint32_t>(offset_);
+  auto frac = load<uint32_t>(offset_ + 4);
+  auto captured = load<uint32_t>(offset_ + 8);
+  offset_ += pcap_record_header_size;
+  if (remaining() < captured)
+    return make_error(ec::format_error, "truncated pcap record");
+  auto data = span<const byte>{chunk_->data() + offset_, captured};
+  offset_ += captured;
+  auto ticks_per_second = resolutions_[0];
+  auto ticks = uint64_t{secs} * ticks_per_second + frac;
+  return packet{make_timestamp(ticks, ticks_per_second), data};
+}
+
+caf::expected<pcap_trace::packet> pcap_trace::next_pcapng() {
+  while (true) {
+    if (remaining() == 0)
+      return make_error(ec::end_of_input, "reached end of trace");
+    if (remaining() < pcapng_block_header_size)
+      return make_error(ec::format_error, "truncated pcapng block header");
+    // A new section may change the byte order, so we must check for it
+    // before interpreting the block length.
+    if (load<uint32_t>(offset_) == pcapng_section_header_block) {
+      if (auto err = read_section_header())
+        return err;
+      continue;
+    }
+    auto type = load<uint32_t>(offset_);
+    auto length = size_t{load<uint32_t>(offset_ + 4)};
+    if (length < pcapng_block_header_size + 4 || length % 4 != 0
+        || length > remaining())
+      return make_error(ec::format_error, "invalid pcapng block length");
+    auto body = offset_ + pcapng_block_header_size;
+    auto body_size = length - pcapng_block_header_size - 4;
+    offset_ += length;
+    if (type == pcapng_interface_description_block) {
+      if (auto err = read_interface_description(body, body_size))
+        return err;
+    } else if (type == pcapng_enhanced_packet_block) {
+      constexpr size_t fixed_size = 20;
+      if (body_size < fixed_size)
+        return make_error(ec::format_error, "truncated enhanced packet block");
+      auto interface = load<uint32_t>(body);
+      if (interface >= resolutions_.size())
+        return make_error(ec::format_error, "unknown pcapng interface");
+      auto ticks = (uint64_t{load<uint32_t>(body + 4)} << 32)
+                   | load<uint32_t>(body + 8);
+      auto captured = size_t{load<uint32_t>(body + 12)};
+      if (pad(captured) > body_size - fixed_size)
+        return make_error(ec::format_error, "truncated enhanced packet data");
+      auto data = span<const byte>{chunk_->data() + body + fixed_size,
+                                   captured};
+      return packet{make_timestamp(ticks, resolutions_[interface]), data};
+    }
+    // We skip all other block types, e.g., statistics or name resolution.
+  }
+}
+
+caf::error pcap_trace::read_section_header() {
+  constexpr size_t fixed_size = 16;
+  if (remaining() < pcapng_block_header_size + fixed_size + 4)
+    return make_error(ec::format_error, "truncated pcapng section header");
+  // The byte-order magic determines the endianness of the entire section.
+  swap_ = false;
+  auto magic = load<uint32_t>(offset_ + pcapng_block_header_size);
+  if (magic == byte_swap(pcapng_byte_order_magic))
+    swap_ = true;
+  else if (magic != pcapng_byte_order_magic)
+    return make_error(ec::format_error, "invalid pcapng byte-order magic");
+  // A section header must at least hold its fixed fields, or we would never
+  // advance past it.
+  auto length = size_t{load<uint32_t>(offset_ + 4)};
+  if (length < pcapng_block_header_size + fixed_size + 4 || length % 4 != 0
+      || length > remaining())
+    return make_error(ec::format_error, "invalid pcapng section length");
+  // Interface IDs are scoped to their section.
+  resolutions_.clear();
+  offset_ += length;
+  return caf::none;
+}
+
+caf::error pcap_trace::read_interface_description(size_t body,
+                                                  size_t body_size) {
+  constexpr size_t fixed_size = 8;
+  if (body_size < fixed_size)
+    return make_error(ec::format_error, "truncated interface description");
+  if (load<uint16_t>(body) != linktype_ethernet)
+    return make_error(ec::format_error, "unsupported pcapng link type");
+  // Microsecond resolution is the default if no option overrides it.
+  uint64_t ticks_per_second = 1'000'000;
+  auto option = body + fixed_size;
+  auto end = body + body_size;
+  while (option + 4 <= end) {
+    auto code = load<uint16_t>(option);
+    auto length = size_t{load<uint16_t>(option + 2)};
+    if (code == pcapng_option_end || option + 4 + length > end)
+      break;
+    if (code == pcapng_option_if_tsresol && length >= 1) {
+      auto value = load<uint8_t>(option + 4);
+      auto exponent = value & 0x7f;
+      uint64_t base = value & 0x80 ? 2 : 10;
+      if (exponent > (base == 2 ? 63 : 19))
+        return make_error(ec::format_error, "invalid timestamp resolution");
+      ticks_per_second = 1;
+      for (auto i = 0; i < exponent; ++i)
+        ticks_per_second *= base;
+    }
+    option += 4 + pad(length);
+  }
+  resolutions_.push_back(ticks_per_second);
+  return caf::none;
+}
+
+} // namespace vast::detail
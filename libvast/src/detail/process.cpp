@@ -75,7 +75,8 @@ static caf::settings get_status_proc() {
       break;
     auto line = lines.get();
     if (!p(line))
-      VAST_WARNING_ANON("failed to parse /proc/self/status:", line);
+      VAST_WARNING_ANON("failed to parse /proc/self/status:",
+                        std::string{line});
   }
   return result;
 }
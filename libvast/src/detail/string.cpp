@@ -11,9 +11,14 @@
  * contained in the LICENSE file.                                             *
  ******************************************************************************/
 
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
+#if defined(__SSE2__) || defined(__AVX2__)
+#  include <immintrin.h>
+#endif
+
 #include "vast/detail/assert.hpp"
 #include "vast/detail/escapers.hpp"
 #include "vast/detail/string.hpp"
@@ -97,6 +102,70 @@ std::string replace_all(std::string str, std::string_view search,
   return str;
 }
 
+size_t find_first_of(std::string_view str, char a, char b, size_t pos) {
+  if (pos >= str.size())
+    return std::string_view::npos;
+  auto first = str.data() + pos;
+  auto last = str.data() + str.size();
+#if defined(__AVX2__)
+  auto va = _mm256_set1_epi8(a);
+  auto vb = _mm256_set1_epi8(b);
+  for (; last - first >= 32; first += 32) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    auto matches = _mm256_or_si256(_mm256_cmpeq_epi8(x, va),
+                                   _mm256_cmpeq_epi8(x, vb));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+    if (mask != 0)
+      return first - str.data() + __builtin_ctz(mask);
+  }
+#endif
+#if defined(__SSE2__)
+  auto xa = _mm_set1_epi8(a);
+  auto xb = _mm_set1_epi8(b);
+  for (; last - first >= 16; first += 16) {
+    auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    auto matches = _mm_or_si128(_mm_cmpeq_epi8(x, xa), _mm_cmpeq_epi8(x, xb));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+    if (mask != 0)
+      return first - str.data() + __builtin_ctz(mask);
+  }
+#endif
+  for (; first != last; ++first)
+    if (*first == a || *first == b)
+      return first - str.data();
+  return std::string_view::npos;
+}
+
+size_t find_json_escape(std::string_view str, size_t pos) {
+  if (pos >= str.size())
+    return std::string_view::npos;
+  auto first = str.data() + pos;
+  auto last = str.data() + str.size();
+#if defined(__SSE2__)
+  // Bytes up to 0x1f compare equal to their unsigned maximum with 0x1f.
+  auto control = _mm_set1_epi8(0x1f);
+  auto quote = _mm_set1_epi8('"');
+  auto backslash = _mm_set1_epi8('\\');
+  auto del = _mm_set1_epi8(0x7f);
+  for (; last - first >= 16; first += 16) {
+    auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    auto matches = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(_mm_max_epu8(x, control), control),
+                   _mm_cmpeq_epi8(x, del)),
+      _mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+    if (mask != 0)
+      return first - str.data() + __builtin_ctz(mask);
+  }
+#endif
+  for (; first != last; ++first) {
+    auto c = static_cast<unsigned char>(*first);
+    if (c < 0x20 || c == 0x7f || c == '"' || c == '\\')
+      return first - str.data();
+  }
+  return std::string_view::npos;
+}
+
 std::vector<std::string_view> split(std::string_view str, std::string_view sep,
                                     std::string_view esc, size_t max_splits,
                                     bool include_sep) {
@@ -112,11 +181,15 @@ std::vector<std::string_view> split(std::string_view str, std::string_view sep,
     pos.emplace_back(str.substr(distance(begin, first), distance(first, last)));
   };
   while (i != end) {
+    // Jump to the next candidate, which std::string_view::find locates with
+    // a vectorized memchr.
+    auto next = str.find(sep[0], i - begin);
+    if (next == std::string_view::npos)
+      break;
+    i = begin + next;
     // Find a separator that fits in the string.
-    if (*i != sep[0] || i + sep.size() > end) {
-      ++i;
-      continue;
-    }
+    if (i + sep.size() > end)
+      break;
     // Check remaining separator characters.
     size_t j = 1;
     auto s = i;
@@ -0,0 +1,340 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/detail/udp_receiver.hpp"
+
+#include "vast/config.hpp"
+#include "vast/detail/assert.hpp"
+#include "vast/error.hpp"
+#include "vast/logger.hpp"
+
+#include <caf/optional.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace vast::detail {
+
+namespace {
+
+// The receive thread wakes up at least this often to check for shutdown.
+constexpr auto receive_timeout_usec = 100'000;
+
+// Opens a UDP socket bound to the wildcard address. We prefer a dual-stack
+// IPv6 socket and fall back to IPv4 if the system lacks IPv6 support.
+int open_socket(uint16_t port) {
+  auto fd = ::socket(AF_INET6, SOCK_DGRAM, 0);
+  if (fd >= 0) {
+    int off = 0;
+    ::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    ::sockaddr_in6 sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sin6_family = AF_INET6;
+    sa.sin6_addr = in6addr_any;
+    sa.sin6_port = htons(port);
+    if (::bind(fd, reinterpret_cast<::sockaddr*>(&sa), sizeof(sa)) == 0)
+      return fd;
+    ::close(fd);
+  }
+  fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    return fd;
+  ::sockaddr_in sa;
+  std::memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_addr.s_addr = htonl(INADDR_ANY);
+  sa.sin_port = htons(port);
+  if (::bind(fd, reinterpret_cast<::sockaddr*>(&sa), sizeof(sa)) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+uint16_t local_port(int fd) {
+  ::sockaddr_storage sa;
+  ::socklen_t size = sizeof(sa);
+  if (::getsockname(fd, reinterpret_cast<::sockaddr*>(&sa), &size) != 0)
+    return 0;
+  if (sa.ss_family == AF_INET6)
+    return ntohs(reinterpret_cast<::sockaddr_in6*>(&sa)->sin6_port);
+  return ntohs(reinterpret_cast<::sockaddr_in*>(&sa)->sin_port);
+}
+
+void set_receive_buffer_size(int fd, size_t size) {
+  auto value = static_cast<int>(size);
+#ifdef SO_RCVBUFFORCE
+  // Privileged processes may exceed net.core.rmem_max.
+  if (::setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &value, sizeof(value)) == 0)
+    return;
+#endif
+  if (::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &value, sizeof(value)) != 0) {
+    VAST_WARNING_ANON("udp_receiver failed to set socket buffer size:",
+                      std::strerror(errno));
+    return;
+  }
+  auto actual = 0;
+  ::socklen_t length = sizeof(actual);
+  if (::getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &actual, &length) == 0
+      && static_cast<size_t>(actual) < size)
+    VAST_WARNING_ANON("udp_receiver got a socket buffer of", actual,
+                      "bytes instead of", size, "bytes; consider raising",
+                      "net.core.rmem_max");
+}
+
+} // namespace
+
+struct udp_receiver::message_headers {
+  explicit message_headers(size_t n) : iovecs(n), headers(n) {
+#if !VAST_LINUX
+    lengths.resize(n);
+#endif
+#ifdef SO_RXQ_OVFL
+    control.resize(n * control_size);
+#endif
+  }
+
+#if VAST_LINUX
+  ::msghdr& header(size_t i) {
+    return headers[i].msg_hdr;
+  }
+
+  size_t length(size_t i) const {
+    return headers[i].msg_len;
+  }
+#else
+  ::msghdr& header(size_t i) {
+    return headers[i];
+  }
+
+  size_t length(size_t i) const {
+    return lengths[i];
+  }
+#endif
+
+  std::vector<::iovec> iovecs;
+#if VAST_LINUX
+  std::vector<::mmsghdr> headers;
+#else
+  std::vector<::msghdr> headers;
+  std::vector<size_t> lengths;
+#endif
+#ifdef SO_RXQ_OVFL
+  static constexpr size_t control_size = CMSG_SPACE(sizeof(uint32_t));
+  std::vector<char> control;
+#endif
+};
+
+caf::expected<std::unique_ptr<udp_receiver>>
+udp_receiver::make(uint16_t port, options opts, std::function<void()> notify) {
+  if (opts.batch_size == 0 || opts.num_buffers == 0
+      || opts.max_datagram_size < 2)
+    return make_error(ec::invalid_configuration,
+                      "invalid udp receiver options");
+  auto fd = open_socket(port);
+  if (fd < 0)
+    return make_error(ec::system_error, "failed to open UDP socket on port",
+                      port, std::strerror(errno));
+  if (opts.socket_buffer_size > 0)
+    set_receive_buffer_size(fd, opts.socket_buffer_size);
+#ifdef SO_RXQ_OVFL
+  // Makes the kernel attach its drop counter to every received datagram.
+  int on = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+#endif
+  ::timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = receive_timeout_usec;
+  if (::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) != 0) {
+    auto err = make_error(ec::system_error, "failed to set receive timeout",
+                          std::strerror(errno));
+    ::close(fd);
+    return err;
+  }
+  auto result = std::unique_ptr<udp_receiver>{
+    new udp_receiver{fd, local_port(fd), opts, std::move(notify)}};
+  result->thread_ = std::thread{[ptr = result.get()] { ptr->run(); }};
+  return result;
+}
+
+udp_receiver::~udp_receiver() {
+  stop_ = true;
+  if (thread_.joinable())
+    thread_.join();
+  ::close(fd_);
+}
+
+uint16_t udp_receiver::port() const {
+  return port_;
+}
+
+udp_receiver::statistics udp_receiver::stats() const {
+  std::lock_guard<std::mutex> guard{mtx_};
+  return stats_;
+}
+
+size_t udp_receiver::consume(const std::function<void(span<char>, size_t)>& f) {
+  std::vector<size_t> batches;
+  {
+    std::lock_guard<std::mutex> guard{mtx_};
+    batches.swap(ready_);
+  }
+  for (auto i : batches) {
+    auto& buf = buffers_[i];
+    f(span<char>{buf.data.get(), buf.size}, buf.datagrams);
+  }
+  std::lock_guard<std::mutex> guard{mtx_};
+  free_.insert(free_.end(), batches.begin(), batches.end());
+  return batches.size();
+}
+
+udp_receiver::udp_receiver(int fd, uint16_t port, options opts,
+                           std::function<void()> notify)
+  : fd_{fd},
+    port_{port},
+    options_{opts},
+    notify_{std::move(notify)},
+    headers_{std::make_unique<message_headers>(opts.batch_size)} {
+  buffers_.resize(options_.num_buffers + 1);
+  for (auto& buf : buffers_)
+    buf.data.reset(
+      new char[options_.batch_size * options_.max_datagram_size]);
+  free_.reserve(options_.num_buffers);
+  ready_.reserve(options_.num_buffers);
+  for (size_t i = 0; i < options_.num_buffers; ++i)
+    free_.push_back(i);
+}
+
+void udp_receiver::run() {
+  auto scratch = buffers_.size() - 1;
+  while (!stop_) {
+    auto index = scratch;
+    {
+      std::lock_guard<std::mutex> guard{mtx_};
+      if (!free_.empty()) {
+        index = free_.back();
+        free_.pop_back();
+      }
+    }
+    auto n = receive(buffers_[index]);
+    auto error = errno;
+    auto notify = false;
+    {
+      std::lock_guard<std::mutex> guard{mtx_};
+      if (n > 0) {
+        stats_.received += n;
+        if (index == scratch) {
+          stats_.application_drops += n;
+        } else {
+          notify = ready_.empty();
+          ready_.push_back(index);
+        }
+      } else if (index != scratch) {
+        free_.push_back(index);
+      }
+    }
+    if (notify) {
+      notify_();
+    } else if (n < 0 && error != EAGAIN && error != EWOULDBLOCK
+               && error != EINTR) {
+      VAST_ERROR_ANON("udp_receiver failed to receive datagrams:",
+                      std::strerror(error));
+      return;
+    }
+  }
+}
+
+int udp_receiver::receive(buffer& buf) {
+  // Every datagram gets a slot of `max_datagram_size` bytes, leaving room for
+  // a trailing newline.
+  auto slot_size = options_.max_datagram_size;
+  auto n = options_.batch_size;
+  auto& hdrs = *headers_;
+  for (size_t i = 0; i < n; ++i) {
+    hdrs.iovecs[i].iov_base = buf.data.get() + i * slot_size;
+    hdrs.iovecs[i].iov_len = slot_size - 1;
+    auto& hdr = hdrs.header(i);
+    std::memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &hdrs.iovecs[i];
+    hdr.msg_iovlen = 1;
+#ifdef SO_RXQ_OVFL
+    hdr.msg_control = hdrs.control.data() + i * message_headers::control_size;
+    hdr.msg_controllen = message_headers::control_size;
+#endif
+  }
+  // Block until the first datagram arrives, then take whatever else is
+  // already queued without waiting any further.
+#if VAST_LINUX
+  auto received = ::recvmmsg(fd_, hdrs.headers.data(), n, MSG_WAITFORONE,
+                             nullptr);
+  if (received <= 0)
+    return -1;
+#else
+  auto received = 0;
+  for (; static_cast<size_t>(received) < n; ++received) {
+    auto flags = received == 0 ? 0 : MSG_DONTWAIT;
+    auto length = ::recvmsg(fd_, &hdrs.header(received), flags);
+    if (length < 0)
+      break;
+    hdrs.lengths[received] = static_cast<size_t>(length);
+  }
+  if (received == 0)
+    return -1;
+#endif
+  // Compact the datagrams into newline-delimited text. The write position
+  // never overtakes the start of the slot being read, so moving in place is
+  // safe.
+  size_t size = 0;
+  uint64_t truncated = 0;
+  caf::optional<uint32_t> kernel_drops;
+  for (auto i = 0; i < received; ++i) {
+    auto& hdr = hdrs.header(i);
+    if (hdr.msg_flags & MSG_TRUNC)
+      ++truncated;
+#ifdef SO_RXQ_OVFL
+    for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&hdr, cmsg))
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+        uint32_t drops;
+        std::memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+        kernel_drops = drops;
+      }
+#endif
+    auto length = hdrs.length(i);
+    auto first = buf.data.get() + i * slot_size;
+    auto out = buf.data.get() + size;
+    if (out != first)
+      std::memmove(out, first, length);
+    size += length;
+    if (length == 0 || out[length - 1] != '\n')
+      buf.data[size++] = '\n';
+  }
+  VAST_ASSERT(size <= n * slot_size);
+  buf.size = size;
+  buf.datagrams = static_cast<size_t>(received);
+  std::lock_guard<std::mutex> guard{mtx_};
+  stats_.truncated += truncated;
+  // The kernel reports a running total since the socket was opened.
+  if (kernel_drops)
+    stats_.kernel_drops = *kernel_drops;
+  return received;
+}
+
+} // namespace vast::detail
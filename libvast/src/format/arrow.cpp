@@ -22,26 +22,101 @@
 #  include "vast/detail/assert.hpp"
 #  include "vast/detail/byte_swap.hpp"
 #  include "vast/detail/fdoutbuf.hpp"
+#  include "vast/detail/narrow.hpp"
+#  include "vast/detail/posix.hpp"
 #  include "vast/detail/string.hpp"
 #  include "vast/error.hpp"
 #  include "vast/table_slice_builder.hpp"
 #  include "vast/type.hpp"
 
+#  include <caf/detail/scope_guard.hpp>
 #  include <caf/none.hpp>
+#  include <caf/settings.hpp>
 
+#  include <arrow/buffer.h>
 #  include <arrow/util/config.h>
 #  include <arrow/util/io_util.h>
 
+#  include <atomic>
+#  include <cerrno>
+#  include <cstring>
 #  include <stdexcept>
+#  include <string>
+
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
 
 namespace vast::format::arrow {
 
+namespace {
+
+// Writes a self-contained IPC stream with a single record batch.
+caf::error write_stream(::arrow::io::OutputStream& out,
+                        const ::arrow::RecordBatch& batch) {
+#  if ARROW_VERSION_MAJOR >= 2
+  auto stream_writer = ::arrow::ipc::MakeStreamWriter(&out, batch.schema());
+#  else
+  auto stream_writer = ::arrow::ipc::NewStreamWriter(&out, batch.schema());
+#  endif
+  if (!stream_writer.ok())
+    return make_error(ec::format_error, stream_writer.status().ToString());
+  if (auto status = (*stream_writer)->WriteRecordBatch(batch); !status.ok())
+    return make_error(ec::format_error, status.ToString());
+  if (auto status = (*stream_writer)->Close(); !status.ok())
+    return make_error(ec::format_error, status.ToString());
+  return caf::none;
+}
+
+// Creates an anonymous file in shared memory.
+caf::expected<int> make_shared_memory(size_t size) {
+#  if VAST_LINUX
+  auto fd = ::memfd_create("vast-arrow", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#  else
+  static std::atomic<size_t> counter = 0;
+  auto name = "/vast-arrow-" + std::to_string(::getpid()) + "-"
+              + std::to_string(counter++);
+  auto fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd >= 0)
+    ::shm_unlink(name.c_str());
+#  endif
+  if (fd < 0)
+    return make_error(ec::system_error, "failed to create shared memory:",
+                      std::strerror(errno));
+  if (::ftruncate(fd, size) != 0) {
+    auto err = make_error(ec::system_error, "failed to resize shared memory:",
+                          std::strerror(errno));
+    ::close(fd);
+    return err;
+  }
+  return fd;
+}
+
+} // namespace
+
 writer::writer() {
   out_ = std::make_shared<::arrow::io::StdoutStream>();
 }
 
-writer::writer(const caf::settings&) {
-  out_ = std::make_shared<::arrow::io::StdoutStream>();
+writer::writer(const caf::settings& options) {
+  auto path = caf::get_if<std::string>(&options, "vast.export.arrow."
+                                                 "shared-memory");
+  if (!path) {
+    out_ = std::make_shared<::arrow::io::StdoutStream>();
+    return;
+  }
+  auto uds = detail::unix_domain_socket::connect(*path);
+  if (!uds) {
+    config_error_ = make_error(ec::filesystem_error,
+                               "failed to connect to UNIX domain socket",
+                               *path);
+    return;
+  }
+  socket_ = std::shared_ptr<detail::unix_domain_socket>{
+    new detail::unix_domain_socket{uds}, [](detail::unix_domain_socket* x) {
+      ::close(x->fd);
+      delete x;
+    }};
 }
 
 writer::~writer() {
@@ -49,6 +124,13 @@ writer::~writer() {
 }
 
 caf::error writer::write(const table_slice& slice) {
+  if (config_error_)
+    return config_error_;
+  if (socket_) {
+    auto batch = as_record_batch(slice);
+    VAST_ASSERT(batch != nullptr);
+    return write_shared(*batch);
+  }
   if (out_ == nullptr)
     return ec::filesystem_error;
   if (!layout(slice.layout()))
@@ -65,6 +147,43 @@ const char* writer::name() const {
   return "arrow-writer";
 }
 
+caf::error writer::write_shared(const ::arrow::RecordBatch& batch) {
+  // Measure the stream first, since the size of shared memory is fixed once
+  // the receiver maps it.
+  auto mock = ::arrow::io::MockOutputStream{};
+  if (auto err = write_stream(mock, batch))
+    return err;
+  auto size = detail::narrow_cast<size_t>(mock.GetExtentBytesWritten());
+  auto fd = make_shared_memory(size);
+  if (!fd)
+    return std::move(fd.error());
+  auto guard = caf::detail::make_scope_guard([&] { ::close(*fd); });
+  auto addr
+    = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+  if (addr == MAP_FAILED)
+    return make_error(ec::system_error, "failed to map shared memory:",
+                      std::strerror(errno));
+  auto buffer = std::make_shared<::arrow::MutableBuffer>(
+    static_cast<uint8_t*>(addr), size);
+  auto out = ::arrow::io::FixedSizeBufferWriter{buffer};
+  auto err = write_stream(out, batch);
+  ::munmap(addr, size);
+  if (err)
+    return err;
+#  if VAST_LINUX
+  // Seal the file so that the receiver can rely on its contents.
+  if (::fcntl(*fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL)
+      != 0)
+    return make_error(ec::system_error, "failed to seal shared memory:",
+                      std::strerror(errno));
+#  endif
+  if (!socket_->send_fd(*fd))
+    return make_error(ec::filesystem_error, "failed to pass shared memory "
+                                            "over UNIX domain socket");
+  return caf::none;
+}
+
 bool writer::layout(const record_type& x) {
   if (current_layout_ == x)
     return true;
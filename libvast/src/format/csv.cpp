@@ -448,7 +448,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
     bool timed_out = next_line();
     if (timed_out)
       return ec::stalled;
-    auto& line = lines_->get();
+    auto line = lines_->get();
     if (line.empty()) {
       // Ignore empty lines.
       VAST_DEBUG(this, "ignores empty line at", lines_->line_number());
@@ -458,7 +458,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
     if (!p(line)) {
       if (num_invalid_lines_ == 0)
         VAST_WARNING(this, "failed to parse line", lines_->line_number(), ":",
-                     line);
+                     std::string{line});
       ++num_invalid_lines_;
       continue;
     }
@@ -16,10 +16,15 @@
 #include "vast/concept/parseable/vast/address.hpp"
 #include "vast/concept/parseable/vast/subnet.hpp"
 #include "vast/concept/parseable/vast/time.hpp"
+#include "vast/concept/printable/std/chrono.hpp"
 #include "vast/concept/printable/to_string.hpp"
+#include "vast/concept/printable/vast/address.hpp"
 #include "vast/concept/printable/vast/data.hpp"
 #include "vast/concept/printable/vast/json.hpp"
+#include "vast/concept/printable/vast/subnet.hpp"
 #include "vast/data.hpp"
+#include "vast/detail/overload.hpp"
+#include "vast/detail/string.hpp"
 #include "vast/format/json.hpp"
 #include "vast/logger.hpp"
 #include "vast/policy/flatten_layout.hpp"
@@ -33,6 +38,10 @@
 #include <caf/expected.hpp>
 #include <caf/none.hpp>
 
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
 namespace vast::format::json {
 namespace {
 
@@ -197,19 +206,149 @@ const vast::json* lookup(std::string_view field, const vast::json::object& xs) {
 
 } // namespace
 
+namespace {
+
+// The buffered output size at which the writer hands the buffer to the
+// output stream.
+constexpr size_t flush_threshold = 1 << 20;
+
+// Accumulates the output fragments of a record, which surround the values of
+// its fields.
+void make_fragments(const record_type& layout, std::string& pending,
+                    std::vector<type>& types,
+                    std::vector<std::string>& prefixes) {
+  pending += '{';
+  for (size_t i = 0; i < layout.fields.size(); ++i) {
+    const auto& field = layout.fields[i];
+    if (i > 0)
+      pending += ", ";
+    pending += detail::json_escape(field.name);
+    pending += ": ";
+    if (const auto r = caf::get_if<record_type>(&field.type)) {
+      make_fragments(*r, pending, types, prefixes);
+    } else {
+      types.push_back(field.type);
+      prefixes.push_back(std::move(pending));
+      pending.clear();
+    }
+  }
+  pending += '}';
+}
+
+// Formats a real like the JSON printer: with six decimal places, without
+// trailing zeros, and without a fractional part for integral values.
+std::string_view format_real(real x, char (&buf)[512]) {
+  auto n = std::snprintf(buf, sizeof(buf), "%f", x);
+  auto result = std::string_view{buf, static_cast<size_t>(n)};
+  auto i = real{0};
+  if (std::modf(x, &i) == 0.0)
+    return result.substr(0, result.find('.'));
+  return result.substr(0, result.find_last_not_of('0') + 1);
+}
+
+} // namespace
+
 writer::writer(ostream_ptr out, const caf::settings& options)
   : super{std::move(out)} {
   flatten_ = get_or(options, "vast.export.json.flatten", false);
+  buf_.reserve(flush_threshold);
 }
 
 caf::error writer::write(const table_slice& x) {
-  json_printer<policy::oneline> printer;
+  const auto& st = state_for(x.layout());
+  for (size_t row = 0; row < x.rows(); ++row) {
+    for (size_t column = 0; column < st.types.size(); ++column) {
+      append(st.prefixes[column]);
+      const auto& t = st.types[column];
+      auto value = x.at(row, column, t);
+      if (caf::holds_alternative<enumeration_type>(t))
+        value = to_canonical(t, value);
+      append_value(value);
+    }
+    append(st.suffix);
+    if (buf_.size() >= flush_threshold)
+      write_buf();
+  }
+  write_buf();
+  return caf::none;
+}
+
+const writer::layout_state& writer::state_for(const record_type& layout) {
+  for (const auto& st : layouts_)
+    if (st.layout == layout)
+      return st;
+  auto& st = layouts_.emplace_back();
+  st.layout = layout;
+  auto pending = std::string{};
   if (flatten_)
-    return print<policy::include_field_names, policy::flatten_layout>(
-      printer, x, {", ", ": ", "{", "}"});
+    make_fragments(flatten(layout), pending, st.types, st.prefixes);
   else
-    return print<policy::include_field_names>(printer, x,
-                                              {", ", ": ", "{", "}"});
+    make_fragments(layout, pending, st.types, st.prefixes);
+  st.suffix = std::move(pending);
+  st.suffix += '\n';
+  return st;
+}
+
+void writer::append_value(data_view x) {
+  auto out = std::back_inserter(buf_);
+  auto f = detail::overload{
+    [&](caf::none_t) { append("null"); },
+    [&](bool b) { append(b ? "true" : "false"); },
+    [&](integer i) {
+      char digits[32];
+      auto end = std::to_chars(digits, digits + sizeof(digits), i).ptr;
+      append(std::string_view{digits, static_cast<size_t>(end - digits)});
+    },
+    [&](count c) {
+      char digits[32];
+      auto end = std::to_chars(digits, digits + sizeof(digits), c).ptr;
+      append(std::string_view{digits, static_cast<size_t>(end - digits)});
+    },
+    [&](real r) {
+      char digits[512];
+      append(format_real(r, digits));
+    },
+    [&](duration d) {
+      append('"');
+      make_printer<duration>{}.print(out, d);
+      append('"');
+    },
+    [&](time t) {
+      append('"');
+      make_printer<time>{}.print(out, t);
+      append('"');
+    },
+    [&](std::string_view str) {
+      // Copy runs of characters that need no escaping in one go.
+      append('"');
+      auto pos = size_t{0};
+      for (auto i = detail::find_json_escape(str); i != std::string_view::npos;
+           i = detail::find_json_escape(str, pos)) {
+        append(str.substr(pos, i - pos));
+        auto c = str.begin() + i;
+        detail::json_escaper(c, out);
+        pos = i + 1;
+      }
+      append(str.substr(pos));
+      append('"');
+    },
+    [&](view<address> a) {
+      append('"');
+      make_printer<address>{}.print(out, a);
+      append('"');
+    },
+    [&](view<subnet> sn) {
+      append('"');
+      make_printer<subnet>{}.print(out, sn);
+      append('"');
+    },
+    [&](const auto& y) {
+      // Patterns and containers are rare enough to go through the generic
+      // JSON printer.
+      json_printer<policy::oneline>{}.print(out, data_view{y});
+    },
+  };
+  caf::visit(f, x);
 }
 
 const char* writer::name() const {
@@ -0,0 +1,322 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/config.hpp"
+
+#if VAST_ENABLE_PARQUET
+
+#  include "vast/format/parquet.hpp"
+
+#  include "vast/arrow_table_slice_builder.hpp"
+#  include "vast/detail/assert.hpp"
+#  include "vast/detail/narrow.hpp"
+#  include "vast/error.hpp"
+#  include "vast/factory.hpp"
+#  include "vast/logger.hpp"
+#  include "vast/table_slice.hpp"
+#  include "vast/table_slice_builder.hpp"
+#  include "vast/table_slice_builder_factory.hpp"
+
+#  include <caf/binary_deserializer.hpp>
+#  include <caf/binary_serializer.hpp>
+#  include <caf/none.hpp>
+#  include <caf/settings.hpp>
+
+#  include <arrow/table.h>
+#  include <arrow/util/key_value_metadata.h>
+
+#  include <algorithm>
+#  include <istream>
+#  include <iterator>
+
+namespace vast::format::parquet {
+
+namespace {
+
+caf::error to_error(const ::arrow::Status& status) {
+  return make_error(ec::format_error, status.ToString());
+}
+
+caf::expected<::parquet::Compression::type>
+to_compression(std::string_view name) {
+  if (name == "uncompressed")
+    return ::parquet::Compression::UNCOMPRESSED;
+  if (name == "snappy")
+    return ::parquet::Compression::SNAPPY;
+  if (name == "gzip")
+    return ::parquet::Compression::GZIP;
+  if (name == "brotli")
+    return ::parquet::Compression::BROTLI;
+  if (name == "lz4")
+    return ::parquet::Compression::LZ4;
+  if (name == "zstd")
+    return ::parquet::Compression::ZSTD;
+  return make_error(ec::invalid_configuration,
+                    "invalid Parquet compression:", std::string{name});
+}
+
+// Derives a file name from the layout name that is unique among the files
+// of a writer.
+std::string file_name(const std::string& layout_name, size_t collisions) {
+  auto result = layout_name.empty() ? std::string{"unnamed"} : layout_name;
+  std::replace(result.begin(), result.end(), '/', '_');
+  if (collisions > 0)
+    result += '-' + std::to_string(collisions);
+  return result + ".parquet";
+}
+
+} // namespace
+
+// -- writer -------------------------------------------------------------------
+
+writer::writer(const caf::settings& options) {
+  auto category = std::string{defaults::category};
+  directory_ = get_or(options, category + ".write",
+                      std::string{defaults::write});
+  row_group_size_ = detail::narrow_cast<int64_t>(get_or(
+    options, category + ".row-group-size", defaults::row_group_size));
+  auto builder = ::parquet::WriterProperties::Builder{};
+  // Version 2 of the format is necessary to store nanosecond timestamps.
+  builder.version(::parquet::ParquetVersion::PARQUET_2_0);
+  auto compression
+    = to_compression(get_or(options, category + ".compression",
+                            std::string{defaults::compression}));
+  if (compression)
+    builder.compression(*compression);
+  else
+    config_error_ = std::move(compression.error());
+  if (get_or(options, category + ".dictionary", defaults::dictionary))
+    builder.enable_dictionary();
+  else
+    builder.disable_dictionary();
+  properties_ = builder.build();
+  if (row_group_size_ <= 0)
+    config_error_ = make_error(ec::invalid_configuration,
+                               "Parquet row group size must be positive");
+}
+
+writer::~writer() {
+  for (auto& file : files_)
+    if (auto err = close(*file))
+      VAST_ERROR(this, "failed to close Parquet file for",
+                 file->layout.name(), ":", render(err));
+}
+
+caf::error writer::write(const table_slice& x) {
+  if (config_error_)
+    return config_error_;
+  auto file = file_for(x.layout());
+  if (!file)
+    return std::move(file.error());
+  auto batch = as_record_batch(x);
+  VAST_ASSERT(batch != nullptr);
+  (*file)->rows += batch->num_rows();
+  (*file)->batches.push_back(std::move(batch));
+  if ((*file)->rows >= row_group_size_)
+    return write_row_groups(**file);
+  return caf::none;
+}
+
+const char* writer::name() const {
+  return "parquet-writer";
+}
+
+caf::expected<writer::file_state*>
+writer::file_for(const record_type& layout) {
+  size_t collisions = 0;
+  for (auto& file : files_) {
+    if (file->layout == layout)
+      return file.get();
+    if (file->layout.name() == layout.name())
+      ++collisions;
+  }
+  if (!exists(directory_))
+    if (auto err = mkdir(directory_))
+      return err;
+  auto filename = directory_ / file_name(layout.name(), collisions);
+  auto file = std::make_unique<file_state>();
+  file->layout = layout;
+  auto out = ::arrow::io::FileOutputStream::Open(filename.str());
+  if (!out.ok())
+    return to_error(out.status());
+  file->out = std::move(*out);
+  // Store the layout alongside the Arrow schema, which allows for restoring
+  // type names and attributes when reading the file.
+  std::vector<char> buf;
+  caf::binary_serializer sink{nullptr, buf};
+  if (auto err = sink(layout))
+    return err;
+  auto schema = make_arrow_schema(flatten(layout));
+  auto metadata = schema->metadata()
+                    ? schema->metadata()->Copy()
+                    : std::make_shared<::arrow::KeyValueMetadata>();
+  metadata->Append(layout_key, std::string{buf.begin(), buf.end()});
+  auto arrow_properties
+    = ::parquet::ArrowWriterProperties::Builder{}.store_schema()->build();
+  auto status = ::parquet::arrow::FileWriter::Open(
+    *schema->WithMetadata(metadata), ::arrow::default_memory_pool(), file->out,
+    properties_, arrow_properties, &file->writer);
+  if (!status.ok())
+    return to_error(status);
+  VAST_INFO(this, "writes", layout.name(), "events to", filename);
+  files_.push_back(std::move(file));
+  return files_.back().get();
+}
+
+caf::error writer::write_row_groups(file_state& file) {
+  if (file.rows == 0)
+    return caf::none;
+  auto table = ::arrow::Table::FromRecordBatches(file.batches);
+  if (!table.ok())
+    return to_error(table.status());
+  file.batches.clear();
+  file.rows = 0;
+  if (auto status = file.writer->WriteTable(**table, row_group_size_);
+      !status.ok())
+    return to_error(status);
+  return caf::none;
+}
+
+caf::error writer::close(file_state& file) {
+  if (file.writer == nullptr)
+    return caf::none;
+  if (auto err = write_row_groups(file))
+    return err;
+  if (auto status = file.writer->Close(); !status.ok())
+    return to_error(status);
+  file.writer = nullptr;
+  if (auto status = file.out->Close(); !status.ok())
+    return to_error(status);
+  return caf::none;
+}
+
+// -- reader -------------------------------------------------------------------
+
+reader::reader(const caf::settings& options, std::unique_ptr<std::istream> in)
+  : super{options}, input_{std::move(in)} {
+  using defaults = vast::defaults::import::parquet;
+  filename_ = get_or(options, std::string{defaults::category} + ".read",
+                     std::string{defaults::read});
+}
+
+reader::~reader() {
+  // nop
+}
+
+caf::error reader::schema(vast::schema) {
+  // The layout is part of the Parquet file.
+  return caf::none;
+}
+
+vast::schema reader::schema() const {
+  vast::schema result;
+  if (!layout_.fields.empty())
+    result.add(layout_);
+  return result;
+}
+
+const char* reader::name() const {
+  return "parquet-reader";
+}
+
+caf::error reader::open() {
+  // Map regular files and read everything else into memory, since Parquet
+  // keeps its metadata at the end of the file.
+  std::shared_ptr<::arrow::io::RandomAccessFile> file;
+  if (auto p = path{filename_}; filename_ != "-" && p.is_regular_file()) {
+    auto mapped = ::arrow::io::MemoryMappedFile::Open(
+      filename_, ::arrow::io::FileMode::READ);
+    if (!mapped.ok())
+      return to_error(mapped.status());
+    file = std::move(*mapped);
+  } else {
+    VAST_ASSERT(input_ != nullptr);
+    auto bytes = std::string{std::istreambuf_iterator<char>{*input_},
+                             std::istreambuf_iterator<char>{}};
+    file = std::make_shared<::arrow::io::BufferReader>(
+      ::arrow::Buffer::FromString(std::move(bytes)));
+  }
+  if (auto status = ::parquet::arrow::OpenFile(
+        file, ::arrow::default_memory_pool(), &file_);
+      !status.ok())
+    return to_error(status);
+  std::shared_ptr<::arrow::Schema> schema;
+  if (auto status = file_->GetSchema(&schema); !status.ok())
+    return to_error(status);
+  auto metadata = schema->metadata();
+  auto index = metadata ? metadata->FindKey(layout_key) : -1;
+  if (index < 0)
+    return make_error(ec::format_error, "Parquet file has no VAST layout");
+  auto serialized = metadata->value(index);
+  caf::binary_deserializer source{nullptr, serialized.data(),
+                                  serialized.size()};
+  if (auto err = source(layout_))
+    return err;
+  if (!schema->Equals(*make_arrow_schema(flatten(layout_)), false))
+    return make_error(ec::format_error,
+                      "Parquet schema does not match the VAST layout",
+                      layout_.name());
+  std::vector<int> row_groups(file_->num_row_groups());
+  for (size_t i = 0; i < row_groups.size(); ++i)
+    row_groups[i] = detail::narrow_cast<int>(i);
+  if (auto status = file_->GetRecordBatchReader(row_groups, &batches_);
+      !status.ok())
+    return to_error(status);
+  return caf::none;
+}
+
+caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
+                             consumer& f) {
+  if (batches_ == nullptr)
+    if (auto err = open())
+      return err;
+  size_t produced = 0;
+  while (produced < max_events) {
+    if (batch_ == nullptr || offset_ == batch_->num_rows()) {
+      if (auto status = batches_->ReadNext(&batch_); !status.ok())
+        return to_error(status);
+      offset_ = 0;
+      if (batch_ == nullptr)
+        return make_error(ec::end_of_input, "Parquet file exhausted");
+      continue;
+    }
+    auto rows = std::min({detail::narrow_cast<size_t>(batch_->num_rows()
+                                                      - offset_),
+                          max_events - produced, max_slice_size});
+    auto sliced = batch_->Slice(offset_, detail::narrow_cast<int64_t>(rows));
+    offset_ += detail::narrow_cast<int64_t>(rows);
+    produced += rows;
+    auto slice = arrow_table_slice_builder::create(*sliced, layout_);
+    if (table_slice_type_ == table_slice_encoding::arrow) {
+      f(std::move(slice));
+      continue;
+    }
+    // Re-encode the rows for other table slice encodings.
+    auto builder = factory<table_slice_builder>::make(table_slice_type_,
+                                                      layout_);
+    if (builder == nullptr)
+      return make_error(ec::format_error, "failed to create table slice "
+                                          "builder");
+    for (size_t row = 0; row < slice.rows(); ++row)
+      for (size_t column = 0; column < slice.columns(); ++column)
+        if (!builder->add(slice.at(row, column)))
+          return make_error(ec::format_error, "failed to add value to table "
+                                              "slice builder");
+    f(builder->finish());
+  }
+  return caf::none;
+}
+
+} // namespace vast::format::parquet
+
+#endif // VAST_ENABLE_PARQUET
@@ -33,6 +33,7 @@
 #  include <caf/config_value.hpp>
 #  include <caf/settings.hpp>
 
+#  include <algorithm>
 #  include <string>
 #  include <thread>
 #  include <utility>
@@ -67,16 +68,33 @@ inline const auto pcap_packet_type_community_id = make_packet_type(
 
 } // namespace <anonymous>
 
+namespace {
+
+using defaults_t = vast::defaults::import::pcap;
+
+size_t max_flows(const caf::settings& options) {
+  std::string category = defaults_t::category;
+  auto result = get_or(options, category + ".max-flows", defaults_t::max_flows);
+  return std::max(result, size_t{1});
+}
+
+bool community_id_enabled(const caf::settings& options) {
+  std::string category = defaults_t::category;
+  return !get_or(options, category + ".disable-community-id", false);
+}
+
+} // namespace <anonymous>
+
 reader::reader(const caf::settings& options, std::unique_ptr<std::istream>)
-  : super(options) {
-  using defaults_t = vast::defaults::import::pcap;
+  : super(options),
+    max_flows_{max_flows(options)},
+    flows_{max_flows_, community_id_enabled(options)} {
   using caf::get_if;
   std::string category = defaults_t::category;
   if (auto interface = get_if<std::string>(&options, category + ".interface"))
     interface_ = *interface;
   input_ = get_or(options, category + ".read", defaults_t::read);
   cutoff_ = get_or(options, category + ".cutoff", defaults_t::cutoff);
-  max_flows_ = get_or(options, category + ".max-flows", defaults_t::max_flows);
   max_age_
     = get_or(options, category + ".max-flow-age", defaults_t::max_flow_age);
   expire_interval_
@@ -86,7 +104,7 @@ reader::reader(const caf::settings& options, std::unique_ptr<std::istream>)
   snaplen_ = get_or(options, category + ".snaplen", defaults_t::snaplen);
   drop_rate_threshold_
     = get_or(options, category + ".drop-rate-threshold", 0.05);
-  community_id_ = !get_or(options, category + ".disable-community-id", false);
+  community_id_ = community_id_enabled(options);
   packet_type_
     = community_id_ ? pcap_packet_type_community_id : pcap_packet_type;
   last_stats_ = {};
@@ -216,7 +234,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
   // Local buffer for storing error messages.
   char buf[PCAP_ERRBUF_SIZE];
   // Initialize PCAP if needed.
-  if (!pcap_) {
+  if (!pcap_ && !trace_) {
     // Determine interfaces.
     if (interface_) {
       pcap_ = ::pcap_open_live(interface_->c_str(), snaplen_, 1, 1000, buf);
@@ -232,18 +250,29 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
     } else if (input_ != "-" && !exists(input_)) {
       return make_error(ec::format_error, "no such file: ", input_);
     } else {
+      // Regular trace files get memory-mapped and walked directly, which
+      // avoids copying every packet through libpcap. We fall back to libpcap
+      // for STDIN and for traces that the mapped reader does not support.
+      if (input_ != "-") {
+        if (auto trace = detail::pcap_trace::make(input_))
+          trace_ = std::move(*trace);
+        else
+          VAST_DEBUG(this, "falls back to libpcap:", trace.error());
+      }
+      if (!trace_) {
 #ifdef PCAP_TSTAMP_PRECISION_NANO
-      pcap_ = ::
-        pcap_open_offline_with_tstamp_precision(input_.c_str(),
-                                                PCAP_TSTAMP_PRECISION_NANO,
-                                                buf);
+        pcap_ = ::
+          pcap_open_offline_with_tstamp_precision(input_.c_str(),
+                                                  PCAP_TSTAMP_PRECISION_NANO,
+                                                  buf);
 #else
-      pcap_ = ::pcap_open_offline(input_.c_str(), buf);
+        pcap_ = ::pcap_open_offline(input_.c_str(), buf);
 #endif
-      if (!pcap_) {
-        flows_.clear();
-        return make_error(ec::format_error, "failed to open pcap file ", input_,
-                          ": ", std::string{buf});
+        if (!pcap_) {
+          flows_.clear();
+          return make_error(ec::format_error, "failed to open pcap file ",
+                            input_, ": ", std::string{buf});
+        }
       }
       VAST_INFO(this, "reads trace from", input_);
       if (pseudo_realtime_ > 0)
@@ -263,24 +292,45 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
       return finish(f, ec::timeout);
     }
     // Attempt to fetch next packet.
-    const u_char* data;
-    pcap_pkthdr* header;
-    auto r = ::pcap_next_ex(pcap_, &header, &data);
-    if (r == 0 && produced == 0)
-      continue; // timed out, no events produced yet
-    if (r == 0)
-      return finish(f, caf::none); // timed out
-    if (r == -2)
-      return finish(f, make_error(ec::end_of_input, "reached end of trace"));
-    if (r == -1) {
-      auto err = std::string{::pcap_geterr(pcap_)};
-      ::pcap_close(pcap_);
-      pcap_ = nullptr;
-      return finish(f, make_error(ec::format_error,
-                                  "failed to get next packet: ", err));
+    span<const byte> frame;
+    time ts;
+    if (trace_) {
+      auto packet = trace_->next();
+      if (!packet)
+        return finish(f, std::move(packet.error()));
+      frame = packet->data;
+      ts = packet->timestamp;
+    } else {
+      const u_char* data;
+      pcap_pkthdr* header;
+      auto r = ::pcap_next_ex(pcap_, &header, &data);
+      if (r == 0 && produced == 0)
+        continue; // timed out, no events produced yet
+      if (r == 0)
+        return finish(f, caf::none); // timed out
+      if (r == -2)
+        return finish(f, make_error(ec::end_of_input, "reached end of trace"));
+      if (r == -1) {
+        auto err = std::string{::pcap_geterr(pcap_)};
+        ::pcap_close(pcap_);
+        pcap_ = nullptr;
+        return finish(f, make_error(ec::format_error,
+                                    "failed to get next packet: ", err));
+      }
+      frame = span<const byte>{reinterpret_cast<const byte*>(data),
+                               header->len};
+      // Extract timestamp.
+      using namespace std::chrono;
+      auto secs = seconds(header->ts.tv_sec);
+      ts = time{duration_cast<duration>(secs)};
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+      ts += nanoseconds(header->ts.tv_usec);
+#else
+      ts += microseconds(header->ts.tv_usec);
+#endif
     }
+    auto packet_size = frame.size();
     // Parse frame.
-    span<const byte> frame{reinterpret_cast<const byte*>(data), header->len};
     frame = decapsulate(frame, frame_type::ethernet);
     if (frame.empty())
       return make_error(ec::format_error, "failed to decapsulate frame");
@@ -298,7 +348,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
       }
       case ether_type::ipv4: {
         constexpr size_t ipv4_header_size = 20;
-        if (header->len < ethernet_header_size + ipv4_header_size)
+        if (packet_size < ethernet_header_size + ipv4_header_size)
           return make_error(ec::format_error, "IPv4 header too short");
         size_t header_size = (to_integer<uint8_t>(layer3[0]) & 0x0f) * 4;
         if (header_size < ipv4_header_size)
@@ -315,7 +365,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
         break;
       }
       case ether_type::ipv6: {
-        if (header->len < ethernet_header_size + 40)
+        if (packet_size < ethernet_header_size + 40)
           return make_error(ec::format_error, "IPv6 header too short");
         auto orig_h
           = reinterpret_cast<const uint32_t*>(std::launder(layer3.data() + 8));
@@ -364,34 +414,28 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
       payload_size -= 8; // TODO: account for variable-size data.
     }
     // Parse packet timestamp
-    uint64_t packet_time = header->ts.tv_sec;
+    auto packet_time = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(ts.time_since_epoch())
+        .count());
     if (last_expire_ == 0)
       last_expire_ = packet_time;
-    if (!update_flow(conn, packet_time, payload_size)) {
+    // Looking up the flow evicts the least recently used flow when the table
+    // is full.
+    auto& st = flows_.touch(conn, packet_time);
+    if (!update_flow(st, payload_size)) {
       ++discard_count_;
       VAST_DEBUG(this, "skips cut off packet");
       continue;
     }
     evict_inactive(packet_time);
-    shrink_to_max_size();
-    // Extract timestamp.
-    using namespace std::chrono;
-    auto secs = seconds(header->ts.tv_sec);
-    auto ts = time{duration_cast<duration>(secs)};
-#ifdef PCAP_TSTAMP_PRECISION_NANO
-    ts += nanoseconds(header->ts.tv_usec);
-#else
-    ts += microseconds(header->ts.tv_usec);
-#endif
     // Assemble packet.
     auto layer3_ptr = reinterpret_cast<const char*>(layer3.data());
     auto packet = std::string_view{std::launder(layer3_ptr), layer3.size()};
-    auto& cid = state(conn).community_id;
     if (!(builder_->add(ts) && builder_->add(conn.src_addr)
           && builder_->add(conn.dst_addr)
           && builder_->add(conn.src_port.number())
           && builder_->add(conn.dst_port.number())
-          && (!community_id_ || builder_->add(std::string_view{cid}))
+          && (!community_id_ || builder_->add(st.community_id()))
           && builder_->add(packet))) {
       return make_error(ec::parse_error, "unable to fill row");
     }
@@ -416,19 +460,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
   return finish(f, caf::none);
 }
 
-reader::flow_state& reader::state(const flow& x) {
-  auto i = flows_.find(x);
-  if (i == flows_.end()) {
-    auto id = community_id::compute<policy::base64>(x);
-    i = flows_.emplace(x, flow_state{0, 0, std::move(id)}).first;
-  }
-  return i->second;
-}
-
-bool reader::update_flow(const flow& x, uint64_t packet_time,
-                         uint64_t payload_size) {
-  auto& st = state(x);
-  st.last = packet_time;
+bool reader::update_flow(detail::flow_state& st, uint64_t payload_size) {
   auto& flow_size = st.bytes;
   if (flow_size == cutoff_)
     return false;
@@ -442,32 +474,8 @@ void reader::evict_inactive(uint64_t packet_time) {
   if (packet_time - last_expire_ <= expire_interval_)
     return;
   last_expire_ = packet_time;
-  auto i = flows_.begin();
-  while (i != flows_.end())
-    if (packet_time - i->second.last > max_age_)
-      i = flows_.erase(i);
-    else
-      ++i;
-}
-
-void reader::shrink_to_max_size() {
-  while (flows_.size() >= max_flows_) {
-    auto buckets = flows_.bucket_count();
-    auto unif1 = std::uniform_int_distribution<size_t>{0, buckets - 1};
-    auto bucket = unif1(generator_);
-    auto bucket_size = flows_.bucket_size(bucket);
-    while (bucket_size == 0) {
-      ++bucket;
-      bucket %= buckets;
-      bucket_size = flows_.bucket_size(bucket);
-    }
-    auto unif2 = std::uniform_int_distribution<size_t>{0, bucket_size - 1};
-    auto offset = unif2(generator_);
-    VAST_ASSERT(offset < bucket_size);
-    auto begin = flows_.begin(bucket);
-    std::advance(begin, offset);
-    flows_.erase(begin->first);
-  }
+  if (auto n = flows_.expire(packet_time, max_age_); n > 0)
+    VAST_DEBUG(this, "expired", n, "inactive flows");
 }
 
 writer::writer(const caf::settings& options) {
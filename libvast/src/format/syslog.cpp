@@ -109,7 +109,7 @@ reader::read_impl(size_t max_events, size_t max_slice_size, consumer& f) {
       VAST_DEBUG(this, "stalled at line", lines_->line_number());
       return ec::stalled;
     }
-    auto& line = lines_->get();
+    auto line = lines_->get();
     if (line.empty()) {
       // Ignore empty lines.
       VAST_DEBUG(this, "ignores empty line at", lines_->line_number());
@@ -30,6 +30,10 @@
 #  include "vast/format/arrow.hpp"
 #endif
 
+#if VAST_ENABLE_PARQUET
+#  include "vast/format/parquet.hpp"
+#endif
+
 namespace vast {
 
 template <class Writer>
@@ -62,6 +66,9 @@ void factory_traits<format::writer>::initialize() {
 #if VAST_ENABLE_ARROW
   fac::add("arrow", make_writer<arrow::writer>);
 #endif
+#if VAST_ENABLE_PARQUET
+  fac::add("parquet", make_writer<parquet::writer>);
+#endif
 }
 
 } // namespace vast
@@ -293,7 +293,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
     if (timed_out)
       return ec::stalled;
     // Parse curent line.
-    auto& line = lines_->get();
+    auto line = lines_->get();
     if (line.empty()) {
       // Ignore empty lines.
       VAST_DEBUG(this, "ignores empty line at", lines_->line_number());
@@ -314,7 +314,7 @@ caf::error reader::read_impl(size_t max_events, size_t max_slice_size,
       // Ignore comments.
       VAST_DEBUG(this, "ignores comment at line", lines_->line_number());
     } else {
-      auto fields = detail::split(lines_->get(), separator_);
+      auto fields = detail::split(line, separator_);
       if (fields.size() != parsers_.size()) {
         VAST_WARNING(this, "ignores invalid record at line",
                      lines_->line_number(), ':', "got", fields.size(),
@@ -381,7 +381,8 @@ caf::error reader::parse_header() {
   while (pos != std::string::npos) {
     pos = lines_->get().find("\\x", pos);
     if (pos != std::string::npos) {
-      auto c = std::stoi(lines_->get().substr(pos + 2, 2), nullptr, 16);
+      auto c = std::stoi(std::string{lines_->get().substr(pos + 2, 2)},
+                         nullptr, 16);
       VAST_ASSERT(c >= 0 && c <= 255);
       separator_.push_back(c);
       pos += 2;
@@ -402,7 +403,7 @@ caf::error reader::parse_header() {
     lines_->next();
     if (lines_->done())
       return make_error(ec::format_error, "not enough header lines");
-    auto& line = lines_->get();
+    auto line = lines_->get();
     pos = line.find(prefixes[i]);
     if (pos != 0)
       return make_error(ec::format_error, "invalid header line, expected",
@@ -410,9 +411,10 @@ caf::error reader::parse_header() {
     pos = line.find(separator_);
     if (pos == std::string::npos)
       return make_error(ec::format_error, "invalid separator in header line",
-                        line);
+                        std::string{line});
     if (pos + separator_.size() >= line.size())
-      return make_error(ec::format_error, "missing header content:", line);
+      return make_error(ec::format_error, "missing header content:",
+                        std::string{line});
     header[i] = line.substr(pos + separator_.size());
   }
   // Assign header values.
@@ -13,15 +13,17 @@
 
 #include "vast/index/address_index.hpp"
 
+#include "vast/bitmap_algorithms.hpp"
 #include "vast/detail/overload.hpp"
-#include "vast/index/container_lookup.hpp"
 #include "vast/type.hpp"
 
 #include <caf/deserializer.hpp>
 #include <caf/serializer.hpp>
 #include <caf/settings.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace vast {
 
@@ -101,9 +103,55 @@ address_index::lookup_impl(relational_operator op, data_view d) const {
           result.flip();
         return result;
       },
-      [&](view<list> xs) { return detail::container_lookup(*this, op, xs); },
     },
     d);
 }
 
+caf::expected<ids>
+address_index::lookup_many_impl(view<list> xs) const {
+  std::vector<address> v4;
+  std::vector<address> v6;
+  for (auto x : *xs) {
+    if (caf::holds_alternative<caf::none_t>(x))
+      continue;
+    auto addr = caf::get_if<view<address>>(&x);
+    if (!addr)
+      return make_error(ec::type_clash, materialize(x));
+    (addr->is_v4() ? v4 : v6).push_back(*addr);
+  }
+  std::vector<ids> bitmaps;
+  // Looks up sorted addresses, starting at the given byte. Adjacent addresses
+  // share the lookups of the bytes in their common prefix.
+  auto lookup_sorted = [&](std::vector<address>& addrs, ids base,
+                           size_t first) {
+    std::sort(addrs.begin(), addrs.end());
+    addrs.erase(std::unique(addrs.begin(), addrs.end()), addrs.end());
+    // The i-th entry holds the IDs of all values that match the previous
+    // address in the i bytes from the first byte on.
+    std::vector<ids> prefixes{std::move(base)};
+    const address* previous = nullptr;
+    for (auto& addr : addrs) {
+      auto& bytes = addr.data();
+      auto common = size_t{0};
+      if (previous)
+        while (first + common < 16
+               && previous->data()[first + common] == bytes[first + common])
+          ++common;
+      previous = &addr;
+      prefixes.resize(std::min(common, prefixes.size() - 1) + 1);
+      for (auto i = prefixes.size() - 1;
+           first + i < 16 && !all<0>(prefixes.back()); ++i)
+        prefixes.push_back(prefixes.back()
+                           & bytes_[first + i].lookup(equal, bytes[first + i]));
+      if (prefixes.size() == 16 - first + 1 && !all<0>(prefixes.back()))
+        bitmaps.push_back(prefixes.back());
+    }
+  };
+  lookup_sorted(v4, v4_.coder().storage(), 12);
+  lookup_sorted(v6, ids{offset(), true}, 0);
+  if (bitmaps.empty())
+    return ids{offset(), false};
+  return nary_or(bitmaps.begin(), bitmaps.end());
+}
+
 } // namespace vast
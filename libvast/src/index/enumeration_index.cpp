@@ -14,7 +14,6 @@
 #include "vast/index/enumeration_index.hpp"
 
 #include "vast/detail/overload.hpp"
-#include "vast/index/container_lookup.hpp"
 #include "vast/type.hpp"
 
 #include <caf/deserializer.hpp>
@@ -59,7 +58,6 @@ enumeration_index::lookup_impl(relational_operator op, data_view d) const {
         return make_error(ec::unsupported_operator, op);
       return index_.lookup(op, x);
     },
-    [&](view<list> xs) { return detail::container_lookup(*this, op, xs); },
   };
   return caf::visit(f, d);
 }
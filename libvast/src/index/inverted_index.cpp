@@ -0,0 +1,147 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/index/inverted_index.hpp"
+
+#include "vast/concept/hashable/uhash.hpp"
+#include "vast/detail/assert.hpp"
+#include "vast/detail/type_traits.hpp"
+#include "vast/error.hpp"
+#include "vast/type.hpp"
+
+#include <caf/deserializer.hpp>
+#include <caf/serializer.hpp>
+#include <caf/settings.hpp>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
+
+namespace vast {
+
+namespace {
+
+// Converts a number to another arithmetic type if the conversion is exact.
+template <class Target, class Number>
+std::optional<Target> convert_exactly(Number x) {
+  using limits = std::numeric_limits<Target>;
+  if constexpr (std::is_same_v<Target, Number>) {
+    return x;
+  } else if constexpr (std::is_floating_point_v<Target>) {
+    auto y = static_cast<Target>(x);
+    // The bounds of 64-bit integers round to powers of two, which no integer
+    // in range equals, so we may exclude the upper bound.
+    if (y < static_cast<Target>(std::numeric_limits<Number>::min())
+        || y >= static_cast<Target>(std::numeric_limits<Number>::max())
+        || static_cast<Number>(y) != x)
+      return std::nullopt;
+    return y;
+  } else if constexpr (std::is_floating_point_v<Number>) {
+    if (std::trunc(x) != x || x < static_cast<Number>(limits::min())
+        || x >= static_cast<Number>(limits::max()))
+      return std::nullopt;
+    return static_cast<Target>(x);
+  } else {
+    if constexpr (std::is_signed_v<Number> && std::is_unsigned_v<Target>)
+      if (x < 0)
+        return std::nullopt;
+    if constexpr (std::is_unsigned_v<Number> && std::is_signed_v<Target>)
+      if (x > static_cast<Number>(limits::max()))
+        return std::nullopt;
+    return static_cast<Target>(x);
+  }
+}
+
+// Numbers in queries do not necessarily have the type of the list elements,
+// e.g., `5 in xs` parses 5 as count even if `xs` is a list of integers. Since
+// elements are keyed by the digest of their value, we convert numbers to the
+// element type before hashing them.
+// @returns the value to look for, or nothing if no element can be equal to it.
+std::optional<data> to_element(const type& element, data_view x) {
+  auto f = [&](auto y) -> std::optional<data> {
+    using value_type = std::decay_t<decltype(y)>;
+    if constexpr (detail::is_any_v<value_type, integer, count, real>) {
+      auto g = [&](const auto& t) -> std::optional<data> {
+        using element_type = std::decay_t<decltype(t)>;
+        if constexpr (detail::is_any_v<element_type, integer_type, count_type,
+                                       real_type>) {
+          using target = type_to_data<element_type>;
+          if (auto z = convert_exactly<target>(y))
+            return data{*z};
+        }
+        return std::nullopt;
+      };
+      return caf::visit(g, element);
+    } else {
+      return materialize(x);
+    }
+  };
+  return caf::visit(f, x);
+}
+
+} // namespace
+
+inverted_index::inverted_index(vast::type t, caf::settings opts)
+  : value_index{std::move(t), std::move(opts)} {
+  VAST_ASSERT(caf::holds_alternative<list_type>(value_index::type()));
+}
+
+caf::error inverted_index::serialize(caf::serializer& sink) const {
+  return caf::error::eval([&] { return value_index::serialize(sink); },
+                          [&] { return sink(elements_); });
+}
+
+caf::error inverted_index::deserialize(caf::deserializer& source) {
+  return caf::error::eval([&] { return value_index::deserialize(source); },
+                          [&] { return source(elements_); });
+}
+
+bool inverted_index::append_impl(data_view x, id pos) {
+  auto xs = caf::get_if<view<list>>(&x);
+  if (!xs)
+    return false;
+  // Lists may contain the same element multiple times, but we must set the
+  // bit for a position only once.
+  std::unordered_set<uint64_t> digests;
+  for (auto element : **xs) {
+    if (caf::holds_alternative<caf::none_t>(element))
+      continue;
+    auto digest = uhash<hasher_type>{}(element);
+    if (!digests.insert(digest).second)
+      continue;
+    auto& bm = elements_[digest];
+    bm.append_bits(false, pos - bm.size());
+    bm.append_bit(true);
+  }
+  return true;
+}
+
+caf::expected<ids>
+inverted_index::lookup_impl(relational_operator op, data_view x) const {
+  if (!(op == ni || op == not_ni))
+    return make_error(ec::unsupported_operator, op);
+  auto result = ids{offset(), false};
+  auto& element = caf::get<list_type>(value_index::type()).value_type;
+  if (auto y = to_element(element, x)) {
+    auto digest = uhash<hasher_type>{}(make_view(*y));
+    if (auto it = elements_.find(digest); it != elements_.end())
+      result |= it->second;
+  }
+  if (op == not_ni)
+    result.flip();
+  return result;
+}
+
+} // namespace vast
@@ -16,7 +16,6 @@
 #include "vast/base.hpp"
 #include "vast/defaults.hpp"
 #include "vast/detail/overload.hpp"
-#include "vast/index/container_lookup.hpp"
 #include "vast/type.hpp"
 #include "vast/value_index_factory.hpp"
 
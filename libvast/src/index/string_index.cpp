@@ -16,13 +16,16 @@
 #include "vast/bitmap_algorithms.hpp"
 #include "vast/defaults.hpp"
 #include "vast/detail/overload.hpp"
-#include "vast/index/container_lookup.hpp"
 #include "vast/type.hpp"
 
 #include <caf/deserializer.hpp>
 #include <caf/serializer.hpp>
 #include <caf/settings.hpp>
 
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
 namespace vast {
 
 string_index::string_index(vast::type t, caf::settings opts)
@@ -125,9 +128,48 @@ string_index::lookup_impl(relational_operator op, data_view x) const {
         }
       }
     },
-    [&](view<list> xs) { return detail::container_lookup(*this, op, xs); },
   };
   return caf::visit(f, x);
 }
 
+caf::expected<ids> string_index::lookup_many_impl(view<list> xs) const {
+  std::vector<std::string_view> strs;
+  strs.reserve(xs->size());
+  for (auto x : *xs) {
+    if (caf::holds_alternative<caf::none_t>(x))
+      continue;
+    auto str = caf::get_if<view<std::string>>(&x);
+    if (!str)
+      return make_error(ec::type_clash, materialize(x));
+    strs.push_back(str->substr(0, max_length_));
+  }
+  std::sort(strs.begin(), strs.end());
+  strs.erase(std::unique(strs.begin(), strs.end()), strs.end());
+  ids result{offset(), false};
+  // The i-th entry holds the IDs of all values that begin with the first i
+  // characters of the previous string.
+  std::vector<ids> prefixes{ids{offset(), true}};
+  std::string_view previous;
+  for (auto str : strs) {
+    auto common = static_cast<size_t>(
+      std::mismatch(previous.begin(), previous.end(), str.begin(), str.end())
+        .first
+      - previous.begin());
+    prefixes.resize(std::min(common, prefixes.size() - 1) + 1);
+    previous = str;
+    if (str.size() > chars_.size())
+      continue;
+    for (auto i = prefixes.size() - 1;
+         i < str.size() && !all<0>(prefixes.back()); ++i)
+      prefixes.push_back(
+        prefixes.back()
+        & chars_[i].lookup(equal, static_cast<uint8_t>(str[i])));
+    // Stop if no value begins with this string.
+    if (prefixes.size() <= str.size() || all<0>(prefixes.back()))
+      continue;
+    result |= prefixes.back() & length_.lookup(less_equal, str.size());
+  }
+  return result;
+}
+
 } // namespace vast
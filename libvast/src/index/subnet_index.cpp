@@ -14,7 +14,6 @@
 #include "vast/index/subnet_index.hpp"
 
 #include "vast/detail/overload.hpp"
-#include "vast/index/container_lookup.hpp"
 #include "vast/type.hpp"
 
 #include <caf/deserializer.hpp>
@@ -124,7 +123,6 @@ subnet_index::lookup_impl(relational_operator op, data_view d) const {
           }
         }
       },
-      [&](view<list> xs) { return detail::container_lookup(*this, op, xs); },
     },
     d);
 }
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/index/time_index.hpp"
+
+#include "vast/detail/assert.hpp"
+#include "vast/error.hpp"
+#include "vast/type.hpp"
+
+#include <caf/deserializer.hpp>
+#include <caf/serializer.hpp>
+#include <caf/settings.hpp>
+
+#include <algorithm>
+
+namespace vast {
+
+time_index::time_index(vast::type t, caf::settings opts)
+  : value_index{std::move(t), std::move(opts)} {
+  // nop
+}
+
+caf::error time_index::serialize(caf::serializer& sink) const {
+  return caf::error::eval([&] { return value_index::serialize(sink); },
+                          [&] { return sink(runs_, values_); });
+}
+
+caf::error time_index::deserialize(caf::deserializer& source) {
+  return caf::error::eval([&] { return value_index::deserialize(source); },
+                          [&] { return source(runs_, values_); });
+}
+
+bool time_index::append_impl(data_view x, id pos) {
+  auto t = caf::get_if<view<time>>(&x);
+  if (!t)
+    return false;
+  auto value = t->time_since_epoch().count();
+  // Continue the last run only if both the ID and the value are in order.
+  auto next = runs_.empty() ? id{0}
+                            : runs_.back().first + values_.size()
+                                - runs_.back().position;
+  if (runs_.empty() || pos != next || value < values_.back())
+    runs_.push_back(run{pos, values_.size()});
+  values_.push_back(value);
+  return true;
+}
+
+caf::expected<ids>
+time_index::lookup_impl(relational_operator op, data_view x) const {
+  auto t = caf::get_if<view<time>>(&x);
+  if (!t)
+    return make_error(ec::type_clash, materialize(x));
+  switch (op) {
+    default:
+      return make_error(ec::unsupported_operator, op);
+    case less:
+    case less_equal:
+    case greater:
+    case greater_equal:
+    case equal:
+    case not_equal:
+      break;
+  }
+  auto value = t->time_since_epoch().count();
+  // Computes the values of a run that satisfy the predicate. Since a run is
+  // sorted, they always form a contiguous range.
+  using iterator = std::vector<duration::rep>::const_iterator;
+  auto select = [&](iterator begin, iterator end) {
+    switch (op) {
+      default:
+        VAST_ASSERT(op == equal || op == not_equal);
+        return std::equal_range(begin, end, value);
+      case less:
+        return std::pair{begin, std::lower_bound(begin, end, value)};
+      case less_equal:
+        return std::pair{begin, std::upper_bound(begin, end, value)};
+      case greater:
+        return std::pair{std::upper_bound(begin, end, value), end};
+      case greater_equal:
+        return std::pair{std::lower_bound(begin, end, value), end};
+    }
+  };
+  auto result = ids{};
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    auto begin = values_.begin() + runs_[i].position;
+    auto end = i + 1 < runs_.size() ? values_.begin() + runs_[i + 1].position
+                                    : values_.end();
+    auto [first, last] = select(begin, end);
+    if (first == last)
+      continue;
+    auto first_id = runs_[i].first + (first - begin);
+    VAST_ASSERT(first_id >= result.size());
+    result.append_bits(false, first_id - result.size());
+    result.append_bits(true, last - first);
+  }
+  if (result.size() < offset())
+    result.append_bits(false, offset() - result.size());
+  if (op == not_equal)
+    result.flip();
+  return result;
+}
+
+} // namespace vast
@@ -0,0 +1,270 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/index/trie_index.hpp"
+
+#include "vast/bitmap_algorithms.hpp"
+#include "vast/detail/assert.hpp"
+#include "vast/detail/overload.hpp"
+#include "vast/error.hpp"
+#include "vast/type.hpp"
+
+#include <caf/deserializer.hpp>
+#include <caf/serializer.hpp>
+#include <caf/settings.hpp>
+
+#include <algorithm>
+
+namespace vast {
+
+namespace {
+
+// Returns the i-th bit of an address, counting from the most significant bit.
+unsigned bit(const address& x, unsigned i) {
+  VAST_ASSERT(i < 128);
+  return (x.data()[i / 8] >> (7 - i % 8)) & 1u;
+}
+
+// Returns the number of leading bits two addresses have in common, but at most
+// the given limit.
+uint8_t common_bits(const address& x, const address& y, uint8_t limit) {
+  auto result = 0u;
+  for (auto i = 0u; i < 16 && result < limit; ++i) {
+    auto diff = static_cast<uint8_t>(x.data()[i] ^ y.data()[i]);
+    if (diff == 0) {
+      result += 8;
+      continue;
+    }
+    for (auto mask = 0x80u; (diff & mask) == 0; mask >>= 1)
+      ++result;
+    break;
+  }
+  return static_cast<uint8_t>(std::min(result, unsigned{limit}));
+}
+
+} // namespace
+
+trie_index::trie_index(vast::type t, caf::settings opts)
+  : value_index{std::move(t), std::move(opts)}, nodes_(1) {
+  // nop
+}
+
+caf::error trie_index::serialize(caf::serializer& sink) const {
+  return caf::error::eval([&] { return value_index::serialize(sink); },
+                          [&] { return sink(nodes_); });
+}
+
+caf::error trie_index::deserialize(caf::deserializer& source) {
+  return caf::error::eval([&] { return value_index::deserialize(source); },
+                          [&] { return source(nodes_); });
+}
+
+trie_index::prefix trie_index::make_prefix(const subnet& x) {
+  auto length = x.length() + (x.network().is_v4() ? 96 : 0);
+  return {x.network(), static_cast<uint8_t>(length)};
+}
+
+bool trie_index::append_impl(data_view x, id pos) {
+  auto to_prefix = detail::overload{
+    [](auto) { return caf::optional<prefix>{}; },
+    [](view<address> x) { return caf::optional<prefix>{prefix{x, 128}}; },
+    [](view<subnet> x) { return caf::optional<prefix>{make_prefix(x)}; },
+  };
+  auto p = caf::visit(to_prefix, x);
+  if (!p)
+    return false;
+  auto& rows = nodes_[insert(*p)].rows;
+  rows.append_bits(false, pos - rows.size());
+  rows.append_bit(true);
+  return true;
+}
+
+caf::expected<ids>
+trie_index::lookup_impl(relational_operator op, data_view d) const {
+  std::vector<ids> bitmaps;
+  auto collect_one = [&](const prefix& x) -> caf::error {
+    switch (op) {
+      default:
+        return make_error(ec::unsupported_operator, op);
+      case equal:
+      case not_equal:
+        collect(0, &x, &x + 1, false, bitmaps);
+        return caf::none;
+      case in:
+      case not_in:
+        collect(0, &x, &x + 1, true, bitmaps);
+        return caf::none;
+      case ni:
+      case not_ni:
+        collect_supersets(x, bitmaps);
+        return caf::none;
+    }
+  };
+  auto err = caf::visit(
+    detail::overload{
+      [&](auto x) -> caf::error {
+        return make_error(ec::type_clash, materialize(x));
+      },
+      [&](view<address> x) -> caf::error {
+        if (op == in || op == not_in)
+          return make_error(ec::unsupported_operator, op);
+        return collect_one(prefix{x, 128});
+      },
+      [&](view<subnet> x) -> caf::error {
+        return collect_one(make_prefix(x));
+      },
+    },
+    d);
+  if (err)
+    return err;
+  auto result = unite(bitmaps);
+  if (is_negated(op))
+    result.flip();
+  return result;
+}
+
+caf::expected<ids> trie_index::lookup_many_impl(view<list> xs) const {
+  std::vector<prefix> prefixes;
+  for (auto x : *xs) {
+    if (auto addr = caf::get_if<view<address>>(&x)) {
+      prefixes.push_back(prefix{*addr, 128});
+    } else if (auto sn = caf::get_if<view<subnet>>(&x)) {
+      prefixes.push_back(make_prefix(*sn));
+    } else if (!caf::holds_alternative<caf::none_t>(x)) {
+      return make_error(ec::type_clash, materialize(x));
+    }
+  }
+  std::sort(prefixes.begin(), prefixes.end());
+  prefixes.erase(std::unique(prefixes.begin(), prefixes.end()),
+                 prefixes.end());
+  std::vector<ids> bitmaps;
+  collect(0, prefixes.data(), prefixes.data() + prefixes.size(), false,
+          bitmaps);
+  return unite(bitmaps);
+}
+
+uint32_t trie_index::insert(const prefix& x) {
+  auto make_node = [&](address key, uint8_t length) {
+    key.mask(length);
+    auto& n = nodes_.emplace_back();
+    n.key = key;
+    n.length = length;
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  };
+  // The prefix of the current node is always a prefix of x.
+  auto current = uint32_t{0};
+  while (nodes_[current].length < x.length) {
+    auto b = bit(x.key, nodes_[current].length);
+    auto child = nodes_[current].children[b];
+    if (child == 0) {
+      auto leaf = make_node(x.key, x.length);
+      nodes_[current].children[b] = leaf;
+      return leaf;
+    }
+    auto child_length = nodes_[child].length;
+    auto common = common_bits(x.key, nodes_[child].key,
+                              std::min(x.length, child_length));
+    if (common == child_length) {
+      current = child;
+      continue;
+    }
+    // The child diverges from x or x is a prefix of the child, so we need to
+    // put a node for the common prefix in between.
+    auto split = make_node(x.key, common);
+    nodes_[split].children[bit(nodes_[child].key, common)] = child;
+    nodes_[current].children[b] = split;
+    if (common == x.length)
+      return split;
+    auto leaf = make_node(x.key, x.length);
+    nodes_[split].children[bit(x.key, common)] = leaf;
+    return leaf;
+  }
+  VAST_ASSERT(nodes_[current].length == x.length);
+  return current;
+}
+
+void trie_index::collect(uint32_t position, const prefix* first,
+                         const prefix* last, bool within,
+                         std::vector<ids>& result) const {
+  auto& n = nodes_[position];
+  std::vector<prefix> deeper;
+  for (auto x = first; x != last; ++x) {
+    auto k = std::min(x->length, n.length);
+    if (k > 0 && !n.key.compare(x->key, k))
+      continue;
+    if (x->length > n.length) {
+      deeper.push_back(*x);
+    } else if (within) {
+      // The node lies within the prefix, and so does its entire subtree.
+      collect_subtree(position, result);
+      return;
+    } else if (x->length == n.length && !n.rows.empty()) {
+      result.push_back(n.rows);
+    }
+  }
+  // All remaining prefixes agree with the node up to its length, so sorting
+  // puts the ones that continue with a 0 bit before the ones with a 1 bit.
+  auto middle = std::partition_point(
+    deeper.begin(), deeper.end(),
+    [&](const prefix& x) { return bit(x.key, n.length) == 0; });
+  auto split = deeper.data() + (middle - deeper.begin());
+  if (n.children[0] != 0 && deeper.data() != split)
+    collect(n.children[0], deeper.data(), split, within, result);
+  if (n.children[1] != 0 && split != deeper.data() + deeper.size())
+    collect(n.children[1], split, deeper.data() + deeper.size(), within,
+            result);
+}
+
+void trie_index::collect_subtree(uint32_t position,
+                                 std::vector<ids>& result) const {
+  std::vector<uint32_t> stack{position};
+  while (!stack.empty()) {
+    auto& n = nodes_[stack.back()];
+    stack.pop_back();
+    if (!n.rows.empty())
+      result.push_back(n.rows);
+    for (auto child : n.children)
+      if (child != 0)
+        stack.push_back(child);
+  }
+}
+
+void trie_index::collect_supersets(const prefix& x,
+                                   std::vector<ids>& result) const {
+  auto current = uint32_t{0};
+  while (true) {
+    auto& n = nodes_[current];
+    if (n.length > x.length)
+      return;
+    if (n.length > 0 && !n.key.compare(x.key, n.length))
+      return;
+    if (!n.rows.empty())
+      result.push_back(n.rows);
+    if (n.length == x.length)
+      return;
+    current = n.children[bit(x.key, n.length)];
+    if (current == 0)
+      return;
+  }
+}
+
+ids trie_index::unite(const std::vector<ids>& xs) const {
+  if (xs.empty())
+    return ids{offset(), false};
+  auto result = nary_or(xs.begin(), xs.end());
+  if (result.size() < offset())
+    result.append_bits(false, offset() - result.size());
+  return result;
+}
+
+} // namespace vast
@@ -13,26 +13,56 @@
 
 #include "vast/io/save.hpp"
 
+#include "vast/chunk.hpp"
 #include "vast/error.hpp"
+#include "vast/file.hpp"
 #include "vast/io/write.hpp"
 #include "vast/path.hpp"
 
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
 
 namespace vast::io {
 
+namespace {
+
+caf::error rename_into_place(const path& tmp, const path& filename) {
+  if (std::rename(tmp.str().c_str(), filename.str().c_str()) != 0) {
+    rm(tmp);
+    return make_error(ec::filesystem_error,
+                      "failed in rename(2):", std::strerror(errno));
+  }
+  return caf::none;
+}
+
+} // namespace
+
 caf::error save(const path& filename, span<const byte> xs) {
   auto tmp = filename + ".tmp";
   if (auto err = write(tmp, xs)) {
     rm(tmp);
     return err;
   }
-  if (std::rename(tmp.str().c_str(), filename.str().c_str()) != 0) {
+  return rename_into_place(tmp, filename);
+}
+
+caf::error save(const path& filename, span<const chunk_ptr> xs) {
+  auto tmp = filename + ".tmp";
+  auto err = [&]() -> caf::error {
+    file f{tmp};
+    if (!f.open(file::write_only))
+      return make_error(ec::filesystem_error, "failed open file");
+    for (auto& x : xs)
+      if (auto err = f.write(x->data(), x->size()))
+        return err;
+    return caf::none;
+  }();
+  if (err) {
     rm(tmp);
-    return make_error(ec::filesystem_error,
-                      "failed in rename(2):", std::strerror(errno));
+    return err;
   }
-  return caf::none;
+  return rename_into_place(tmp, filename);
 }
 
 } // namespace vast::io
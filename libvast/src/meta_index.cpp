@@ -32,6 +32,7 @@
 #include <caf/binary_deserializer.hpp>
 #include <caf/binary_serializer.hpp>
 
+#include <algorithm>
 #include <type_traits>
 
 namespace vast {
@@ -63,6 +64,7 @@ void partition_synopsis::add(const table_slice& slice,
                                  : factory<synopsis>::make(t, synopsis_options);
   };
   auto& layout = slice.layout();
+  layout_events_[layout.name()] += slice.rows();
   auto each = record_type::each(layout);
   auto field_it = each.begin();
   for (size_t col = 0; col < slice.columns(); ++col, ++field_it) {
@@ -163,11 +165,25 @@ std::vector<uuid> meta_index::lookup(const expression& expr) const {
   auto f = detail::overload{
     [&](const conjunction& x) -> result_type {
       VAST_ASSERT(!x.empty());
-      auto i = x.begin();
-      auto result = lookup(*i);
+      // Restrictions of the type only look at layout names, so we check them
+      // first to rule out partitions before probing any synopses.
+      auto is_type_query = [](const expression* op) {
+        auto p = caf::get_if<predicate>(op);
+        if (!p)
+          return false;
+        auto lhs = caf::get_if<attribute_extractor>(&p->lhs);
+        return lhs != nullptr && lhs->attr == atom::type_v;
+      };
+      auto operands = std::vector<const expression*>{};
+      operands.reserve(x.size());
+      for (auto& op : x)
+        operands.push_back(&op);
+      std::stable_partition(operands.begin(), operands.end(), is_type_query);
+      auto i = operands.begin();
+      auto result = lookup(**i);
       if (!result.empty())
-        for (++i; i != x.end(); ++i) {
-          auto xs = lookup(*i);
+        for (++i; i != operands.end(); ++i) {
+          auto xs = lookup(**i);
           if (xs.empty())
             return xs; // short-circuit
           detail::inplace_intersect(result, xs);
@@ -255,12 +271,12 @@ std::vector<uuid> meta_index::lookup(const expression& expr) const {
             // at the layout names.
             result_type result;
             for (auto& [part_id, part_syn] : synopses_) {
-              for (auto& pair : part_syn.field_synopses_) {
+              for (auto& pair : part_syn.layout_events_) {
                 // TODO: provide an overload for view of evaluate() so that
                 // we can use string_view here. Fortunately type names are
                 // short, so we're probably not hitting the allocator due to
                 // SSO.
-                auto type_name = data{pair.first.layout_name};
+                auto type_name = data{pair.first};
                 if (evaluate(type_name, x.op, d)) {
                   result.push_back(part_id);
                   break;
@@ -336,6 +352,157 @@ std::vector<uuid> meta_index::lookup(const expression& expr) const {
   return result;
 }
 
+namespace {
+
+/// Describes which events of a layout in a partition satisfy an expression.
+enum class coverage { none, some, all };
+
+/// Determines the coverage of an expression for the events of a layout in a
+/// partition from its synopses.
+struct coverage_evaluator {
+  coverage operator()(caf::none_t) const {
+    return coverage::some;
+  }
+
+  coverage operator()(const conjunction& xs) const {
+    auto result = coverage::all;
+    for (auto& x : xs) {
+      result = std::min(result, caf::visit(*this, x));
+      if (result == coverage::none)
+        break;
+    }
+    return result;
+  }
+
+  coverage operator()(const disjunction& xs) const {
+    auto result = coverage::none;
+    for (auto& x : xs) {
+      result = std::max(result, caf::visit(*this, x));
+      if (result == coverage::all)
+        break;
+    }
+    return result;
+  }
+
+  coverage operator()(const negation& x) const {
+    switch (caf::visit(*this, x.expr())) {
+      case coverage::none:
+        return coverage::all;
+      case coverage::all:
+        return coverage::none;
+      default:
+        return coverage::some;
+    }
+  }
+
+  coverage operator()(const predicate& x) const {
+    auto search = [&](auto match) {
+      auto& rhs = caf::get<data>(x.rhs);
+      auto result = coverage::none;
+      for (auto& [field, syn] : synopsis.field_synopses_) {
+        if (field.layout_name != layout || !match(field))
+          continue;
+        auto s = syn.get();
+        if (!s) {
+          auto cleaned_type = vast::type{field.type}.attributes({});
+          if (auto it = synopsis.type_synopses_.find(cleaned_type);
+              it != synopsis.type_synopses_.end())
+            s = it->second.get();
+        }
+        if (!s)
+          return coverage::some;
+        if (auto opt = s->lookup(x.op, make_view(rhs)); opt && !*opt)
+          continue;
+        // Only range comparisons against min-max synopses can prove that all
+        // values satisfy a predicate: the inverse lookup rules out the rest.
+        auto all = false;
+        switch (x.op) {
+          default:
+            break;
+          case less:
+          case less_equal:
+          case greater:
+          case greater_equal: {
+            auto opt = s->lookup(negate(x.op), make_view(rhs));
+            all = opt && !*opt;
+            break;
+          }
+        }
+        if (all)
+          return coverage::all;
+        result = coverage::some;
+      }
+      return result;
+    };
+    auto f = detail::overload{
+      [&](const attribute_extractor& lhs, const data& d) {
+        if (lhs.attr == atom::type_v)
+          return evaluate(data{layout}, x.op, d) ? coverage::all
+                                                 : coverage::none;
+        if (lhs.attr == atom::timestamp_v)
+          return search([](auto& field) {
+            return has_attribute(field.type, "timestamp");
+          });
+        if (lhs.attr == atom::field_v) {
+          auto s = caf::get_if<std::string>(&d);
+          if (!s)
+            return coverage::some;
+          auto matching = false;
+          for (auto& [field, _] : synopsis.field_synopses_)
+            if (field.layout_name == layout
+                && detail::ends_with(field.fqn(), *s)) {
+              matching = true;
+              break;
+            }
+          return !is_negated(x.op) == matching ? coverage::all
+                                                : coverage::none;
+        }
+        return coverage::some;
+      },
+      [&](const field_extractor& lhs, const data&) {
+        return search([&](auto& field) {
+          return detail::ends_with(field.fqn(), lhs.field);
+        });
+      },
+      [&](const type_extractor& lhs, const data&) {
+        return search([&](auto& field) { return field.type == lhs.type; });
+      },
+      [&](const auto&, const auto&) { return coverage::some; },
+    };
+    return caf::visit(f, x.lhs, x.rhs);
+  }
+
+  const partition_synopsis& synopsis;
+  const std::string& layout;
+};
+
+} // namespace
+
+std::pair<uint64_t, uint64_t>
+meta_index::estimate(const expression& expr) const {
+  VAST_ASSERT(!caf::holds_alternative<caf::none_t>(expr));
+  auto lower = uint64_t{0};
+  auto upper = uint64_t{0};
+  for (auto& [part_id, part_syn] : synopses_) {
+    for (auto& [layout, events] : part_syn.layout_events_) {
+      switch (caf::visit(coverage_evaluator{part_syn, layout}, expr)) {
+        case coverage::none:
+          break;
+        case coverage::some:
+          upper += events;
+          break;
+        case coverage::all:
+          lower += events;
+          upper += events;
+          break;
+      }
+    }
+  }
+  VAST_DEBUG(this, "estimates between", lower, "and", upper,
+             "events for", expr);
+  return {lower, upper};
+}
+
 caf::settings& meta_index::factory_options() {
   return synopsis_options_;
 }
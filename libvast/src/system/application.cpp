@@ -29,6 +29,7 @@
 #include "vast/format/syslog.hpp"
 #include "vast/format/test.hpp"
 #include "vast/format/zeek.hpp"
+#include "vast/system/bench_command.hpp"
 #include "vast/system/configuration.hpp"
 #include "vast/system/count_command.hpp"
 #include "vast/system/explore_command.hpp"
@@ -46,6 +47,10 @@
 #  include "vast/format/arrow.hpp"
 #endif
 
+#if VAST_ENABLE_PARQUET
+#  include "vast/format/parquet.hpp"
+#endif
+
 #if VAST_ENABLE_PCAP
 #  include "vast/format/pcap.hpp"
 #  include "vast/system/pcap_writer_command.hpp"
@@ -68,7 +73,14 @@ command::opts_builder add_index_opts(command::opts_builder ob) {
                                             "partitions")
     .add<size_t>("max-taste-partitions", "maximum number of immediately "
                                          "scheduled partitions")
-    .add<size_t>("max-queries,q", "maximum number of concurrent queries");
+    .add<size_t>("max-queries,q", "maximum number of concurrent queries")
+    .add<size_t>("max-predicate-cache-size", "maximum size of the predicate "
+                                             "cache in MiB")
+    .add<bool>("partition-per-layout", "build separate partitions for every "
+                                       "layout")
+    .add<std::string>("active-partition-timeout", "time without new events "
+                                                  "after which an active "
+                                                  "partition gets persisted");
 }
 
 command::opts_builder add_archive_opts(command::opts_builder ob) {
@@ -120,6 +132,19 @@ auto make_root_command(std::string_view path) {
                                    std::move(ob));
 }
 
+auto make_bench_command() {
+  return std::make_unique<command>(
+    "bench", "benchmark ingestion and queries with a synthetic workload",
+    documentation::vast_bench,
+    opts("?vast.bench")
+      .add<size_t>("events,n", "number of synthetic events to ingest")
+      .add<size_t>("seed,s", "seed of the synthetic workload")
+      .add<size_t>("runs,r", "number of runs per query")
+      .add<std::string>("queries,q", "file with one query per line")
+      .add<std::string>("schema-file", "path to an alternate schema for the "
+                                       "synthetic events"));
+}
+
 auto make_count_command() {
   return std::make_unique<command>(
     "count", "count hits for a query without exporting data",
@@ -127,7 +152,18 @@ auto make_count_command() {
     opts("?vast.count")
       .add<bool>("disable-taxonomies", "don't substitute taxonomy identifiers")
       .add<bool>("estimate,e", "estimate an upper bound by "
-                               "skipping candidate checks"));
+                               "skipping candidate checks")
+      .add<bool>("approximate", "bound the count from the meta index "
+                                "without querying partitions")
+      .add<std::vector<std::string>>("by", "count per distinct value of the "
+                                           "given fields")
+      .add<std::vector<std::string>>("sum", "sum up fields per group")
+      .add<std::vector<std::string>>("min", "minimum of fields per group")
+      .add<std::vector<std::string>>("max", "maximum of fields per group")
+      .add<std::vector<std::string>>("distinct", "estimate the number of "
+                                                 "distinct values per group")
+      .add<uint64_t>("max-groups", "maximum number of groups to keep track "
+                                   "of"));
 }
 
 auto make_dump_command() {
@@ -168,6 +204,8 @@ auto make_export_command() {
       .add<bool>("unified,u", "marks a query as unified")
       .add<bool>("disable-taxonomies", "don't substitute taxonomy identifiers")
       .add<size_t>("max-events,n", "maximum number of results")
+      .add<std::vector<std::string>>("fields", "fields to include in the "
+                                               "results")
       .add<std::string>("read,r", "path for reading the query"));
   export_->add_subcommand("zeek", "exports query results in Zeek format",
                           documentation::vast_export_zeek,
@@ -190,11 +228,27 @@ auto make_export_command() {
 #if VAST_ENABLE_ARROW
   // The Arrow export does not support --write or --uds, so we don't use the
   // sink_opts here intentionally.
-  export_->add_subcommand("arrow", "exports query results in Arrow format",
-                          documentation::vast_export_arrow,
-                          opts("?vast.export.arrow"));
+  export_->add_subcommand(
+    "arrow", "exports query results in Arrow format",
+    documentation::vast_export_arrow,
+    opts("?vast.export.arrow")
+      .add<std::string>("shared-memory", "UNIX domain socket to pass record "
+                                         "batches in shared memory over"));
 
 #endif
+#if VAST_ENABLE_PARQUET
+  // Parquet files require a schema per file, so the writer creates one file
+  // per layout in the directory given by --write.
+  export_->add_subcommand(
+    "parquet", "exports query results in Parquet format",
+    documentation::vast_export_parquet,
+    opts("?vast.export.parquet")
+      .add<std::string>("write,w", "directory to write Parquet files to")
+      .add<std::string>("compression", "compression codec (uncompressed, "
+                                       "snappy, gzip, brotli, lz4, or zstd)")
+      .add<bool>("dictionary", "dictionary-encode columns")
+      .add<size_t>("row-group-size", "maximum number of rows per row group"));
+#endif
 #if VAST_ENABLE_PCAP
   export_->add_subcommand("pcap", "exports query results in PCAP format",
                           documentation::vast_export_pcap,
@@ -229,7 +283,14 @@ auto make_import_command() {
                                          "table slices are forwarded")
       .add<std::string>("read-timeout", "timeout for waiting for incoming data")
       .add<bool>("blocking,b", "block until the IMPORTER forwarded all data")
-      .add<size_t>("max-events,n", "the maximum number of events to import"));
+      .add<size_t>("max-events,n", "the maximum number of events to import")
+      .add<size_t>("udp-batch-size", "maximum number of datagrams per receive "
+                                     "call (0 disables the receive thread)")
+      .add<size_t>("udp-max-datagram-size", "datagram size above which UDP "
+                                            "input gets truncated")
+      .add<size_t>("udp-buffers", "number of datagram batches to buffer")
+      .add<size_t>("udp-socket-buffer-size", "requested socket receive "
+                                             "buffer size in bytes"));
   import_->add_subcommand("zeek", "imports Zeek TSV logs from STDIN or file",
                           documentation::vast_import_zeek,
                           source_opts("?vast.import.zeek"));
@@ -253,6 +314,11 @@ auto make_import_command() {
     "test", "imports random data for testing or benchmarking",
     documentation::vast_import_test,
     source_opts("?vast.import.test").add<size_t>("seed", "the PRNG seed"));
+#if VAST_ENABLE_PARQUET
+  import_->add_subcommand("parquet", "imports Parquet files written by VAST",
+                          documentation::vast_import_parquet,
+                          source_opts("?vast.import.parquet"));
+#endif
 #if VAST_ENABLE_PCAP
   import_->add_subcommand(
     "pcap", "imports PCAP logs from STDIN or file",
@@ -449,6 +515,7 @@ auto make_command_factory() {
   // well iff necessary
   // clang-format off
   return command::factory{
+    {"bench", bench_command},
     {"count", count_command},
     {"dump", remote_command},
     {"dump concepts", remote_command},
@@ -461,6 +528,9 @@ auto make_command_factory() {
 #if VAST_ENABLE_ARROW
     {"export arrow", make_writer_command("arrow")},
 #endif
+#if VAST_ENABLE_PARQUET
+    {"export parquet", make_writer_command("parquet")},
+#endif
 #if VAST_ENABLE_PCAP
     {"export pcap", pcap_writer_command},
 #endif
@@ -472,6 +542,10 @@ auto make_command_factory() {
       format::json::reader<format::json::default_selector>,
       format::simdjson::reader<format::json::default_selector>,
       defaults::import::json>},
+#if VAST_ENABLE_PARQUET
+    {"import parquet", import_command<format::parquet::reader,
+      defaults::import::parquet>},
+#endif
 #if VAST_ENABLE_PCAP
     {"import pcap", import_command<format::pcap::reader,
       defaults::import::pcap>},
@@ -528,6 +602,7 @@ auto make_command_factory() {
 std::pair<std::unique_ptr<command>, command::factory>
 make_application(std::string_view path) {
   auto root = make_root_command(path);
+  root->add_subcommand(make_bench_command());
   root->add_subcommand(make_count_command());
   root->add_subcommand(make_dump_command());
   root->add_subcommand(make_export_command());
@@ -19,6 +19,7 @@
 #include "vast/defaults.hpp"
 #include "vast/detail/assert.hpp"
 #include "vast/detail/fill_status_map.hpp"
+#include "vast/expression.hpp"
 #include "vast/logger.hpp"
 #include "vast/segment_store.hpp"
 #include "vast/store.hpp"
@@ -31,6 +32,8 @@
 #include <caf/stream_sink.hpp>
 
 #include <algorithm>
+#include <tuple>
+#include <utility>
 
 using namespace caf;
 
@@ -68,6 +71,52 @@ void archive_state::next_session() {
   it->second.pop();
 }
 
+table_slice archive_state::project(const caf::actor_addr& requester,
+                                   table_slice slice) {
+  auto it = projections.find(requester);
+  if (it == projections.end())
+    return slice;
+  auto& [fields, expr, cache] = it->second;
+  auto layout = type{slice.layout()};
+  auto columns = cache.find(layout);
+  if (columns == cache.end()) {
+    auto xs = resolve_columns(slice.layout(), fields);
+    // Keep the columns that the exporter needs for its candidate check. A
+    // layout without any of the requested fields does not qualify at all.
+    if (!xs.empty()) {
+      for (auto& resolved : resolve(expr, layout))
+        if (auto ex = caf::get_if<data_extractor>(&resolved.second.lhs))
+          if (auto column = slice.layout().flat_index_at(ex->offset))
+            xs.push_back(*column);
+      std::sort(xs.begin(), xs.end());
+      xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    }
+    VAST_DEBUG(self, "projects", slice.layout().name(), "onto", xs.size(),
+               "columns for", requester);
+    columns = cache.emplace(std::move(layout), std::move(xs)).first;
+  }
+  if (columns->second.empty())
+    return {};
+  return vast::project(slice, columns->second);
+}
+
+void archive_state::aggregate(aggregator& x, const table_slice& slice,
+                              const ids& selection) {
+  auto layout = type{slice.layout()};
+  auto it = x.checkers.find(layout);
+  if (it == x.checkers.end()) {
+    auto checker = tailor(x.expr, layout);
+    if (!checker)
+      VAST_DEBUG(self, "failed to tailor expression:", render(checker.error()));
+    std::tie(it, std::ignore) = x.checkers.emplace(
+      std::move(layout), checker ? std::move(*checker) : expression{});
+  }
+  // An empty checker means that no event of this layout matches.
+  if (caf::holds_alternative<caf::none_t>(it->second))
+    return;
+  x.partial.add(slice, evaluate(it->second, slice) & selection);
+}
+
 void archive_state::send_report() {
   if (measurement.events > 0) {
     auto r = performance_report{{{std::string{name}, measurement}}};
@@ -111,6 +160,8 @@ archive(archive_actor::stateful_pointer<archive_state> self, path dir,
   self->set_down_handler([=](const down_msg& msg) {
     VAST_DEBUG(self, "received DOWN from", msg.source);
     self->state.active_exporters.erase(msg.source);
+    self->state.projections.erase(msg.source);
+    self->state.aggregators.erase(msg.source);
   });
   return {
     [=](const ids& xs) {
@@ -155,13 +206,32 @@ archive(archive_actor::stateful_pointer<archive_state> self, path dir,
         auto err
           = slice.error() ? std::move(slice.error()) : make_error(ec::no_error);
         VAST_DEBUG(self, "finished extraction from the current session:", err);
+        // Aggregating clients receive one partial aggregation per session.
+        if (auto it = st.aggregators.find(requester->address());
+            it != st.aggregators.end() && !it->second.partial.empty()) {
+          auto spec = it->second.partial.spec();
+          self->send(caf::actor_cast<caf::actor>(requester),
+                     std::exchange(it->second.partial,
+                                   aggregation{std::move(spec)}));
+        }
         self->send(requester, atom::done_v, std::move(err));
         st.next_session();
         return;
       }
+      // Aggregate instead of sending the slice for aggregating clients.
+      if (auto it = st.aggregators.find(requester->address());
+          it != st.aggregators.end()) {
+        st.aggregate(it->second, *slice, xs);
+        self->send(self, xs, requester, session_id);
+        return;
+      }
+      // Trim the slice to the requested columns first, so that selecting the
+      // rows only copies what the requester needs.
+      auto projected = st.project(requester->address(), std::move(*slice));
       // The slice may contain entries that are not selected by xs.
-      for (auto& sub_slice : select(*slice, xs))
-        self->send(requester, sub_slice);
+      if (projected.encoding() != table_slice_encoding::none)
+        for (auto& sub_slice : select(projected, xs))
+          self->send(requester, sub_slice);
       // Continue working on the current session.
       self->send(self, xs, requester, session_id);
     },
@@ -214,6 +284,22 @@ archive(archive_actor::stateful_pointer<archive_state> self, path dir,
       self->state.active_exporters.insert(sender_addr);
       self->monitor<caf::message_priority::high>(exporter);
     },
+    [=](atom::exporter, const actor& exporter,
+        std::vector<std::string>& fields, expression& expr) {
+      auto sender_addr = self->current_sender()->address();
+      self->state.active_exporters.insert(sender_addr);
+      self->state.projections[sender_addr]
+        = {std::move(fields), std::move(expr), {}};
+      self->monitor<caf::message_priority::high>(exporter);
+    },
+    [=](atom::exporter, const actor& client, expression& expr,
+        aggregation_spec& spec) {
+      auto sender_addr = self->current_sender()->address();
+      self->state.active_exporters.insert(sender_addr);
+      self->state.aggregators[sender_addr]
+        = {std::move(expr), {}, aggregation{std::move(spec)}};
+      self->monitor<caf::message_priority::high>(client);
+    },
     [=](atom::status, status_verbosity v) {
       auto result = caf::settings{};
       auto& archive_status = put_dictionary(result, "archive");
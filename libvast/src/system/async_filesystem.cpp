@@ -0,0 +1,377 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/system/async_filesystem.hpp"
+
+#include "vast/chunk.hpp"
+#include "vast/config.hpp"
+#include "vast/detail/assert.hpp"
+#include "vast/error.hpp"
+#include "vast/file.hpp"
+#include "vast/io/read.hpp"
+#include "vast/io/save.hpp"
+#include "vast/logger.hpp"
+
+#include <caf/config_value.hpp>
+#include <caf/dictionary.hpp>
+#include <caf/event_based_actor.hpp>
+#include <caf/result.hpp>
+#include <caf/settings.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace vast::system {
+
+namespace {
+
+using sync_policy = async_filesystem_config::sync_policy;
+
+using stopwatch = std::chrono::steady_clock;
+
+// Flushes the file after writing it according to the sync policy.
+caf::error flush(const file& f, const async_filesystem_config& config) {
+  auto result = 0;
+  if (config.sync == sync_policy::data) {
+#if VAST_LINUX
+    result = ::fdatasync(f.handle());
+#else
+    result = ::fsync(f.handle());
+#endif
+  } else if (config.sync == sync_policy::full) {
+    result = ::fsync(f.handle());
+  }
+  if (result != 0)
+    return make_error(ec::filesystem_error, "failed to flush", f.path().str(),
+                      std::strerror(errno));
+#if VAST_LINUX
+  // The kernel can only evict clean pages, so this works best together with
+  // a sync policy.
+  if (config.drop_cache)
+    ::posix_fadvise(f.handle(), 0, 0, POSIX_FADV_DONTNEED);
+#endif
+  return caf::none;
+}
+
+// Atomically replaces a file with the concatenation of chunks via a
+// temporary file, like `io::save`.
+caf::expected<atom::ok>
+write_file(const path& filename, span<const chunk_ptr> chunks,
+           const async_filesystem_config& config) {
+  if (config.sync == sync_policy::none && !config.drop_cache) {
+    if (auto err = io::save(filename, chunks))
+      return err;
+    return atom::ok_v;
+  }
+  auto tmp = filename + ".tmp";
+  auto fail = [&](caf::error err) {
+    rm(tmp);
+    return err;
+  };
+  {
+    file f{tmp};
+    if (auto opened = f.open(file::write_only); !opened)
+      return fail(std::move(opened.error()));
+    for (auto& chk : chunks)
+      if (auto err = f.write(chk->data(), chk->size()))
+        return fail(std::move(err));
+    if (auto err = flush(f, config))
+      return fail(std::move(err));
+  }
+  if (std::rename(tmp.str().c_str(), filename.str().c_str()) != 0)
+    return fail(make_error(ec::filesystem_error,
+                           "failed in rename(2):", std::strerror(errno)));
+  // Persist the directory entry of the renamed file as well.
+  if (config.sync == sync_policy::full) {
+    auto dir = ::open(filename.parent().str().c_str(), O_RDONLY);
+    if (dir >= 0) {
+      ::fsync(dir);
+      ::close(dir);
+    }
+  }
+  return atom::ok_v;
+}
+
+caf::expected<chunk_ptr> read_file(const path& filename) {
+  auto bytes = io::read(filename);
+  if (!bytes)
+    return std::move(bytes.error());
+  return chunk::make(std::move(*bytes));
+}
+
+template <class T>
+caf::result<T> to_result(caf::expected<T>&& x) {
+  if (!x)
+    return std::move(x.error());
+  return std::move(*x);
+}
+
+// An I/O thread that performs the blocking system calls. Operates on
+// absolute paths only.
+caf::behavior io_worker(async_filesystem_config config) {
+  return {
+    [=](atom::write, const path& filename,
+        const std::vector<chunk_ptr>& chunks) -> caf::result<atom::ok> {
+      return to_result(write_file(filename, chunks, config));
+    },
+    [](atom::read, const path& filename) -> caf::result<chunk_ptr> {
+      return to_result(read_file(filename));
+    },
+    [](atom::mmap, const path& filename) -> chunk_ptr {
+      return chunk::mmap(filename);
+    },
+  };
+}
+
+using self_pointer
+  = filesystem_actor::stateful_pointer<async_filesystem_state>;
+
+// Runs an operation on the least loaded I/O thread, or queues it if all I/O
+// threads have reached their queue depth.
+void submit(self_pointer self, async_filesystem_state::operation op) {
+  auto& st = self->state;
+  auto least_loaded = std::min_element(st.load.begin(), st.load.end());
+  if (*least_loaded >= st.config.queue_depth) {
+    st.pending.push_back(std::move(op));
+    return;
+  }
+  ++*least_loaded;
+  op(static_cast<size_t>(least_loaded - st.load.begin()));
+}
+
+// Hands the next queued operation to an I/O thread that just completed one.
+void complete(self_pointer self, size_t worker) {
+  auto& st = self->state;
+  if (st.pending.empty()) {
+    --st.load[worker];
+    return;
+  }
+  auto op = std::move(st.pending.front());
+  st.pending.pop_front();
+  op(worker);
+}
+
+// Performs an operation on an I/O thread. Calls `finish` with the outcome
+// before delivering it to the requester via `rp`.
+template <class Result, class Finish, class... Ts>
+void dispatch(self_pointer self, caf::typed_response_promise<Result> rp,
+              Finish finish, Ts... xs) {
+  submit(self, [=](size_t worker) mutable {
+    self->request(self->state.workers[worker], caf::infinite, xs...)
+      .then(
+        [=](Result& x) mutable {
+          finish(caf::expected<Result>{x});
+          rp.deliver(std::move(x));
+          complete(self, worker);
+        },
+        [=](caf::error& err) mutable {
+          finish(caf::expected<Result>{err});
+          rp.deliver(std::move(err));
+          complete(self, worker);
+        });
+  });
+}
+
+// Runs a write once all earlier writes to the same file have completed.
+// Concurrent writes to one file would race on its temporary file, and the
+// file could end up with the contents of an earlier write.
+void serialize_write(self_pointer self, const path& filename,
+                     std::function<void()> write) {
+  auto [i, inserted] = self->state.writes.try_emplace(filename);
+  if (inserted)
+    write();
+  else
+    i->second.push_back(std::move(write));
+}
+
+// Starts the next queued write to a file after the previous one completed.
+void next_write(self_pointer self, const path& filename) {
+  auto& writes = self->state.writes;
+  auto i = writes.find(filename);
+  VAST_ASSERT(i != writes.end());
+  if (i->second.empty()) {
+    writes.erase(i);
+    return;
+  }
+  auto write = std::move(i->second.front());
+  i->second.pop_front();
+  write();
+}
+
+void put_latency(caf::settings& dict, const latency_histogram& latency) {
+  auto& buckets = put_dictionary(dict, "latency");
+  for (size_t i = 0; i < latency_histogram::num_buckets; ++i) {
+    if (latency.buckets[i] == 0)
+      continue;
+    auto bound = std::to_string(latency_histogram::upper_bound(i)) + "us";
+    auto key = i + 1 < latency_histogram::num_buckets
+                 ? "<=" + bound
+                 : ">" + std::to_string(latency_histogram::upper_bound(i - 1))
+                     + "us";
+    caf::put(buckets, key, latency.buckets[i]);
+  }
+}
+
+} // namespace
+
+caf::expected<async_filesystem_config>
+to_async_filesystem_config(const caf::settings& opts) {
+  async_filesystem_config result;
+  result.threads = caf::get_or(opts, "threads", result.threads);
+  result.queue_depth = caf::get_or(opts, "queue-depth", result.queue_depth);
+  if (result.queue_depth == 0)
+    return make_error(ec::invalid_configuration,
+                      "filesystem queue depth must be positive");
+  auto sync = caf::get_or(opts, "sync", std::string{"none"});
+  if (sync == "none")
+    result.sync = sync_policy::none;
+  else if (sync == "data")
+    result.sync = sync_policy::data;
+  else if (sync == "full")
+    result.sync = sync_policy::full;
+  else
+    return make_error(ec::invalid_configuration,
+                      "invalid filesystem sync policy:", sync);
+  result.drop_cache = caf::get_or(opts, "drop-cache", result.drop_cache);
+  return result;
+}
+
+filesystem_actor::behavior_type
+async_filesystem(filesystem_actor::stateful_pointer<async_filesystem_state> self,
+                 path root, async_filesystem_config config) {
+  self->state.config = config;
+  for (size_t i = 0; i < config.threads; ++i)
+    self->state.workers.push_back(
+      self->spawn<caf::detached + caf::linked>(io_worker, config));
+  self->state.load.resize(config.threads, 0);
+  // Both kinds of writes go through the same code path, which makes single
+  // chunks a special case of gathered chunks.
+  auto write = [=](path filename,
+                   std::vector<chunk_ptr> chunks) -> caf::result<atom::ok> {
+    auto path = filename.is_absolute() ? filename : root / filename;
+    auto size = size_t{0};
+    for (auto& chk : chunks)
+      size += chk->size();
+    auto finish = [=, start = stopwatch::now()](
+                    const caf::expected<atom::ok>& x) {
+      auto& st = self->state;
+      st.write_latency.add(stopwatch::now() - start);
+      if (x) {
+        ++st.stats.writes.successful;
+        st.stats.writes.bytes += size;
+      } else {
+        ++st.stats.writes.failed;
+      }
+      if (!st.workers.empty())
+        next_write(self, path);
+    };
+    if (self->state.workers.empty()) {
+      auto result = write_file(path, chunks, self->state.config);
+      finish(result);
+      return to_result(std::move(result));
+    }
+    auto rp = self->make_response_promise<atom::ok>();
+    serialize_write(self, path, [=] {
+      dispatch(self, rp, finish, atom::write_v, path, chunks);
+    });
+    return rp;
+  };
+  return {
+    [=](atom::write, const path& filename,
+        chunk_ptr chk) -> caf::result<atom::ok> {
+      VAST_ASSERT(chk != nullptr);
+      return write(filename, {std::move(chk)});
+    },
+    [=](atom::write, const path& filename,
+        std::vector<chunk_ptr> chunks) -> caf::result<atom::ok> {
+      return write(filename, std::move(chunks));
+    },
+    [=](atom::read, const path& filename) -> caf::result<chunk_ptr> {
+      auto path = filename.is_absolute() ? filename : root / filename;
+      auto finish
+        = [=, start = stopwatch::now()](const caf::expected<chunk_ptr>& x) {
+            auto& st = self->state;
+            st.read_latency.add(stopwatch::now() - start);
+            if (!x) {
+              ++st.stats.reads.failed;
+              return;
+            }
+            ++st.stats.reads.successful;
+            st.stats.reads.bytes += (*x)->size();
+          };
+      if (self->state.workers.empty()) {
+        auto result = read_file(path);
+        finish(result);
+        return to_result(std::move(result));
+      }
+      auto rp = self->make_response_promise<chunk_ptr>();
+      dispatch(self, rp, std::move(finish), atom::read_v, std::move(path));
+      return rp;
+    },
+    [=](atom::mmap, const path& filename) -> caf::result<chunk_ptr> {
+      auto path = filename.is_absolute() ? filename : root / filename;
+      auto finish
+        = [=, start = stopwatch::now()](const caf::expected<chunk_ptr>& x) {
+            auto& st = self->state;
+            st.mmap_latency.add(stopwatch::now() - start);
+            if (!x || *x == nullptr) {
+              ++st.stats.mmaps.failed;
+              return;
+            }
+            ++st.stats.mmaps.successful;
+            st.stats.mmaps.bytes += (*x)->size();
+          };
+      if (self->state.workers.empty()) {
+        auto result = chunk::mmap(path);
+        finish(result);
+        return result;
+      }
+      auto rp = self->make_response_promise<chunk_ptr>();
+      dispatch(self, rp, std::move(finish), atom::mmap_v, std::move(path));
+      return rp;
+    },
+    [=](atom::status, status_verbosity v) {
+      auto& st = self->state;
+      auto result = caf::settings{};
+      if (v >= status_verbosity::info) {
+        caf::put(result, "filesystem.type", "POSIX");
+        caf::put(result, "filesystem.threads", uint64_t{st.workers.size()});
+      }
+      if (v >= status_verbosity::debug) {
+        caf::put(result, "filesystem.pending", uint64_t{st.pending.size()});
+        auto& ops = put_dictionary(result, "filesystem.operations");
+        auto add_stats = [&](auto& name, auto& stats, auto& latency) {
+          auto& dict = put_dictionary(ops, name);
+          caf::put(dict, "successful", stats.successful);
+          caf::put(dict, "failed", stats.failed);
+          caf::put(dict, "bytes", stats.bytes);
+          put_latency(dict, latency);
+        };
+        add_stats("writes", st.stats.writes, st.write_latency);
+        add_stats("reads", st.stats.reads, st.read_latency);
+        add_stats("mmaps", st.stats.mmaps, st.mmap_latency);
+      }
+      return result;
+    },
+  };
+}
+
+} // namespace vast::system
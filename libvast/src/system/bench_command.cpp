@@ -0,0 +1,318 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/system/bench_command.hpp"
+
+#include "vast/concept/parseable/to.hpp"
+#include "vast/concept/parseable/vast/json.hpp"
+#include "vast/concept/printable/to_string.hpp"
+#include "vast/concept/printable/vast/json.hpp"
+#include "vast/defaults.hpp"
+#include "vast/detail/line_range.hpp"
+#include "vast/directory.hpp"
+#include "vast/error.hpp"
+#include "vast/format/test.hpp"
+#include "vast/json.hpp"
+#include "vast/logger.hpp"
+#include "vast/path.hpp"
+#include "vast/scope_linked.hpp"
+#include "vast/system/accountant_actor.hpp"
+#include "vast/system/flush_listener_actor.hpp"
+#include "vast/system/make_source.hpp"
+#include "vast/system/node_control.hpp"
+#include "vast/system/signal_monitor.hpp"
+#include "vast/system/spawn_or_connect_to_node.hpp"
+#include "vast/system/type_registry_actor.hpp"
+
+#include <caf/actor.hpp>
+#include <caf/scoped_actor.hpp>
+#include <caf/settings.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vast::system {
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+struct query {
+  std::string name;
+  std::string expression;
+};
+
+// Representative queries over the builtin schema of the test reader.
+std::vector<query> builtin_queries() {
+  auto large_in = std::string{"i in ["};
+  for (int i = 0; i < 256; ++i) {
+    if (i > 0)
+      large_in += ", ";
+    large_in += std::to_string(i * 13 - 1000);
+  }
+  large_in += ']';
+  return {
+    {"point", "i == 42"},
+    {"address", "a == 0.0.1.42"},
+    {"subnet", "a in 0.0.0.0/22"},
+    {"substring", "\"42\" in s"},
+    {"time-range", "t >= 1970-01-01 && t < 1970-01-02"},
+    {"range", "r > 2.5"},
+    {"duration-range", "d >= 120ns && d < 180ns"},
+    {"count-range", "c > 3"},
+    {"conjunction", "b == T && c > 10"},
+    {"type", "#type == \"test.full\""},
+    {"large-in", std::move(large_in)},
+  };
+}
+
+// Reads one query per line, ignoring empty lines and comments.
+caf::expected<std::vector<query>> read_queries(const std::string& filename) {
+  std::ifstream in{filename};
+  if (!in)
+    return make_error(ec::no_such_file, "failed to open query file", filename);
+  std::vector<query> result;
+  detail::line_range lines{in};
+  for (lines.next(); !lines.done(); lines.next()) {
+    auto line = lines.get();
+    if (line[0] == '#')
+      continue;
+    result.push_back({"line-" + std::to_string(lines.line_number()),
+                      std::string{line}});
+  }
+  if (result.empty())
+    return make_error(ec::invalid_argument, "no queries in", filename);
+  return result;
+}
+
+double seconds(bench_clock::duration x) {
+  return std::chrono::duration<double>{x}.count();
+}
+
+// Selects a percentile from sorted samples via the nearest-rank method.
+double percentile(const std::vector<bench_clock::duration>& xs, double p) {
+  VAST_ASSERT(!xs.empty());
+  auto rank = static_cast<size_t>(std::ceil(p * xs.size()));
+  return seconds(xs[std::max(rank, size_t{1}) - 1]);
+}
+
+// Ingests events from the test reader and waits until the importer flushed
+// them to the index and archive.
+caf::error ingest(caf::scoped_actor& self, caf::actor_system& sys,
+                  const invocation& inv, const caf::actor& node,
+                  const caf::actor& accountant, const caf::actor& type_registry,
+                  const caf::actor& importer) {
+  auto src_result = make_source<format::test::reader, defaults::import::test>(
+    self, sys, inv, caf::actor_cast<accountant_actor>(accountant),
+    caf::actor_cast<type_registry_actor>(type_registry), importer);
+  if (!src_result)
+    return std::move(src_result.error());
+  auto src = std::move(src_result->src);
+  caf::error err;
+  self->request(node, caf::infinite, atom::put_v, src, "source")
+    .receive([](atom::ok) {}, [&](caf::error& e) { err = std::move(e); });
+  if (err) {
+    self->send_exit(src, caf::exit_reason::user_shutdown);
+    return err;
+  }
+  self->monitor(src);
+  self->monitor(importer);
+  bool stop = false;
+  self
+    ->do_receive(
+      [&](const caf::down_msg& msg) {
+        if (msg.source == importer) {
+          self->send_exit(src, caf::exit_reason::user_shutdown);
+          err = ec::remote_node_down;
+          stop = true;
+        } else if (msg.source == src) {
+          self->send(importer, atom::subscribe_v, atom::flush::value,
+                     wrapped_flush_listener{
+                       caf::actor_cast<flush_listener_actor>(self)});
+        }
+      },
+      [&](atom::flush) { stop = true; },
+      [&](atom::signal, int signal) {
+        if (signal == SIGINT || signal == SIGTERM) {
+          self->send_exit(src, caf::exit_reason::user_shutdown);
+          err = ec::unspecified;
+        }
+      })
+    .until(stop);
+  self->demonitor(importer);
+  return err;
+}
+
+// Runs a query through a COUNTER and returns the number of hits.
+caf::expected<uint64_t>
+run_query(caf::scoped_actor& self, const caf::actor& node,
+          const invocation& inv, const std::string& expression) {
+  caf::actor cnt;
+  caf::error err;
+  self
+    ->request(node, caf::infinite,
+              invocation{inv.options, "spawn counter", {expression}})
+    .receive([&](caf::actor& a) { cnt = std::move(a); },
+             [&](caf::error& e) { err = std::move(e); });
+  if (err)
+    return err;
+  if (!cnt)
+    return make_error(ec::invalid_result, "remote spawn returned nullptr");
+  self->send(cnt, atom::run_v, self);
+  bool counting = true;
+  uint64_t result = 0;
+  self->receive_while(counting)([&](uint64_t x) { result += x; },
+                                [&](atom::done) { counting = false; });
+  return result;
+}
+
+// Collects memory and disk usage from the status of the node.
+json::object resource_usage(caf::scoped_actor& self, const caf::actor& node,
+                            const invocation& inv) {
+  json::object result;
+  std::string status;
+  self->request(node, caf::infinite, invocation{inv.options, "status", {}})
+    .receive([&](std::string& x) { status = std::move(x); },
+             [&](caf::error& err) {
+               VAST_WARNING_ANON("bench failed to retrieve node status:",
+                                 render(err));
+             });
+  auto j = to<json>(status);
+  if (!j)
+    return result;
+  auto obj = caf::get_if<json::object>(&j->get_data());
+  if (!obj)
+    return result;
+  auto sys = obj->find("system");
+  if (sys == obj->end())
+    return result;
+  auto xs = caf::get_if<json::object>(&sys->second.get_data());
+  if (!xs)
+    return result;
+  for (auto key : {"current-memory-usage", "peak-memory-usage"})
+    if (auto x = xs->find(key); x != xs->end())
+      result[key] = x->second;
+  // The database size is only available if the node shares our filesystem.
+  if (auto x = xs->find("database-path"); x != xs->end()) {
+    if (auto dir = caf::get_if<json::string>(&x->second.get_data());
+        dir && exists(path{*dir}))
+      result["database-size"] = recursive_size(directory{path{*dir}});
+  }
+  return result;
+}
+
+} // namespace
+
+caf::message bench_command(const invocation& inv, caf::actor_system& sys) {
+  VAST_TRACE(inv);
+  const auto& options = inv.options;
+  auto events = caf::get_or(options, "vast.bench.events",
+                            defaults::bench::events);
+  auto seed = caf::get_or(options, "vast.bench.seed", defaults::bench::seed);
+  auto runs = caf::get_or(options, "vast.bench.runs", defaults::bench::runs);
+  if (events == 0 || runs == 0)
+    return caf::make_message(make_error(ec::invalid_argument,
+                                        "events and runs must be positive"));
+  auto queries = builtin_queries();
+  if (auto file = caf::get_if<std::string>(&options, "vast.bench.queries")) {
+    auto xs = read_queries(*file);
+    if (!xs)
+      return caf::make_message(std::move(xs.error()));
+    queries = std::move(*xs);
+  }
+  caf::scoped_actor self{sys};
+  auto node_opt
+    = spawn_or_connect_to_node(self, options, content(sys.config()));
+  if (auto err = caf::get_if<caf::error>(&node_opt))
+    return caf::make_message(std::move(*err));
+  auto& node = caf::holds_alternative<caf::actor>(node_opt)
+                 ? caf::get<caf::actor>(node_opt)
+                 : caf::get<scope_linked_actor>(node_opt).get();
+  VAST_ASSERT(node != nullptr);
+  auto components = get_node_components(self, node, "accountant",
+                                        "type-registry", "importer");
+  if (!components)
+    return caf::make_message(std::move(components.error()));
+  auto& [accountant, type_registry, importer] = *components;
+  if (!type_registry)
+    return caf::make_message(
+      make_error(ec::missing_component, "type-registry"));
+  if (!importer)
+    return caf::make_message(make_error(ec::missing_component, "importer"));
+  std::thread sig_mon_thread;
+  auto guard = signal_monitor::run_guarded(
+    sig_mon_thread, sys, defaults::system::signal_monitoring_interval, self);
+  json::object result;
+  result["events"] = events;
+  result["seed"] = seed;
+  // Ingest the synthetic workload.
+  auto import_options = options;
+  caf::put(import_options, "vast.import.max-events", events);
+  caf::put(import_options, "vast.import.test.seed", seed);
+  // An alternate schema allows for comparing index configurations, e.g., via
+  // #index=bitslice on arithmetic fields.
+  if (auto file = caf::get_if<std::string>(&options, "vast.bench.schema-file"))
+    caf::put(import_options, "vast.import.test.schema-file", *file);
+  auto import_inv = invocation{std::move(import_options), "import test", {}};
+  VAST_INFO_ANON("bench ingests", events, "events with seed", seed);
+  auto start = bench_clock::now();
+  if (auto err = ingest(self, sys, import_inv, node, accountant, type_registry,
+                        importer))
+    return caf::make_message(std::move(err));
+  auto elapsed = seconds(bench_clock::now() - start);
+  json::object ingest_result;
+  ingest_result["duration"] = elapsed;
+  ingest_result["rate"] = events / elapsed;
+  result["ingest"] = std::move(ingest_result);
+  // Run every query repeatedly and record its latency distribution.
+  json::array query_results;
+  for (auto& q : queries) {
+    VAST_INFO_ANON("bench runs query", q.name, runs, "times");
+    std::vector<bench_clock::duration> latencies;
+    latencies.reserve(runs);
+    uint64_t hits = 0;
+    for (size_t i = 0; i < runs; ++i) {
+      auto query_start = bench_clock::now();
+      auto x = run_query(self, node, inv, q.expression);
+      if (!x)
+        return caf::make_message(std::move(x.error()));
+      latencies.push_back(bench_clock::now() - query_start);
+      hits = *x;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    json::object latency;
+    latency["min"] = seconds(latencies.front());
+    latency["p50"] = percentile(latencies, 0.5);
+    latency["p99"] = percentile(latencies, 0.99);
+    latency["max"] = seconds(latencies.back());
+    json::object query_result;
+    query_result["name"] = q.name;
+    query_result["expression"] = q.expression;
+    query_result["hits"] = hits;
+    query_result["latency"] = std::move(latency);
+    query_results.emplace_back(std::move(query_result));
+  }
+  result["queries"] = std::move(query_results);
+  result["resources"] = resource_usage(self, node, inv);
+  std::cout << to_string(json{std::move(result)}) << std::endl;
+  return caf::none;
+}
+
+} // namespace vast::system
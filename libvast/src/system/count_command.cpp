@@ -13,8 +13,10 @@
 
 #include "vast/system/count_command.hpp"
 
+#include "vast/aggregation.hpp"
 #include "vast/concept/parseable/to.hpp"
 #include "vast/concept/parseable/vast/expression.hpp"
+#include "vast/concept/printable/vast/json.hpp"
 #include "vast/defaults.hpp"
 #include "vast/error.hpp"
 #include "vast/fwd.hpp"
@@ -33,6 +35,9 @@
 
 #include <chrono>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
 
 using namespace caf;
 using namespace std::chrono_literals;
@@ -79,12 +84,51 @@ caf::message count_command(const invocation& inv, caf::actor_system& sys) {
   self->send(cnt, atom::run_v, self);
   bool counting = true;
   uint64_t result = 0;
+  caf::optional<std::pair<uint64_t, uint64_t>> bounds;
+  caf::optional<aggregation> groups;
   self->receive_while
     // Loop until false.
     (counting)
     // Message handlers.
-    ([&](uint64_t x) { result += x; }, [&](atom::done) { counting = false; });
-  std::cout << result << std::endl;
+    ([&](uint64_t x) { result += x; },
+     [&](aggregation& x) {
+       if (groups)
+         groups->merge(x);
+       else
+         groups = std::move(x);
+     },
+     [&](atom::estimate, uint64_t lower, uint64_t upper) {
+       bounds = std::pair{lower, upper};
+     },
+     [&](atom::done) { counting = false; });
+  if (caf::get_or(options, "vast.count.approximate", false)) {
+    if (!bounds)
+      return caf::make_message(
+        make_error(ec::unspecified, "failed to estimate the result"));
+    std::cout << bounds->first << ' ' << bounds->second << std::endl;
+    return caf::none;
+  }
+  if (caf::get_or(options, "vast.count.by", std::vector<std::string>{})
+        .empty()) {
+    std::cout << result << std::endl;
+    return caf::none;
+  }
+  // Print one JSON object per group.
+  if (!groups)
+    return caf::none;
+  if (auto threshold = groups->threshold(); threshold > 0)
+    VAST_WARNING_ANON(inv.full_name, "evicted groups with up to", threshold,
+                      "events each; consider raising --max-groups");
+  auto printer = json_printer<policy::oneline>{};
+  auto buffer = std::string{};
+  for (auto& group : groups->make_records()) {
+    auto x = data{std::move(group)};
+    buffer.clear();
+    auto out = std::back_inserter(buffer);
+    printer.print(out, make_view(x));
+    std::cout << buffer << '\n';
+  }
+  std::cout << std::flush;
   return caf::none;
 }
 
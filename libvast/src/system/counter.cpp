@@ -26,10 +26,33 @@ counter_state::counter_state(caf::event_based_actor* self) : super(self) {
 }
 
 void counter_state::init(expression expr, index_actor index,
-                         archive_actor archive, bool skip_candidate_check) {
-  skip_candidate_check_ = skip_candidate_check;
+                         archive_actor archive, count_mode mode,
+                         aggregation_spec spec) {
+  // Grouping requires looking at the events, so we cannot skip the ARCHIVE.
+  skip_candidate_check_ = mode == count_mode::estimate && spec.keys.empty();
   expr_ = std::move(expr);
+  spec_ = std::move(spec);
   archive_ = std::move(archive);
+  if (mode == count_mode::approximate) {
+    // Answer from the META INDEX alone, which requires no further states.
+    behaviors_[idle].assign([=](atom::run, caf::actor client) {
+      client_ = std::move(client);
+      self_->request(index, caf::infinite, atom::estimate_v, expr_)
+        .then(
+          [this](uint64_t lower, uint64_t upper) {
+            self_->send(client_, atom::estimate_v, lower, upper);
+            self_->send(client_, atom::done_v);
+            self_->quit();
+          },
+          [this](caf::error& err) {
+            VAST_ERROR(self_, "failed to estimate the number of results:",
+                       self_->system().render(err));
+            self_->send(client_, atom::done_v);
+            self_->quit(std::move(err));
+          });
+    });
+    return;
+  }
   // Transition from idle state when receiving 'run' and client handle.
   behaviors_[idle].assign([=](atom::run, caf::actor client) {
     client_ = std::move(client);
@@ -44,8 +67,26 @@ void counter_state::init(expression expr, index_actor index,
   // Add additional message handlers if we need to perform candidate checks.
   if (skip_candidate_check_)
     return;
-  self_->send(archive_, atom::exporter_v, self_);
+  auto handle_done = [this](atom::done, const caf::error&) {
+    if (self_->current_sender() != archive_) {
+      VAST_WARNING(self_, "received ('done', error) from unexpected actor");
+      return;
+    }
+    if (--pending_archive_requests_ == 0)
+      block_end_of_hits(false);
+  };
   caf::message_handler base{behaviors_[collect_hits].as_behavior_impl()};
+  if (!spec_.keys.empty()) {
+    self_->send(archive_, atom::exporter_v, self_, expr_, spec_);
+    behaviors_[collect_hits] = base.or_else(
+      [this](aggregation& partial) {
+        // The ARCHIVE already performed the candidate check.
+        self_->send(client_, std::move(partial));
+      },
+      handle_done);
+    return;
+  }
+  self_->send(archive_, atom::exporter_v, self_);
   behaviors_[collect_hits] = base.or_else(
     [this](table_slice slice) {
       // Construct a candidate checker if we don't have one for this type.
@@ -65,14 +106,7 @@ void counter_state::init(expression expr, index_actor index,
       if (num_results > 0)
         self_->send(client_, num_results);
     },
-    [this](atom::done, const caf::error&) {
-      if (self_->current_sender() != archive_) {
-        VAST_WARNING(self_, "received ('done', error) from unexpected actor");
-        return;
-      }
-      if (--pending_archive_requests_ == 0)
-        block_end_of_hits(false);
-    });
+    handle_done);
 }
 
 void counter_state::process_hits(const ids& hits) {
@@ -103,9 +137,10 @@ void counter_state::process_end_of_hits() {
 
 caf::behavior
 counter(caf::stateful_actor<counter_state>* self, expression expr,
-        index_actor index, archive_actor archive, bool skip_candidate_check) {
-  self->state.init(std::move(expr), std::move(index), std::move(archive),
-                   skip_candidate_check);
+        index_actor index, archive_actor archive, count_mode mode,
+        aggregation_spec spec) {
+  self->state.init(std::move(expr), std::move(index), std::move(archive), mode,
+                   std::move(spec));
   return self->state.behavior();
 }
 
@@ -13,6 +13,7 @@
 
 #include "vast/system/evaluator.hpp"
 
+#include "vast/bitmap_algorithms.hpp"
 #include "vast/expression_visitors.hpp"
 #include "vast/fwd.hpp"
 #include "vast/logger.hpp"
@@ -21,6 +22,8 @@
 #include <caf/event_based_actor.hpp>
 #include <caf/stateful_actor.hpp>
 
+#include <algorithm>
+
 namespace vast::system {
 
 namespace {
@@ -33,6 +36,13 @@ public:
     push();
   }
 
+  /// Evaluates a subexpression at the given position.
+  ids_evaluator(const evaluator_state::predicate_hits_map& xs,
+                offset position)
+    : hits_(xs), position_(std::move(position)) {
+    // nop
+  }
+
   ids operator()(caf::none_t) {
     return {};
   }
@@ -86,6 +96,32 @@ private:
   offset position_;
 };
 
+// Groups the evaluation triples into stages that the EVALUATOR dispatches one
+// after another. For a top-level conjunction, every conjunct forms a stage in
+// the order of its first triple. Otherwise, all triples form a single stage.
+std::vector<std::vector<evaluation_triple>>
+make_stages(const expression& expr,
+            const std::vector<evaluation_triple>& eval) {
+  std::vector<std::vector<evaluation_triple>> result;
+  if (!caf::holds_alternative<conjunction>(expr)) {
+    result.push_back(eval);
+    return result;
+  }
+  std::vector<size_t> conjuncts;
+  for (auto& triple : eval) {
+    auto& pos = std::get<0>(triple);
+    VAST_ASSERT(pos.size() > 1);
+    auto i = std::find(conjuncts.begin(), conjuncts.end(), pos[1]);
+    if (i == conjuncts.end()) {
+      conjuncts.push_back(pos[1]);
+      result.emplace_back();
+      i = conjuncts.end() - 1;
+    }
+    result[i - conjuncts.begin()].push_back(triple);
+  }
+  return result;
+}
+
 } // namespace
 
 evaluator_state::evaluator_state(
@@ -124,6 +160,8 @@ void evaluator_state::handle_missing_result(const offset& position,
 
 void evaluator_state::evaluate() {
   auto expr_hits = caf::visit(ids_evaluator{predicate_hits}, expr);
+  if (!candidates.empty())
+    expr_hits &= candidates;
   VAST_DEBUG(self, "got predicate_hits:", predicate_hits,
              "expr_hits:", expr_hits);
   auto delta = expr_hits - hits;
@@ -135,9 +173,51 @@ void evaluator_state::evaluate() {
 
 void evaluator_state::decrement_pending() {
   // We're done evaluating if all INDEXER actors have reported their hits.
-  if (--pending_responses == 0) {
-    VAST_DEBUG(self, "completed expression evaluation");
-    promise.deliver(atom::done_v);
+  if (--pending_responses > 0)
+    return;
+  if (next_stage < stages.size()) {
+    // Only conjunctions consist of multiple stages. Every completed stage
+    // narrows down the rows that can still match the expression.
+    auto conj = caf::get_if<conjunction>(&expr);
+    VAST_ASSERT(conj != nullptr);
+    auto k = std::get<0>(stages[next_stage - 1].front())[1];
+    auto conjunct_hits
+      = caf::visit(ids_evaluator{predicate_hits, offset{0, k}}, (*conj)[k]);
+    if (next_stage == 1) {
+      intersection = std::move(conjunct_hits);
+      if (!candidates.empty())
+        intersection &= candidates;
+    } else {
+      intersection &= conjunct_hits;
+    }
+    if (any<1>(intersection)) {
+      dispatch();
+      return;
+    }
+    VAST_DEBUG(self, "skips", stages.size() - next_stage,
+               "conjuncts after an empty intersection");
+  }
+  VAST_DEBUG(self, "completed expression evaluation");
+  promise.deliver(atom::done_v);
+}
+
+void evaluator_state::dispatch() {
+  VAST_ASSERT(next_stage < stages.size());
+  auto& stage = stages[next_stage++];
+  pending_responses += stage.size();
+  for (auto& triple : stage) {
+    // No strucutured bindings available due to subsequent lambda. :-/
+    // TODO: C++20
+    auto& pos = std::get<0>(triple);
+    auto& curried_pred = std::get<1>(triple);
+    auto& indexer = std::get<2>(triple);
+    ++predicate_hits[pos].first;
+    // The state lives as long as the actor, which outlives its requests.
+    self->request(indexer, caf::infinite, curried_pred)
+      .then([this, pos](const ids& hits) { handle_result(pos, hits); },
+            [this, pos](const caf::error& err) {
+              handle_missing_result(pos, err);
+            });
   }
 }
 
@@ -149,9 +229,11 @@ evaluator_state::hits_for(const offset& position) {
 
 evaluator_actor::behavior_type
 evaluator(evaluator_actor::stateful_pointer<evaluator_state> self,
-          expression expr, std::vector<evaluation_triple> eval) {
+          expression expr, std::vector<evaluation_triple> eval,
+          ids candidates) {
   VAST_TRACE(VAST_ARG(expr), VAST_ARG(eval));
   VAST_ASSERT(!eval.empty());
+  self->state.candidates = std::move(candidates);
   return {
     [=, expr = std::move(expr),
      eval = std::move(eval)](partition_client_actor client) {
@@ -159,20 +241,8 @@ evaluator(evaluator_actor::stateful_pointer<evaluator_state> self,
       st.client = client;
       st.expr = std::move(expr);
       st.promise = self->make_response_promise<atom::done>();
-      st.pending_responses += eval.size();
-      for (auto& triple : eval) {
-        // No strucutured bindings available due to subsequent lambda. :-/
-        // TODO: C++20
-        auto& pos = std::get<0>(triple);
-        auto& curried_pred = std::get<1>(triple);
-        auto& indexer = std::get<2>(triple);
-        ++st.predicate_hits[pos].first;
-        self->request(indexer, caf::infinite, curried_pred)
-          .then([=](const ids& hits) { self->state.handle_result(pos, hits); },
-                [=](const caf::error& err) {
-                  self->state.handle_missing_result(pos, err);
-                });
-      }
+      st.stages = make_stages(st.expr, eval);
+      st.dispatch();
       if (st.pending_responses == 0) {
         VAST_DEBUG(self, "has nothing to evaluate for expression");
         st.promise.deliver(atom::done_v);
@@ -17,6 +17,7 @@
 
 #include "vast/command.hpp"
 #include "vast/concept/printable/to_string.hpp"
+#include "vast/bitmap_algorithms.hpp"
 #include "vast/concept/printable/vast/expression.hpp"
 #include "vast/defaults.hpp"
 #include "vast/detail/string.hpp"
@@ -33,6 +34,7 @@
 #include <caf/settings.hpp>
 
 #include <algorithm>
+#include <map>
 #include <optional>
 
 using namespace std::chrono_literals;
@@ -46,21 +48,13 @@ explorer_state::explorer_state(caf::event_based_actor*) {
 void explorer_state::forward_results(vast::table_slice slice) {
   // Check which of the ids in this slice were already sent to the sink
   // and forward those that were not.
-  vast::bitmap unseen;
-  for (size_t i = 0; i < slice.rows(); ++i) {
-    auto id = slice.offset() + i;
-    auto [_, new_] = returned_ids.insert(id);
-    if (new_) {
-      vast::ids tmp;
-      tmp.append_bits(false, id);
-      tmp.append_bits(true, 1);
-      unseen |= tmp;
-    }
-  }
-  if (unseen.empty())
+  auto unseen = make_ids(slice) - returned_ids;
+  auto num_unseen = rank(unseen);
+  if (num_unseen == 0)
     return;
+  returned_ids |= unseen;
   std::vector<table_slice> slices;
-  if (unseen.size() == slice.rows()) {
+  if (num_unseen == slice.rows()) {
     slices.push_back(slice);
   } else {
     // If a slice was partially known, divide it up and forward only those
@@ -83,6 +77,136 @@ void explorer_state::forward_results(vast::table_slice slice) {
   return;
 }
 
+std::optional<std::pair<expression, size_t>>
+explorer_state::make_context_query(const table_slice& slice) const {
+  auto&& layout = slice.layout();
+  auto it = std::find_if(layout.fields.begin(), layout.fields.end(),
+                         [](const record_field& field) {
+                           return has_attribute(field.type, "timestamp");
+                         });
+  if (it == layout.fields.end()) {
+    VAST_DEBUG(self, "could not find timestamp field in", layout);
+    return std::nullopt;
+  }
+  std::optional<table_slice_column> by_column;
+  if (by) {
+    // Need to pivot from caf::optional to std::optional here, as the
+    // former doesnt support emplace or value assignment.
+    if (auto col = table_slice_column::make(slice, *by))
+      by_column.emplace(std::move(*col));
+    if (!by_column) {
+      VAST_TRACE("skipping slice with", layout, "because it has no column",
+                 *by);
+      return std::nullopt;
+    }
+  }
+  VAST_DEBUG(self, "uses", it->name, "to construct timebox");
+  auto column = table_slice_column::make(slice, it->name);
+  VAST_ASSERT(column);
+  // Collect the time boxes per value of the `by` field, or in a single group
+  // if there is none.
+  std::map<data, std::vector<std::pair<vast::time, vast::time>>> groups;
+  size_t num_results = 0;
+  for (size_t i = 0; i < column->size(); ++i) {
+    auto data_view = (*column)[i];
+    auto x = caf::get_if<vast::time>(&data_view);
+    // Skip if no value
+    if (!x)
+      continue;
+    auto key = data{};
+    if (by) {
+      VAST_ASSERT(by_column); // Should have been checked above.
+      auto ci = (*by_column)[i];
+      if (caf::get_if<caf::none_t>(&ci))
+        continue;
+      key = materialize(ci);
+    }
+    auto& boxes = groups[std::move(key)];
+    // A missing side leaves the time box open in that direction.
+    if (before || after)
+      boxes.emplace_back(before ? *x - *before : vast::time::min(),
+                         after ? *x + *after : vast::time::max());
+    ++num_results;
+  }
+  if (groups.empty())
+    return std::nullopt;
+  disjunction result;
+  for (auto& [key, boxes] : groups) {
+    // Merge overlapping time boxes into one.
+    std::sort(boxes.begin(), boxes.end());
+    disjunction temporal;
+    for (size_t i = 0; i < boxes.size();) {
+      auto [from, to] = boxes[i];
+      for (++i; i < boxes.size() && boxes[i].first <= to; ++i)
+        to = std::max(to, boxes[i].second);
+      conjunction box;
+      if (from != vast::time::min())
+        box.emplace_back(predicate{attribute_extractor{atom::timestamp_v},
+                                   greater_equal, data{from}});
+      if (to != vast::time::max())
+        box.emplace_back(predicate{attribute_extractor{atom::timestamp_v},
+                                   less_equal, data{to}});
+      if (box.size() == 1)
+        temporal.push_back(std::move(box.front()));
+      else
+        temporal.emplace_back(std::move(box));
+    }
+    conjunction group;
+    if (by)
+      group.emplace_back(predicate{field_extractor{*by}, equal, key});
+    if (temporal.size() == 1)
+      group.push_back(std::move(temporal.front()));
+    else if (!temporal.empty())
+      group.emplace_back(std::move(temporal));
+    // We should have checked during argument parsing that `group` has at
+    // least one constraint.
+    VAST_ASSERT(!group.empty());
+    if (group.size() == 1)
+      result.push_back(std::move(group.front()));
+    else
+      result.emplace_back(std::move(group));
+  }
+  if (result.size() == 1)
+    return std::pair{std::move(result.front()), num_results};
+  return std::pair{expression{std::move(result)}, num_results};
+}
+
+void explorer_state::spawn_exporters() {
+  while (!pending_queries.empty()
+         && running_exporters < max_running_exporters) {
+    auto [expr, max_events] = std::move(pending_queries.front());
+    pending_queries.pop_front();
+    auto query = to_string(expr);
+    VAST_TRACE(self, "spawns new exporter with query", query);
+    auto exporter_invocation = invocation{{}, "spawn exporter", {query}};
+    if (max_events > 0)
+      caf::put(exporter_invocation.options, "vast.export.max-events",
+               max_events);
+    ++running_exporters;
+    self->request(node, caf::infinite, exporter_invocation)
+      .then(
+        [this](caf::actor handle) {
+          auto exporter = caf::actor_cast<exporter_actor>(handle);
+          VAST_DEBUG(self, "registers exporter", exporter);
+          self->monitor(exporter);
+          self->send(exporter, atom::sink_v, self);
+          self->send(exporter, atom::run_v);
+        },
+        [this](caf::error error) {
+          VAST_ERROR(self, "failed to spawn exporter:", render(error));
+          --running_exporters;
+          spawn_exporters();
+          quit_if_done();
+        });
+  }
+}
+
+void explorer_state::quit_if_done() {
+  if (initial_query_completed && running_exporters == 0
+      && pending_queries.empty())
+    self->quit();
+}
+
 caf::behavior
 explorer(caf::stateful_actor<explorer_state>* self, caf::actor node,
          explorer_state::event_limits limits,
@@ -103,18 +227,14 @@ explorer(caf::stateful_actor<explorer_state>* self, caf::actor node,
   st.before = before;
   st.after = after;
   st.by = by;
-  auto quit_if_done = [=]() {
-    auto& st = self->state;
-    if (st.initial_query_completed && st.running_exporters == 0)
-      self->quit();
-  };
   self->set_down_handler([=]([[maybe_unused]] const caf::down_msg& msg) {
     // Only the spawned EXPORTERs are expected to send down messages.
     auto& st = self->state;
     --st.running_exporters;
     VAST_DEBUG(self, "received DOWN from", msg.source,
                "outstanding requests:", st.running_exporters);
-    quit_if_done();
+    st.spawn_exporters();
+    st.quit_if_done();
   });
   return {
     [=](table_slice slice) {
@@ -132,95 +252,14 @@ explorer(caf::stateful_actor<explorer_state>* self, caf::actor node,
       // Don't bother making new queries if we discard all results anyways.
       if (st.num_sent >= st.limits.total)
         return;
-      auto&& layout = slice.layout();
-      auto it = std::find_if(layout.fields.begin(), layout.fields.end(),
-                             [](const record_field& field) {
-                               return has_attribute(field.type, "timestamp");
-                             });
-      if (it == layout.fields.end()) {
-        VAST_DEBUG(self, "could not find timestamp field in", layout);
+      // Explore the context of all results in the slice with a single query.
+      auto query = st.make_context_query(slice);
+      if (!query)
         return;
-      }
-      std::optional<table_slice_column> by_column;
-      if (st.by) {
-        // Need to pivot from caf::optional to std::optional here, as the
-        // former doesnt support emplace or value assignment.
-        if (auto col = table_slice_column::make(slice, *st.by))
-          by_column.emplace(std::move(*col));
-        if (!by_column) {
-          VAST_TRACE("skipping slice with", layout, "because it has no column",
-                     *st.by);
-          return;
-        }
-      }
-      VAST_DEBUG(self, "uses", it->name, "to construct timebox");
-      auto column = table_slice_column::make(slice, it->name);
-      VAST_ASSERT(column);
-      for (size_t i = 0; i < column->size(); ++i) {
-        auto data_view = (*column)[i];
-        auto x = caf::get_if<vast::time>(&data_view);
-        // Skip if no value
-        if (!x)
-          continue;
-        std::optional<vast::expression> before_expr;
-        if (st.before)
-          before_expr = predicate{attribute_extractor{atom::timestamp_v},
-                                  greater_equal, data{*x - *st.before}};
-
-        std::optional<vast::expression> after_expr;
-        if (st.after)
-          after_expr = predicate{attribute_extractor{atom::timestamp_v},
-                                 less_equal, data{*x + *st.after}};
-        std::optional<vast::expression> by_expr;
-        if (st.by) {
-          VAST_ASSERT(by_column); // Should have been checked above.
-          auto ci = (*by_column)[i];
-          if (caf::get_if<caf::none_t>(&ci))
-            continue;
-          // TODO: Make `predicate` accept a data_view as well to save
-          // the call to `materialize()`.
-          by_expr = predicate{field_extractor{*st.by}, equal, materialize(ci)};
-        }
-        auto build_conjunction
-          = [](std::optional<expression>&& lhs,
-               std::optional<expression>&& rhs) -> std::optional<expression> {
-          if (lhs && rhs)
-            return conjunction{std::move(*lhs), std::move(*rhs)};
-          if (lhs)
-            return std::move(lhs);
-          if (rhs)
-            return std::move(rhs);
-          return std::nullopt;
-        };
-        auto temporal_expr
-          = build_conjunction(std::move(before_expr), std::move(after_expr));
-        auto spatial_expr = std::move(by_expr);
-        auto expr = build_conjunction(std::move(temporal_expr),
-                                      std::move(spatial_expr));
-        // We should have checked during argument parsing that `expr` has at
-        // least one constraint.
-        VAST_ASSERT(expr);
-        auto query = to_string(*expr);
-        VAST_TRACE(self, "spawns new exporter with query", query);
-        auto exporter_invocation = invocation{{}, "spawn exporter", {query}};
-        if (st.limits.per_result)
-          caf::put(exporter_invocation.options, "vast.export.max-events",
-                   st.limits.per_result);
-        ++self->state.running_exporters;
-        self->request(st.node, caf::infinite, exporter_invocation)
-          .then(
-            [=](caf::actor handle) {
-              auto exporter = caf::actor_cast<exporter_actor>(handle);
-              VAST_DEBUG(self, "registers exporter", exporter);
-              self->monitor(exporter);
-              self->send(exporter, atom::sink_v, self);
-              self->send(exporter, atom::run_v);
-            },
-            [=](caf::error error) {
-              VAST_ERROR(self, "failed to spawn exporter:", render(error));
-              --self->state.running_exporters;
-            });
-      }
+      auto& [expr, num_results] = *query;
+      st.pending_queries.emplace_back(std::move(expr),
+                                      st.limits.per_result * num_results);
+      st.spawn_exporters();
     },
     [=](atom::provision, caf::actor exporter) {
       self->state.initial_exporter = exporter.address();
@@ -228,7 +267,7 @@ explorer(caf::stateful_actor<explorer_state>* self, caf::actor node,
     [=]([[maybe_unused]] std::string name, query_status) {
       VAST_DEBUG(self, "received final status from", name);
       self->state.initial_query_completed = true;
-      quit_if_done();
+      self->state.quit_if_done();
     },
     [=](atom::sink, const caf::actor& sink) {
       VAST_DEBUG(self, "registers sink", sink);
@@ -145,10 +145,31 @@ void request_more_hits(exporter_actor::stateful_pointer<exporter_state> self) {
   self->send(st.index, st.id, detail::narrow<uint32_t>(n));
 }
 
+/// @returns the columns of *layout* that the query projects onto, or `nullptr`
+/// if the query includes all columns.
+const std::vector<size_t>*
+projection(exporter_actor::stateful_pointer<exporter_state> self,
+           const record_type& layout) {
+  auto& st = self->state;
+  if (st.fields.empty())
+    return nullptr;
+  auto t = type{layout};
+  auto it = st.projections.find(t);
+  if (it == st.projections.end())
+    std::tie(it, std::ignore)
+      = st.projections.emplace(std::move(t),
+                               resolve_columns(layout, st.fields));
+  return &it->second;
+}
+
 void handle_batch(exporter_actor::stateful_pointer<exporter_state> self,
                   table_slice slice) {
   VAST_ASSERT(slice.encoding() != table_slice_encoding::none);
   VAST_DEBUG(self, "got batch of", slice.rows(), "events");
+  // Events without any of the requested fields are not part of the result.
+  auto columns = projection(self, slice.layout());
+  if (columns && columns->empty())
+    return;
   // Construct a candidate checker if we don't have one for this type.
   type t = slice.layout();
   auto it = self->state.checkers.find(t);
@@ -174,6 +195,10 @@ void handle_batch(exporter_actor::stateful_pointer<exporter_state> self,
     return;
   }
   self->state.query.cached += selection_size;
+  // Trim the slice to the requested fields after the candidate check, which
+  // may require additional columns.
+  if (columns)
+    slice = project(slice, *columns);
   select(self->state.results, slice, selection);
   // Ship slices to connected SINKs.
   ship_results(self);
@@ -183,9 +208,10 @@ void handle_batch(exporter_actor::stateful_pointer<exporter_state> self,
 
 exporter_actor::behavior_type
 exporter(exporter_actor::stateful_pointer<exporter_state> self, expression expr,
-         query_options options) {
+         query_options options, std::vector<std::string> fields) {
   self->state.options = options;
   self->state.expr = std::move(expr);
+  self->state.fields = std::move(fields);
   if (has_continuous_option(options))
     VAST_DEBUG(self, "has continuous query option");
   self->set_exit_handler([=](const caf::exit_msg& msg) {
@@ -350,10 +376,17 @@ exporter(exporter_actor::stateful_pointer<exporter_state> self, expression expr,
       self->state.archive = std::move(archive);
       if (has_continuous_option(self->state.options))
         self->monitor(self->state.archive);
-      // Register self at the archive
-      if (has_historical_option(self->state.options))
-        self->send(self->state.archive, atom::exporter_v,
-                   caf::actor_cast<caf::actor>(self));
+      // Register self at the archive, which trims the table slices to the
+      // requested fields before sending them.
+      if (has_historical_option(self->state.options)) {
+        if (self->state.fields.empty())
+          self->send(self->state.archive, atom::exporter_v,
+                     caf::actor_cast<caf::actor>(self));
+        else
+          self->send(self->state.archive, atom::exporter_v,
+                     caf::actor_cast<caf::actor>(self), self->state.fields,
+                     self->state.expr);
+      }
     },
     [=](index_actor index) {
       VAST_DEBUG(self, "registers index", index);
@@ -45,6 +45,7 @@
 #include "vast/system/filesystem_actor.hpp"
 #include "vast/system/partition.hpp"
 #include "vast/system/query_supervisor.hpp"
+#include "vast/system/report.hpp"
 #include "vast/system/shutdown.hpp"
 #include "vast/table_slice.hpp"
 #include "vast/value_index.hpp"
@@ -104,6 +105,11 @@ using namespace std::chrono;
 
 namespace vast::system {
 
+bool layout_selector::operator()(const std::string& filter,
+                                 const table_slice& x) const {
+  return filter.empty() || filter == x.layout().name();
+}
+
 vast::path index_state::partition_path(const uuid& id) const {
   return dir / to_string(id);
 }
@@ -115,7 +121,8 @@ partition_actor partition_factory::operator()(const uuid& id) const {
               != state_.persisted_partitions.end());
   auto path = state_.partition_path(id);
   VAST_DEBUG(state_.self, "loads partition", id, "for path", path);
-  return state_.self->spawn(passive_partition, id, filesystem_, path);
+  return state_.self->spawn(passive_partition, id, filesystem_, path,
+                            state_.cache);
 }
 
 filesystem_actor& partition_factory::filesystem() {
@@ -226,6 +233,25 @@ void index_state::notify_flush_listeners() {
   flush_listeners.clear();
 }
 
+void index_state::send_report() {
+  if (!cache || !accountant)
+    return;
+  auto current = cache->stats();
+  auto hits = current.hits - reported_cache_stats.hits;
+  auto misses = current.misses - reported_cache_stats.misses;
+  if (hits + misses == 0)
+    return;
+  reported_cache_stats = current;
+  auto hit_rate = static_cast<double>(hits) / (hits + misses);
+  auto r = report{
+    {"index.predicate-cache.hits", hits},
+    {"index.predicate-cache.misses", misses},
+    {"index.predicate-cache.hit-rate", hit_rate},
+    {"index.predicate-cache.bytes", uint64_t{cache->size_bytes()}},
+  };
+  self->send(accountant, std::move(r));
+}
+
 caf::dictionary<caf::config_value>
 index_state::status(status_verbosity v) const {
   using caf::put;
@@ -248,12 +274,24 @@ index_state::status(status_verbosity v) const {
       layout_object.insert_or_assign(name, std::move(xs));
     }
     put(stats_object, "meta-index-bytes", meta_idx.size_bytes());
+    if (cache) {
+      auto cache_stats = cache->stats();
+      auto& cache_object = put_dictionary(stats_object, "predicate-cache");
+      put(cache_object, "entries", cache->size());
+      put(cache_object, "bytes", cache->size_bytes());
+      put(cache_object, "capacity", cache->capacity());
+      put(cache_object, "hits", cache_stats.hits);
+      put(cache_object, "misses", cache_stats.misses);
+      put(cache_object, "evictions", cache_stats.evictions);
+    }
   }
   if (v >= status_verbosity::debug) {
     // Resident partitions.
     auto& partitions = put_dictionary(index_status, "partitions");
-    if (active_partition.actor != nullptr)
-      partitions.emplace("active", to_string(active_partition.id));
+    auto& active = put_list(partitions, "active");
+    for ([[maybe_unused]] auto& [_, info] : active_partitions)
+      if (info.actor != nullptr)
+        active.emplace_back(to_string(info.id));
     auto& cached = put_list(partitions, "cached");
     for (auto& kv : inmem_partitions)
       cached.emplace_back(to_string(kv.first));
@@ -273,24 +311,27 @@ index_state::collect_query_actors(query_state& lookup,
   std::vector<std::pair<uuid, partition_actor>> result;
   if (num_partitions == 0 || lookup.partitions.empty())
     return result;
+  auto find_active = [&](const uuid& candidate) -> partition_actor {
+    for ([[maybe_unused]] auto& [_, info] : active_partitions)
+      if (info.actor != nullptr && info.id == candidate)
+        return info.actor;
+    return {};
+  };
   // Prefer partitions that are already available in RAM.
   auto partition_is_loaded = [&](const uuid& candidate) {
-    return (active_partition.actor != nullptr
-            && active_partition.id == candidate)
-           || unpersisted.count(candidate)
+    return find_active(candidate) || unpersisted.count(candidate)
            || inmem_partitions.contains(candidate);
   };
   std::partition(lookup.partitions.begin(), lookup.partitions.end(),
                  partition_is_loaded);
   // Helper function to spin up EVALUATOR actors for a single partition.
   auto spin_up = [&](const uuid& partition_id) -> partition_actor {
-    // We need to first check whether the ID is the active partition or one
+    // We need to first check whether the ID is an active partition or one
     // of our unpersisted ones. Only then can we dispatch to our LRU cache.
-    partition_actor part;
-    if (active_partition.actor != nullptr
-        && active_partition.id == partition_id)
-      part = active_partition.actor;
-    else if (auto it = unpersisted.find(partition_id); it != unpersisted.end())
+    auto part = find_active(partition_id);
+    if (part)
+      return part;
+    if (auto it = unpersisted.find(partition_id); it != unpersisted.end())
       part = it->second;
     else if (auto it = persisted_partitions.find(partition_id);
              it != persisted_partitions.end())
@@ -387,10 +428,13 @@ index_actor::behavior_type
 index(index_actor::stateful_pointer<index_state> self,
       filesystem_actor filesystem, path dir, size_t partition_capacity,
       size_t max_inmem_partitions, size_t taste_partitions, size_t num_workers,
-      double meta_index_fp_rate) {
+      double meta_index_fp_rate, size_t predicate_cache_size,
+      bool partition_per_layout, duration active_partition_timeout) {
   VAST_TRACE(VAST_ARG(filesystem), VAST_ARG(dir), VAST_ARG(partition_capacity),
              VAST_ARG(max_inmem_partitions), VAST_ARG(taste_partitions),
-             VAST_ARG(num_workers));
+             VAST_ARG(num_workers), VAST_ARG(predicate_cache_size),
+             VAST_ARG(partition_per_layout),
+             VAST_ARG(active_partition_timeout));
   VAST_VERBOSE(self, "initializes index in", dir,
                "with a maximum partition size of", partition_capacity,
                "events and", max_inmem_partitions, "resident partitions");
@@ -399,9 +443,12 @@ index(index_actor::stateful_pointer<index_state> self,
   self->state.filesystem = std::move(filesystem);
   self->state.dir = dir;
   self->state.partition_capacity = partition_capacity;
+  self->state.partition_per_layout = partition_per_layout;
   self->state.taste_partitions = taste_partitions;
   self->state.inmem_partitions.factory().filesystem() = self->state.filesystem;
   self->state.inmem_partitions.resize(max_inmem_partitions);
+  if (predicate_cache_size > 0)
+    self->state.cache = std::make_shared<predicate_cache>(predicate_cache_size);
   // Read persistent state.
   if (auto err = self->state.load_from_disk()) {
     VAST_ERROR(self, "failed to load index state from disk:", render(err));
@@ -413,22 +460,25 @@ index(index_actor::stateful_pointer<index_state> self,
   put(meta_index_options, "max-partition-size", partition_capacity);
   put(meta_index_options, "address-synopsis-fp-rate", meta_index_fp_rate);
   put(meta_index_options, "string-synopsis-fp-rate", meta_index_fp_rate);
-  // Creates a new active partition and updates index state.
-  auto create_active_partition = [=] {
+  // Creates a new active partition for the layouts that match `key` and
+  // updates index state.
+  auto create_active_partition = [=](const std::string& key) {
     auto id = uuid::random();
     caf::settings index_opts;
     index_opts["cardinality"] = partition_capacity;
     auto part = self->spawn(active_partition, id, self->state.filesystem,
                             index_opts, self->state.meta_idx.factory_options());
     auto slot = self->state.stage->add_outbound_path(part);
-    self->state.active_partition.actor = part;
-    self->state.active_partition.stream_slot = slot;
-    self->state.active_partition.capacity = partition_capacity;
-    self->state.active_partition.id = id;
+    self->state.stage->out().set_filter(slot, key);
+    auto& active = self->state.active_partitions[key];
+    active.actor = part;
+    active.stream_slot = slot;
+    active.capacity = partition_capacity;
+    active.id = id;
     VAST_DEBUG(self, "created new partition", id);
   };
-  auto decomission_active_partition = [=] {
-    auto& active = self->state.active_partition;
+  auto decomission_active_partition = [=](const std::string& key) {
+    auto& active = self->state.active_partitions[key];
     auto id = active.id;
     auto actor = std::exchange(active.actor, {});
     self->state.unpersisted[id] = actor;
@@ -461,17 +511,20 @@ index(index_actor::stateful_pointer<index_state> self,
       VAST_ASSERT(x.encoding() != table_slice_encoding::none);
       auto&& layout = x.layout();
       self->state.stats.layouts[layout.name()].count += x.rows();
-      auto& active = self->state.active_partition;
+      auto key = self->state.partition_per_layout ? layout.name()
+                                                  : std::string{};
+      auto& active = self->state.active_partitions[key];
       if (!active.actor) {
-        create_active_partition();
+        create_active_partition(key);
       } else if (x.rows() > active.capacity) {
         VAST_DEBUG(self, "exceeds active capacity by",
                    (x.rows() - active.capacity), "rows");
-        decomission_active_partition();
+        decomission_active_partition(key);
         self->state.flush_to_disk();
-        create_active_partition();
+        create_active_partition(key);
       }
       out.push(x);
+      active.last_write = self->clock().now();
       self->state.meta_idx.add(active.id, x);
       if (active.capacity == self->state.partition_capacity
           && x.rows() > active.capacity) {
@@ -498,7 +551,8 @@ index(index_actor::stateful_pointer<index_state> self,
         self->send_exit(self, err);
       }
       VAST_DEBUG_ANON("index finalized streaming");
-    });
+    },
+    caf::policy::arg<index_state::index_downstream_manager>{});
   self->set_exit_handler([=](const caf::exit_msg& msg) {
     VAST_DEBUG(self, "received EXIT from", msg.source,
                "with reason:", msg.reason);
@@ -507,9 +561,10 @@ index(index_actor::stateful_pointer<index_state> self,
     self->state.stage->out().force_emit_batches();
     self->state.stage->out().close();
     self->state.stage->shutdown();
-    // Bring down active partition.
-    if (self->state.active_partition.actor)
-      decomission_active_partition();
+    // Bring down active partitions.
+    for (auto& [key, active] : self->state.active_partitions)
+      if (active.actor)
+        decomission_active_partition(key);
     // Collect partitions for termination.
     // TODO: We must actor_cast to caf::actor here because 'shutdown' operates
     // on 'std::vector<caf::actor>' only. That should probably be generalized in
@@ -532,6 +587,10 @@ index(index_actor::stateful_pointer<index_state> self,
   // Launch workers for resolving queries.
   for (size_t i = 0; i < num_workers; ++i)
     self->spawn(query_supervisor, self);
+  // Periodically persist active partitions that stopped receiving events, so
+  // that rare layouts don't keep partially filled partitions in memory.
+  if (active_partition_timeout > duration::zero())
+    self->delayed_send(self, active_partition_timeout, atom::ping_v);
   return {
     [=](atom::worker, query_supervisor_actor worker) {
       if (!self->state.worker_available())
@@ -547,6 +606,30 @@ index(index_actor::stateful_pointer<index_state> self,
     },
     [=](accountant_actor accountant) {
       self->state.accountant = std::move(accountant);
+      if (self->state.cache)
+        self->delayed_send(self, defaults::system::telemetry_rate,
+                           atom::telemetry_v);
+    },
+    [=](atom::telemetry) {
+      self->state.send_report();
+      self->delayed_send(self, defaults::system::telemetry_rate,
+                         atom::telemetry_v);
+    },
+    [=](atom::ping) {
+      auto now = self->clock().now();
+      std::vector<std::string> idle;
+      for (auto& [key, active] : self->state.active_partitions)
+        if (active.actor && now - active.last_write >= active_partition_timeout)
+          idle.push_back(key);
+      for (auto& key : idle) {
+        VAST_DEBUG(self, "persists idle active partition",
+                   self->state.active_partitions[key].id);
+        decomission_active_partition(key);
+        self->state.active_partitions.erase(key);
+      }
+      if (!idle.empty())
+        self->state.flush_to_disk();
+      self->delayed_send(self, active_partition_timeout, atom::ping_v);
     },
     [=](atom::status, status_verbosity v) -> caf::config_value::dictionary {
       return self->state.status(v);
@@ -684,6 +767,8 @@ index(index_actor::stateful_pointer<index_state> self,
       }
       self->state.inmem_partitions.drop(partition_id);
       self->state.persisted_partitions.erase(partition_id);
+      if (self->state.cache)
+        self->state.cache->erase(partition_id);
       self->request(self->state.filesystem, caf::infinite, atom::mmap_v, path)
         .then(
           [=](chunk_ptr chunk) mutable {
@@ -721,6 +806,11 @@ index(index_actor::stateful_pointer<index_state> self,
           [=](caf::error e) mutable { rp.deliver(e); });
       return rp;
     },
+    [=](atom::estimate,
+        const expression& expr) -> caf::result<uint64_t, uint64_t> {
+      auto [lower, upper] = self->state.meta_idx.estimate(expr);
+      return {lower, upper};
+    },
   };
 }
 
@@ -129,27 +129,4 @@ active_indexer(active_indexer_actor::stateful_pointer<indexer_state> self,
   };
 }
 
-indexer_actor::behavior_type
-passive_indexer(indexer_actor::stateful_pointer<indexer_state> self,
-                uuid partition_id, value_index_ptr idx) {
-  if (!idx) {
-    VAST_ERROR(self, "got invalid value index pointer");
-    self->quit(make_error(ec::end_of_input, "invalid value index pointer"));
-    return indexer_actor::behavior_type::make_empty_behavior();
-  }
-  self->state.name = "indexer-" + to_string(idx->type());
-  self->state.partition_id = partition_id;
-  self->state.idx = std::move(idx);
-  return {
-    [=](const curried_predicate& pred) {
-      VAST_DEBUG(self, "got predicate:", pred);
-      VAST_ASSERT(self->state.idx);
-      auto& idx = *self->state.idx;
-      auto rep = to_internal(idx.type(), make_view(pred.rhs));
-      return idx.lookup(pred.op, rep);
-    },
-    [=](atom::shutdown) { self->quit(caf::exit_reason::user_shutdown); },
-  };
-}
-
 } // namespace vast::system
@@ -38,8 +38,8 @@
 #include "vast/json.hpp"
 #include "vast/logger.hpp"
 #include "vast/system/accountant.hpp"
+#include "vast/system/async_filesystem.hpp"
 #include "vast/system/node.hpp"
-#include "vast/system/posix_filesystem.hpp"
 #include "vast/system/shutdown.hpp"
 #include "vast/system/spawn_archive.hpp"
 #include "vast/system/spawn_arguments.hpp"
@@ -518,7 +518,8 @@ node_state::spawn_command(const invocation& inv,
 }
 
 caf::behavior node(node_actor* self, std::string name, path dir,
-                   std::chrono::milliseconds shutdown_grace_period) {
+                   std::chrono::milliseconds shutdown_grace_period,
+                   async_filesystem_config filesystem_config) {
   self->state.name = std::move(name);
   self->state.dir = std::move(dir);
   // Initialize component and command factories.
@@ -539,7 +540,8 @@ caf::behavior node(node_actor* self, std::string name, path dir,
     node_state::command_factory = std::move(extra);
   }
   // Initialize the file system with the node directory as root.
-  auto fs = self->spawn<linked + detached>(posix_filesystem, self->state.dir);
+  auto fs = self->spawn<linked + detached>(async_filesystem, self->state.dir,
+                                          filesystem_config);
   self->state.registry.add(caf::actor_cast<caf::actor>(fs), "filesystem");
   // Remove monitored components.
   self->set_down_handler([=](const down_msg& msg) {
@@ -17,6 +17,7 @@
 
 #include "vast/address_synopsis.hpp"
 #include "vast/aliases.hpp"
+#include "vast/bitmap_algorithms.hpp"
 #include "vast/chunk.hpp"
 #include "vast/concept/hashable/xxhash.hpp"
 #include "vast/concept/printable/to_string.hpp"
@@ -38,12 +39,13 @@
 #include "vast/system/index_actor.hpp"
 #include "vast/system/indexer.hpp"
 #include "vast/system/shutdown.hpp"
-#include "vast/system/terminate.hpp"
 #include "vast/table_slice.hpp"
 #include "vast/table_slice_column.hpp"
 #include "vast/time.hpp"
 #include "vast/type.hpp"
 #include "vast/value_index.hpp"
+#include "vast/view.hpp"
+#include "vast/zone_map.hpp"
 
 #include <caf/attach_continuous_stream_stage.hpp>
 #include <caf/broadcast_downstream_manager.hpp>
@@ -54,7 +56,9 @@
 #include <flatbuffers/base.h> // FLATBUFFERS_MAX_BUFFER_SIZE
 #include <flatbuffers/flatbuffers.h>
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 using namespace std::chrono;
 using namespace caf;
@@ -69,38 +73,50 @@ active_indexer_actor active_partition_state::indexer_at(size_t position) const {
   return as_vector(indexers)[position].second;
 }
 
-/// Gets the INDEXER at a certain position.
-indexer_actor passive_partition_state::indexer_at(size_t position) const {
-  VAST_ASSERT(position < indexers.size());
-  auto& indexer = indexers[position];
-  // Deserialize the value index and spawn a passive_indexer lazily when it is
-  // requested for the first time.
-  if (!indexer) {
+/// Gets the value index at a certain position.
+const value_index* passive_partition_state::index_at(size_t position) const {
+  VAST_ASSERT(position < indexes.size());
+  auto& index = indexes[position];
+  // Deserialize the value index lazily when it is requested for the first
+  // time.
+  if (!index) {
     auto qualified_index = flatbuffer->indexes()->Get(position);
-    auto index = qualified_index->index();
-    auto data = index->data();
-    value_index_ptr state_ptr;
-    if (auto error = fbs::deserialize_bytes(data, state_ptr)) {
-      VAST_ERROR(self, "failed to deserialize indexer at", position,
+    auto data = qualified_index->index()->data();
+    if (auto error = fbs::deserialize_bytes(data, index)) {
+      VAST_ERROR(self, "failed to deserialize value index at", position,
                  "with error:", render(error));
-      return {};
+      index = nullptr;
     }
-    indexer = self->spawn(passive_indexer, id, std::move(state_ptr));
   }
-  return indexer;
+  return index.get();
 }
 
 namespace {
 
-// The functions in this namespace take PartitionState as template argument
-// because the impelementation is the same for passive and active partitions.
+// The functions in this namespace that take PartitionState as template
+// argument are the same for passive and active partitions. Only active
+// partitions delegate the evaluation to INDEXER actors.
+
+/// Lifts a precomputed result into an actor for the EVALUATOR.
+/// @relates active_partition_state
+indexer_actor
+make_one_shot_indexer(const active_partition_state& state, ids row_ids) {
+  // TODO: Spawning a one-shot actor is quite expensive. Maybe the
+  //       partition could instead maintain this actor lazily.
+  return state.self->spawn([row_ids]() -> indexer_actor::behavior_type {
+    return {
+      [=](const curried_predicate&) { return row_ids; },
+      [](atom::shutdown) {
+        VAST_DEBUG_ANON("one-shot indexer received shutdown request");
+      },
+    };
+  });
+}
 
 /// Gets the INDEXER at position in the layout.
 /// @relates active_partition_state
-/// @relates passive_partition_state
-template <typename PartitionState>
 indexer_actor
-fetch_indexer(const PartitionState& state, const data_extractor& dx,
+fetch_indexer(const active_partition_state& state, const data_extractor& dx,
               relational_operator op, const data& x) {
   VAST_TRACE(VAST_ARG(dx), VAST_ARG(op), VAST_ARG(x));
   // Sanity check.
@@ -113,22 +129,22 @@ fetch_indexer(const PartitionState& state, const data_extractor& dx,
   return {};
 }
 
-/// Retrieves an INDEXER for a predicate with a data extractor.
-/// @param dx The extractor.
-/// @param op The operator (only used to precompute ids for type queries.
+/// Computes the result of a predicate with an attribute extractor, which
+/// does not require a value index.
+/// @param ex The extractor.
+/// @param op The operator.
 /// @param x The literal side of the predicate.
+/// @returns The matching IDs, or `caf::none` if the predicate is unsupported.
 /// @relates active_partition_state
 /// @relates passive_partition_state
 template <typename PartitionState>
-indexer_actor
-fetch_indexer(const PartitionState& state, const attribute_extractor& ex,
-              relational_operator op, const data& x) {
+caf::optional<ids>
+lookup_attribute(const PartitionState& state, const attribute_extractor& ex,
+                 relational_operator op, const data& x) {
   VAST_TRACE(VAST_ARG(ex), VAST_ARG(op), VAST_ARG(x));
   ids row_ids;
   if (ex.attr == atom::type_v) {
     // We know the answer immediately: all IDs that are part of the table.
-    // However, we still have to "lift" this result into an actor for the
-    // EVALUATOR.
     for (auto& [name, ids] : state.type_ids)
       if (evaluate(name, op, x))
         row_ids |= ids;
@@ -137,7 +153,7 @@ fetch_indexer(const PartitionState& state, const attribute_extractor& ex,
     if (!s) {
       VAST_WARNING(state.self, "#field meta queries only support string "
                                "comparisons");
-      return {};
+      return caf::none;
     }
     auto neg = is_negated(op);
     for (const auto& field : record_type::each{state.combined_layout}) {
@@ -161,26 +177,41 @@ fetch_indexer(const PartitionState& state, const attribute_extractor& ex,
     }
   } else {
     VAST_WARNING(state.self, "got unsupported attribute:", ex.attr);
-    return {};
+    return caf::none;
   }
-  // TODO: Spawning a one-shot actor is quite expensive. Maybe the
-  //       partition could instead maintain this actor lazily.
-  return state.self->spawn([row_ids]() -> indexer_actor::behavior_type {
-    return {
-      [=](const curried_predicate&) { return row_ids; },
-      [](atom::shutdown) {
-        VAST_DEBUG_ANON("one-shot indexer received shutdown request");
-      },
-    };
-  });
+  return row_ids;
+}
+
+/// Retrieves an INDEXER for a predicate with an attribute extractor.
+/// @param ex The extractor.
+/// @param op The operator (only used to precompute ids for type queries.
+/// @param x The literal side of the predicate.
+/// @relates active_partition_state
+indexer_actor
+fetch_indexer(const active_partition_state& state,
+              const attribute_extractor& ex, relational_operator op,
+              const data& x) {
+  // We know the answer immediately, but we still have to "lift" the result
+  // into an actor for the EVALUATOR.
+  if (auto row_ids = lookup_attribute(state, ex, op, x))
+    return make_one_shot_indexer(state, std::move(*row_ids));
+  return {};
+}
+
+/// Estimates for every operand of a conjunction how many rows may satisfy it
+/// according to a zone map.
+std::vector<uint64_t> estimate(const zone_map& zones, const conjunction& xs) {
+  std::vector<uint64_t> result;
+  result.reserve(xs.size());
+  for (auto& x : xs)
+    result.push_back(rank(zones.lookup(x)));
+  return result;
 }
 
 /// Returns all INDEXERs that are involved in evaluating the expression.
 /// @relates active_partition_state
-/// @relates passive_partition_state
-template <typename PartitionState>
 std::vector<evaluation_triple>
-evaluate(const PartitionState& state, const expression& expr) {
+evaluate(const active_partition_state& state, const expression& expr) {
   std::vector<evaluation_triple> result;
   // Pretend the partition is a table, and return fitted predicates for the
   // partitions layout.
@@ -208,10 +239,156 @@ evaluate(const PartitionState& state, const expression& expr) {
     if (auto hdl = caf::visit(v, pred.lhs, pred.rhs))
       result.emplace_back(kvp.first, curried(pred), std::move(hdl));
   }
+  // The EVALUATOR dispatches the conjuncts of a top-level conjunction one
+  // after another, in the order of their first job. We put the conjuncts
+  // that the fewest rows may satisfy according to the zone map first, so that
+  // an empty intersection stops the evaluation as early as possible.
+  auto conj = caf::get_if<conjunction>(&expr);
+  if (conj != nullptr && !state.zones.empty()) {
+    auto estimates = estimate(state.zones, *conj);
+    auto conjunct_estimate = [&](const evaluation_triple& x) {
+      auto& position = std::get<0>(x);
+      VAST_ASSERT(position.size() > 1);
+      return estimates[position[1]];
+    };
+    std::stable_sort(result.begin(), result.end(),
+                     [&](const evaluation_triple& x,
+                         const evaluation_triple& y) {
+                       return conjunct_estimate(x) < conjunct_estimate(y);
+                     });
+  }
   // Return the list of jobs, to be used by the EVALUATOR.
   return result;
 }
 
+/// Evaluates an expression directly on the value indexes of a passive
+/// partition. Conjunctions evaluate their operands in the order of their
+/// estimated selectivity and stop at the first empty intersection.
+/// @relates passive_partition_state
+class passive_evaluator {
+public:
+  passive_evaluator(const passive_partition_state& state,
+                    const expression& expr)
+    : state_{state}, resolved_{resolve(expr, state.combined_layout)} {
+    // The fitted predicates are in depth-first order and therefore sorted by
+    // their position.
+    position_.emplace_back(0);
+  }
+
+  ids operator()(caf::none_t) {
+    return {};
+  }
+
+  ids operator()(const conjunction& xs) {
+    VAST_ASSERT(!xs.empty());
+    std::vector<size_t> order(xs.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    if (!state_.zones.empty()) {
+      auto estimates = estimate(state_.zones, xs);
+      std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+        return estimates[i] < estimates[j];
+      });
+    }
+    auto result = at(order[0], xs[order[0]]);
+    for (size_t i = 1; i < order.size() && any<1>(result); ++i)
+      result &= at(order[i], xs[order[i]]);
+    return result;
+  }
+
+  ids operator()(const disjunction& xs) {
+    VAST_ASSERT(!xs.empty());
+    auto result = at(0, xs[0]);
+    for (size_t i = 1; i < xs.size(); ++i)
+      result |= at(i, xs[i]);
+    return result;
+  }
+
+  ids operator()(const negation& x) {
+    auto result = at(0, x.expr());
+    result.flip();
+    return result;
+  }
+
+  ids operator()(const predicate&) {
+    // A predicate may resolve to multiple fitted predicates, e.g., one per
+    // matching field, which share its position.
+    auto [first, last] = std::equal_range(
+      resolved_.begin(), resolved_.end(), position_,
+      detail::overload{
+        [](const std::pair<offset, predicate>& x, const offset& y) {
+          return x.first < y;
+        },
+        [](const offset& x, const std::pair<offset, predicate>& y) {
+          return x < y.first;
+        },
+      });
+    ids result;
+    for (auto i = first; i != last; ++i)
+      if (auto hits = lookup(i->second))
+        result |= *hits;
+    return result;
+  }
+
+private:
+  ids at(size_t i, const expression& x) {
+    position_.emplace_back(i);
+    auto result = caf::visit(*this, x);
+    position_.pop_back();
+    return result;
+  }
+
+  caf::optional<ids> lookup(const predicate& pred) {
+    auto v = detail::overload{
+      [&](const attribute_extractor& ex, const data& x) {
+        return lookup_attribute(state_, ex, pred.op, x);
+      },
+      [&](const data_extractor& dx, const data& x) {
+        return lookup_index(dx, pred.op, x);
+      },
+      [](const auto&, const auto&) {
+        return caf::optional<ids>{}; // clang-format fix
+      },
+    };
+    return caf::visit(v, pred.lhs, pred.rhs);
+  }
+
+  caf::optional<ids>
+  lookup_index(const data_extractor& dx, relational_operator op,
+               const data& x) {
+    VAST_TRACE(VAST_ARG(dx), VAST_ARG(op), VAST_ARG(x));
+    // Sanity check.
+    if (dx.offset.empty())
+      return caf::none;
+    auto column = state_.combined_layout.flat_index_at(dx.offset);
+    if (!column) {
+      VAST_WARNING(state_.self, "got invalid offset for the combined layout",
+                   state_.combined_layout);
+      return caf::none;
+    }
+    // Passive partitions are immutable, so a previous result for the same
+    // predicate is still valid.
+    if (state_.cache)
+      if (auto result = state_.cache->lookup({state_.id, *column, op, x}))
+        return std::move(*result);
+    auto idx = state_.index_at(*column);
+    if (!idx)
+      return caf::none;
+    auto result = idx->lookup(op, to_internal(idx->type(), make_view(x)));
+    if (!result) {
+      VAST_WARNING(state_.self, "failed to evaluate predicate:",
+                   render(result.error()));
+      return caf::none;
+    }
+    if (state_.cache)
+      state_.cache->insert({state_.id, *column, op, x}, *result);
+    return std::move(*result);
+  }
+
+  const passive_partition_state& state_;
+  std::vector<std::pair<offset, predicate>> resolved_;
+  offset position_;
+};
+
 } // namespace
 
 bool partition_selector::operator()(const qualified_record_field& filter,
@@ -228,26 +405,41 @@ bool partition_selector::operator()(const qualified_record_field& filter,
   return filter.type == field.type;
 }
 
+namespace {
+
+// Collects the serialized indexers in the order of the indexers.
+caf::expected<std::vector<chunk_ptr>>
+indexer_chunks(const active_partition_state& x) {
+  std::vector<chunk_ptr> result;
+  result.reserve(x.indexers.size());
+  for (auto& [qf, actor] : x.indexers) {
+    auto actor_id = actor.id();
+    auto chunk_it = x.chunks.find(actor_id);
+    if (chunk_it == x.chunks.end())
+      return make_error(ec::logic_error,
+                        "no chunk for for actor id " + to_string(actor_id));
+    result.push_back(chunk_it->second);
+  }
+  return result;
+}
+
+// Packs the partition with the given vectors as data of the value indexes.
 caf::expected<flatbuffers::Offset<fbs::Partition>>
-pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x) {
+pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x,
+     const std::vector<flatbuffers::Offset<flatbuffers::Vector<uint8_t>>>&
+       index_data) {
+  VAST_ASSERT(index_data.size() == x.indexers.size());
   auto uuid = pack(builder, x.id);
   if (!uuid)
     return uuid.error();
   std::vector<flatbuffers::Offset<fbs::qualified_value_index::v0>> indices;
   // Note that the deserialization code relies on the order of indexers within
   // the flatbuffers being preserved.
+  auto data = index_data.begin();
   for (auto& [qf, actor] : x.indexers) {
-    auto actor_id = actor.id();
-    auto chunk_it = x.chunks.find(actor_id);
-    if (chunk_it == x.chunks.end())
-      return make_error(ec::logic_error,
-                        "no chunk for for actor id " + to_string(actor_id));
-    auto& chunk = chunk_it->second;
-    auto data = builder.CreateVector(
-      reinterpret_cast<const uint8_t*>(chunk->data()), chunk->size());
     auto fqf = builder.CreateString(qf.field_name);
     fbs::value_index::v0Builder vbuilder(builder);
-    vbuilder.add_data(data);
+    vbuilder.add_data(*data++);
     auto vindex = vbuilder.Finish();
     fbs::qualified_value_index::v0Builder qbuilder(builder);
     qbuilder.add_qualified_field_name(fqf);
@@ -276,6 +468,9 @@ pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x) {
   auto maybe_ps = pack(builder, *x.synopsis);
   if (!maybe_ps)
     return maybe_ps.error();
+  auto zone_map = fbs::serialize_bytes(builder, x.zones);
+  if (!zone_map)
+    return zone_map.error();
   fbs::partition::v0Builder v0_builder(builder);
   v0_builder.add_uuid(*uuid);
   v0_builder.add_offset(x.offset);
@@ -284,6 +479,7 @@ pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x) {
   v0_builder.add_partition_synopsis(*maybe_ps);
   v0_builder.add_combined_layout(*combined_layout);
   v0_builder.add_type_ids(type_ids);
+  v0_builder.add_zone_map(*zone_map);
   auto partition_v0 = v0_builder.Finish();
   fbs::PartitionBuilder partition_builder(builder);
   partition_builder.add_partition_type(fbs::partition::Partition::v0);
@@ -293,6 +489,77 @@ pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x) {
   return partition;
 }
 
+} // namespace
+
+caf::expected<flatbuffers::Offset<fbs::Partition>>
+pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x) {
+  auto chunks = indexer_chunks(x);
+  if (!chunks)
+    return chunks.error();
+  std::vector<flatbuffers::Offset<flatbuffers::Vector<uint8_t>>> index_data;
+  index_data.reserve(chunks->size());
+  for (auto& chunk : *chunks)
+    index_data.push_back(builder.CreateVector(
+      reinterpret_cast<const uint8_t*>(chunk->data()), chunk->size()));
+  return pack(builder, x, index_data);
+}
+
+caf::expected<std::vector<chunk_ptr>>
+pack_chunks(const active_partition_state& x) {
+  using flatbuffers::uoffset_t;
+  auto chunks = indexer_chunks(x);
+  if (!chunks)
+    return chunks.error();
+  // Creating empty placeholder vectors first puts them contiguously at the
+  // very end of the finished buffer. We cut them off and append the
+  // serialized indexers behind the remaining buffer instead, which leaves the
+  // positions of all other objects intact.
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<flatbuffers::Offset<flatbuffers::Vector<uint8_t>>> placeholders;
+  placeholders.reserve(chunks->size());
+  for (size_t i = 0; i < chunks->size(); ++i)
+    placeholders.push_back(builder.CreateVector(std::vector<uint8_t>{}));
+  VAST_ASSERT(builder.GetSize() == chunks->size() * sizeof(uoffset_t));
+  if (auto partition = pack(builder, x, placeholders); !partition)
+    return partition.error();
+  auto buffer = builder.GetBufferPointer();
+  auto tail = builder.GetSize() - chunks->size() * sizeof(uoffset_t);
+  auto partition_v0 = fbs::GetPartition(buffer)->partition_as_v0();
+  std::vector<chunk_ptr> result;
+  result.reserve(1 + 2 * chunks->size());
+  result.push_back(nullptr); // The buffer itself, once we're done patching.
+  auto position = tail;
+  for (size_t i = 0; i < chunks->size(); ++i) {
+    auto& chunk = (*chunks)[i];
+    // The length prefix of a vector must be aligned.
+    auto padding = (sizeof(uoffset_t) - position % sizeof(uoffset_t))
+                   % sizeof(uoffset_t);
+    if (position + padding + sizeof(uoffset_t) + chunk->size()
+        > FLATBUFFERS_MAX_BUFFER_SIZE)
+      return make_error(ec::format_error, "partition exceeds the maximum "
+                                          "flatbuffer size");
+    auto header = std::vector<char>(padding + sizeof(uoffset_t), 0);
+    flatbuffers::WriteScalar(header.data() + padding,
+                             static_cast<uoffset_t>(chunk->size()));
+    // Redirect the data field of the value index from its placeholder to the
+    // appended vector. Offsets are relative to the field itself.
+    auto index = partition_v0->indexes()->Get(i)->index();
+    auto field = reinterpret_cast<const flatbuffers::Table*>(index)
+                   ->GetAddressOf(fbs::value_index::v0::VT_DATA);
+    VAST_ASSERT(field != nullptr);
+    auto field_position = static_cast<size_t>(field - buffer);
+    auto vector_position = position + padding;
+    flatbuffers::WriteScalar(buffer + field_position,
+                             static_cast<uoffset_t>(vector_position
+                                                    - field_position));
+    result.push_back(chunk::make(std::move(header)));
+    result.push_back(chunk);
+    position = vector_position + sizeof(uoffset_t) + chunk->size();
+  }
+  result[0] = fbs::release(builder)->slice(0, tail);
+  return result;
+}
+
 caf::error
 unpack(const fbs::partition::v0& partition, passive_partition_state& state) {
   // Check that all fields exist.
@@ -335,11 +602,11 @@ unpack(const fbs::partition::v0& partition, passive_partition_state& state) {
                indexes->size(), "indexes");
     return make_error(ec::format_error, "incoherent number of indexers");
   }
-  // We only create dummy entries here, since the positions of the `indexers`
-  // vector must be the same as in `combined_layout`. The actual indexers are
-  // deserialized and spawned lazily on demand.
-  state.indexers.resize(indexes->size());
-  VAST_DEBUG(state.self, "found", indexes->size(), "indexers for partition",
+  // We only create dummy entries here, since the positions of the `indexes`
+  // vector must be the same as in `combined_layout`. The actual value indexes
+  // are deserialized lazily on demand.
+  state.indexes.resize(indexes->size());
+  VAST_DEBUG(state.self, "found", indexes->size(), "indexes for partition",
              state.id);
   auto type_ids = partition.type_ids();
   for (size_t i = 0; i < type_ids->size(); ++i) {
@@ -352,6 +619,14 @@ unpack(const fbs::partition::v0& partition, passive_partition_state& state) {
   }
   VAST_DEBUG(state.self, "restored", state.type_ids.size(),
              "type-to-ids mapping for partition", state.id);
+  // Partitions written by older versions have no zone map, which only means
+  // that we cannot rule out any table slices.
+  if (auto zone_map = partition.zone_map()) {
+    if (auto error = fbs::deserialize_bytes(zone_map, state.zones))
+      return error;
+    VAST_DEBUG(state.self, "restored", state.zones.zones().size(),
+               "table slice summaries for partition", state.id);
+  }
   return caf::none;
 }
 
@@ -360,7 +635,16 @@ caf::error unpack(const fbs::partition::v0& x, partition_synopsis& ps) {
     return make_error(ec::format_error, "missing partition synopsis");
   if (!x.type_ids())
     return make_error(ec::format_error, "missing type_ids");
-  return unpack(*x.partition_synopsis(), ps);
+  if (auto error = unpack(*x.partition_synopsis(), ps))
+    return error;
+  // Restore the number of events per layout for estimating query results.
+  for (auto type_ids : *x.type_ids()) {
+    vast::ids ids;
+    if (auto error = fbs::deserialize_bytes(type_ids->ids(), ids))
+      return error;
+    ps.layout_events_[type_ids->name()->str()] = rank(ids);
+  }
+  return caf::none;
 }
 
 active_partition_actor::behavior_type active_partition(
@@ -403,6 +687,7 @@ active_partition_actor::behavior_type active_partition(
       self->state.offset = std::min(x.offset(), self->state.offset);
       self->state.events += x.rows();
       self->state.synopsis->add(x, self->state.synopsis_opts);
+      self->state.zones.add(x);
       size_t col = 0;
       VAST_ASSERT(!layout.fields.empty());
       for (auto& field : layout.fields) {
@@ -545,9 +830,10 @@ active_partition_actor::behavior_type active_partition(
               }
               // Shrink synopses for addr fields to optimal size.
               self->state.synopsis->shrink();
-              // Create the partition flatbuffer.
-              flatbuffers::FlatBufferBuilder builder;
-              auto partition = pack(builder, self->state);
+              // Create the partition flatbuffer. The serialized indexers do
+              // not get copied into the flatbuffer, but written directly
+              // after it.
+              auto partition = pack_chunks(self->state);
               if (!partition) {
                 VAST_ERROR(self, "failed to serialize", self->state.name,
                            "with error:", render(partition.error()));
@@ -555,9 +841,12 @@ active_partition_actor::behavior_type active_partition(
                 return;
               }
               VAST_ASSERT(self->state.persist_path);
-              auto fbchunk = fbs::release(builder);
+              self->state.chunks.clear();
+              auto size = size_t{0};
+              for (auto& chunk : *partition)
+                size += chunk->size();
               VAST_DEBUG(self, "persists partition with a total size of",
-                         fbchunk->size(), "bytes");
+                         size, "bytes");
               // Relinquish ownership and send the shrinked synopsis to the index.
               if (self->state.index) {
                 self->send(self->state.index, atom::replace_v, self->state.id,
@@ -566,7 +855,7 @@ active_partition_actor::behavior_type active_partition(
               }
               self->state.persistence_promise.delegate(
                 self->state.filesystem, atom::write_v,
-                *self->state.persist_path, fbchunk);
+                *self->state.persist_path, std::move(*partition));
               return;
             },
             [=](caf::error err) {
@@ -580,10 +869,17 @@ active_partition_actor::behavior_type active_partition(
     },
     [=](const expression& expr,
         partition_client_actor client) -> caf::result<atom::done> {
+      // Rule out entire table slices before asking any indexers.
+      auto candidates = ids{};
+      if (!self->state.zones.empty()) {
+        candidates = self->state.zones.lookup(expr);
+        if (!any<1>(candidates))
+          return atom::done_v;
+      }
       auto triples = evaluate(self->state, expr);
       if (triples.empty())
         return atom::done_v;
-      auto eval = self->spawn(evaluator, expr, triples);
+      auto eval = self->spawn(evaluator, expr, triples, std::move(candidates));
       return self->delegate(eval, client);
     },
   };
@@ -591,37 +887,20 @@ active_partition_actor::behavior_type active_partition(
 
 partition_actor::behavior_type passive_partition(
   partition_actor::stateful_pointer<passive_partition_state> self, uuid id,
-  filesystem_actor filesystem, class path path) {
+  filesystem_actor filesystem, class path path, predicate_cache_ptr cache) {
   self->state.self = self;
+  self->state.cache = std::move(cache);
   self->set_exit_handler([=](const caf::exit_msg& msg) {
     VAST_DEBUG(self, "received EXIT from", msg.source,
                "with reason:", msg.reason);
     // Receiving an EXIT message does not need to coincide with the state
     // being destructed, so we explicitly clear the vector to release the
-    // references.
-    // TODO: We must actor_cast to caf::actor here because 'terminate'
-    // operates on 'std::vector<caf::actor>' only. That should probably be
-    // generalized in the future.
-    auto indexers = std::vector<caf::actor>{};
-    indexers.reserve(self->state.indexers.size());
-    for (auto&& indexer : std::exchange(self->state.indexers, {}))
-      indexers.push_back(caf::actor_cast<caf::actor>(std::move(indexer)));
-    if (msg.reason != caf::exit_reason::user_shutdown) {
+    // value indexes.
+    self->state.indexes.clear();
+    if (msg.reason != caf::exit_reason::user_shutdown)
       self->quit(msg.reason);
-      return;
-    }
-    // When the shutdown was requested by the user (as opposed to the partition
-    // just dropping out of the LRU cache), pro-actively remove the indexers.
-    terminate<policy::parallel>(self, std::move(indexers))
-      .then(
-        [=](atom::done) {
-          VAST_DEBUG(self, "shut down all indexers successfully");
-          self->quit();
-        },
-        [=](const caf::error& err) {
-          VAST_ERROR(self, "failed to shut down all indexers:", render(err));
-          self->quit(err);
-        });
+    else
+      self->quit();
   });
   // We send a "read" to the fs actor and upon receiving the result deserialize
   // the flatbuffer and switch to the "normal" partition behavior for responding
@@ -698,11 +977,22 @@ partition_actor::behavior_type passive_partition(
       // We can safely assert that if we have the partition chunk already, all
       // deferred evaluations were taken care of.
       VAST_ASSERT(self->state.deferred_evaluations.empty());
-      auto triples = evaluate(self->state, expr);
-      if (triples.empty())
-        return atom::done_v;
-      auto eval = self->spawn(evaluator, expr, triples);
-      return self->delegate(eval, client);
+      // Rule out entire table slices before looking at any value indexes.
+      auto candidates = ids{};
+      if (!self->state.zones.empty()) {
+        candidates = self->state.zones.lookup(expr);
+        if (!any<1>(candidates))
+          return atom::done_v;
+      }
+      // The partition is immutable, so we can evaluate the expression in one
+      // go on the thread that runs this actor, without spawning an EVALUATOR
+      // and INDEXER actors.
+      auto hits = caf::visit(passive_evaluator{self->state, expr}, expr);
+      if (!candidates.empty())
+        hits &= candidates;
+      if (any<1>(hits))
+        self->send(client, std::move(hits));
+      return atom::done_v;
     },
   };
 }
@@ -79,6 +79,48 @@ pivoter_state::pivoter_state(caf::event_based_actor*) {
   // nop
 }
 
+void pivoter_state::flush() {
+  for (auto& [field, xs] : pending_ids) {
+    if (xs.empty())
+      continue;
+    VAST_DEBUG(self, "queries for", xs.size(), field);
+    auto expr = conjunction{
+      predicate{attribute_extractor{atom::type_v}, equal, data{target}},
+      predicate{field_extractor{field}, in, data{std::move(xs)}}};
+    // TODO(ch9411): Drop the conversion to a string when node actors can
+    //               be spawned without going through an invocation.
+    auto query = to_string(expr);
+    VAST_TRACE(self, "spawns new exporter with query", query);
+    auto exporter_options = caf::settings{};
+    caf::put(exporter_options, "vast.export.disable-taxonomies", true);
+    auto exporter_invocation
+      = invocation{std::move(exporter_options), "spawn exporter", {query}};
+    ++running_exporters;
+    self->request(node, caf::infinite, exporter_invocation)
+      .then(
+        [self = self](caf::actor handle) {
+          auto exporter = caf::actor_cast<exporter_actor>(std::move(handle));
+          VAST_DEBUG(self, "registers exporter", exporter);
+          self->monitor(exporter);
+          self->send(exporter, atom::sink_v, self->state.sink);
+          self->send(exporter, atom::run_v);
+        },
+        [self = self](caf::error error) {
+          VAST_ERROR(self, "failed to spawn exporter:", render(error));
+          auto& st = self->state;
+          if (--st.running_exporters == 0)
+            st.flush();
+          st.quit_if_done();
+        });
+  }
+  pending_ids.clear();
+}
+
+void pivoter_state::quit_if_done() {
+  if (initial_query_completed && running_exporters == 0 && pending_ids.empty())
+    self->quit();
+}
+
 caf::behavior pivoter(caf::stateful_actor<pivoter_state>* self, caf::actor node,
                       std::string target, expression expr) {
   auto& st = self->state;
@@ -86,18 +128,17 @@ caf::behavior pivoter(caf::stateful_actor<pivoter_state>* self, caf::actor node,
   st.node = node;
   st.expr = std::move(expr);
   st.target = std::move(target);
-  auto quit_if_done = [=]() {
-    auto& st = self->state;
-    if (st.initial_query_completed && st.running_exporters == 0)
-      self->quit();
-  };
   self->set_down_handler([=]([[maybe_unused]] const caf::down_msg& msg) {
     // Only the spawned EXPORTERs are expected to send down messages.
     auto& st = self->state;
     st.running_exporters--;
     VAST_DEBUG(self, "received DOWN from", msg.source,
                "outstanding requests:", st.running_exporters);
-    quit_if_done();
+    // Issue the values that accumulated in the meantime, so that results
+    // keep streaming while the initial query runs.
+    if (st.running_exporters == 0)
+      st.flush();
+    st.quit_if_done();
   });
   return {
     [=](vast::table_slice slice) {
@@ -108,55 +149,32 @@ caf::behavior pivoter(caf::stateful_actor<pivoter_state>* self, caf::actor node,
       VAST_DEBUG(self, "uses", *pivot_field, "to extract", st.target, "events");
       auto column = table_slice_column::make(slice, pivot_field->name);
       VAST_ASSERT(column);
-      auto xs = list{};
+      auto& xs = st.pending_ids[pivot_field->name];
       for (size_t i = 0; i < column->size(); ++i) {
-        auto data = materialize((*column)[i]);
-        auto x = caf::get_if<std::string>(&data);
+        auto data = (*column)[i];
+        auto x = caf::get_if<view<std::string>>(&data);
         // Skip if no value
         if (!x)
           continue;
         // Skip if ID was already requested
-        if (st.requested_ids.count(*x) > 0)
-          continue;
-        xs.push_back(*x);
-        st.requested_ids.insert(*x);
+        if (st.requested_ids.emplace(*x).second)
+          xs.emplace_back(std::string{*x});
       }
+      // Collect values into one large membership query while other queries
+      // are in flight, but do not hold back results when none are.
       if (xs.empty()) {
         VAST_DEBUG(self, "already queried for all", pivot_field->name);
-        return;
+        st.pending_ids.erase(pivot_field->name);
+      } else if (st.running_exporters == 0 || xs.size() >= st.batch_size) {
+        st.flush();
       }
-      auto expr = conjunction{
-        predicate{attribute_extractor{atom::type_v}, equal, data{st.target}},
-        predicate{field_extractor{pivot_field->name}, in, data{xs}}};
-      // TODO(ch9411): Drop the conversion to a string when node actors can
-      //               be spawned without going through an invocation.
-      auto query = to_string(expr);
-      VAST_DEBUG(self, "queries for", xs.size(), pivot_field->name);
-      VAST_TRACE(self, "spawns new exporter with query", query);
-      auto exporter_options = caf::settings{};
-      caf::put(exporter_options, "vast.export.disable-taxonomies", true);
-      auto exporter_invocation
-        = invocation{std::move(exporter_options), "spawn exporter", {query}};
-      ++self->state.running_exporters;
-      self->request(st.node, caf::infinite, exporter_invocation)
-        .then(
-          [=](caf::actor handle) {
-            auto exporter = caf::actor_cast<exporter_actor>(std::move(handle));
-            VAST_DEBUG(self, "registers exporter", exporter);
-            self->monitor(exporter);
-            self->send(exporter, atom::sink_v, self->state.sink);
-            self->send(exporter, atom::run_v);
-          },
-          [=](caf::error error) {
-            VAST_ERROR(self, "failed to spawn exporter:", render(error));
-            --self->state.running_exporters;
-          });
-      ;
     },
     [=](std::string name, query_status) {
       VAST_DEBUG(self, "received final status from", name);
-      self->state.initial_query_completed = true;
-      quit_if_done();
+      auto& st = self->state;
+      st.initial_query_completed = true;
+      st.flush();
+      st.quit_if_done();
     },
     [=](atom::sink, const caf::actor& sink) {
       VAST_DEBUG(self, "registers sink", sink);
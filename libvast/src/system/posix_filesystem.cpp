@@ -41,6 +41,18 @@ filesystem_actor::behavior_type posix_filesystem(
         return atom::ok_v;
       }
     },
+    [=](atom::write, const path& filename,
+        const std::vector<chunk_ptr>& chunks) -> caf::result<atom::ok> {
+      auto path = filename.is_absolute() ? filename : root / filename;
+      if (auto err = io::save(path, span<const chunk_ptr>{chunks})) {
+        ++self->state.stats.writes.failed;
+        return err;
+      }
+      ++self->state.stats.writes.successful;
+      for (auto& chk : chunks)
+        self->state.stats.writes.bytes += chk->size();
+      return atom::ok_v;
+    },
     [=](atom::read, const path& filename) -> caf::result<chunk_ptr> {
       auto path = filename.is_absolute() ? filename : root / filename;
       if (auto bytes = io::read(path)) {
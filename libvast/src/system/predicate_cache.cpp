@@ -0,0 +1,126 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/system/predicate_cache.hpp"
+
+#include "vast/bitmap.hpp"
+#include "vast/detail/assert.hpp"
+#include "vast/detail/overload.hpp"
+
+#include <type_traits>
+
+namespace vast::system {
+
+namespace {
+
+// Approximates the memory that a bitmap occupies.
+size_t footprint(const ids& x) {
+  auto f = detail::overload{
+    [](const null_bitmap& bm) {
+      return static_cast<size_t>(bm.size() / 8);
+    },
+    [](const auto& bm) {
+      using block_vector = std::decay_t<decltype(bm.blocks())>;
+      return bm.blocks().size() * sizeof(typename block_vector::value_type);
+    },
+  };
+  return sizeof(ids) + caf::visit(f, x.get_data());
+}
+
+size_t combine(size_t seed, size_t x) {
+  return seed ^ (x + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+} // namespace
+
+bool operator==(const predicate_cache::key& x, const predicate_cache::key& y) {
+  return x.partition == y.partition && x.column == y.column && x.op == y.op
+         && x.rhs == y.rhs;
+}
+
+size_t predicate_cache::key_hash::operator()(const key& x) const {
+  auto result = std::hash<uuid>{}(x.partition);
+  result = combine(result, x.column);
+  result = combine(result, x.op);
+  return combine(result, std::hash<data>{}(x.rhs));
+}
+
+predicate_cache::predicate_cache(size_t capacity) : capacity_{capacity} {
+  // nop
+}
+
+std::optional<ids> predicate_cache::lookup(const key& x) {
+  std::lock_guard<std::mutex> guard{mutex_};
+  auto i = index_.find(x);
+  if (i == index_.end()) {
+    ++stats_.misses;
+    return std::nullopt;
+  }
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, i->second);
+  return i->second->result;
+}
+
+void predicate_cache::insert(key x, ids result) {
+  auto bytes = footprint(result);
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (auto i = index_.find(x); i != index_.end())
+    evict(i->second);
+  if (bytes > capacity_)
+    return;
+  while (size_bytes_ + bytes > capacity_) {
+    VAST_ASSERT(!entries_.empty());
+    evict(std::prev(entries_.end()));
+    ++stats_.evictions;
+  }
+  entries_.push_front(entry{std::move(x), std::move(result), bytes});
+  index_.emplace(entries_.front().predicate, entries_.begin());
+  size_bytes_ += bytes;
+}
+
+void predicate_cache::erase(const uuid& partition) {
+  std::lock_guard<std::mutex> guard{mutex_};
+  for (auto i = entries_.begin(); i != entries_.end();)
+    if (i->predicate.partition == partition)
+      evict(i++);
+    else
+      ++i;
+}
+
+size_t predicate_cache::size() const {
+  std::lock_guard<std::mutex> guard{mutex_};
+  return entries_.size();
+}
+
+size_t predicate_cache::size_bytes() const {
+  std::lock_guard<std::mutex> guard{mutex_};
+  return size_bytes_;
+}
+
+size_t predicate_cache::capacity() const {
+  return capacity_;
+}
+
+predicate_cache::statistics predicate_cache::stats() const {
+  std::lock_guard<std::mutex> guard{mutex_};
+  return stats_;
+}
+
+void predicate_cache::evict(entry_list::iterator i) {
+  VAST_ASSERT(size_bytes_ >= i->bytes);
+  size_bytes_ -= i->bytes;
+  index_.erase(i->predicate);
+  entries_.erase(i);
+}
+
+} // namespace vast::system
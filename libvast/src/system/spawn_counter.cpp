@@ -13,6 +13,7 @@
 
 #include "vast/system/spawn_counter.hpp"
 
+#include "vast/aggregation.hpp"
 #include "vast/concept/printable/to_string.hpp"
 #include "vast/concept/printable/vast/expression.hpp"
 #include "vast/defaults.hpp"
@@ -31,6 +32,9 @@
 #include <caf/send.hpp>
 #include <caf/settings.hpp>
 
+#include <string>
+#include <vector>
+
 namespace vast::system {
 
 maybe_actor
@@ -46,9 +50,34 @@ spawn_counter(system::node_actor* self, system::spawn_arguments& args) {
     return make_error(ec::missing_component, "index");
   if (!archive)
     return make_error(ec::missing_component, "archive");
-  auto estimate = caf::get_or(args.inv.options, "vast.count.estimate", false);
+  const auto& options = args.inv.options;
+  auto mode = count_mode::exact;
+  if (caf::get_or(options, "vast.count.approximate", false))
+    mode = count_mode::approximate;
+  else if (caf::get_or(options, "vast.count.estimate", false))
+    mode = count_mode::estimate;
+  auto fields = [&](const char* key) {
+    return caf::get_or(options, key, std::vector<std::string>{});
+  };
+  auto spec = aggregation_spec{};
+  spec.keys = fields("vast.count.by");
+  spec.sum = fields("vast.count.sum");
+  spec.min = fields("vast.count.min");
+  spec.max = fields("vast.count.max");
+  spec.distinct = fields("vast.count.distinct");
+  spec.max_groups = caf::get_or(options, "vast.count.max-groups",
+                                defaults::count::max_groups);
+  if (spec.keys.empty()
+      && !(spec.sum.empty() && spec.min.empty() && spec.max.empty()
+           && spec.distinct.empty()))
+    return make_error(ec::invalid_configuration,
+                      "aggregates require at least one grouping field");
+  if (!spec.keys.empty() && mode == count_mode::approximate)
+    return make_error(ec::invalid_configuration,
+                      "cannot approximate grouped counts");
   auto handle = self->spawn(counter, *expr, caf::actor_cast<index_actor>(index),
-                            caf::actor_cast<archive_actor>(archive), estimate);
+                            caf::actor_cast<archive_actor>(archive), mode,
+                            std::move(spec));
   VAST_VERBOSE(self, "spawned a counter for", to_string(*expr));
   return handle;
 }
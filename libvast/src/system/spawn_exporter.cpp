@@ -28,6 +28,9 @@
 #include <caf/send.hpp>
 #include <caf/settings.hpp>
 
+#include <string>
+#include <vector>
+
 namespace vast::system {
 
 maybe_actor spawn_exporter(node_actor* self, spawn_arguments& args) {
@@ -45,7 +48,10 @@ maybe_actor spawn_exporter(node_actor* self, spawn_arguments& args) {
   // Default to historical if no options provided.
   if (query_opts == no_query_options)
     query_opts = historical;
-  auto handle = self->spawn(exporter, *expr, query_opts);
+  // Parse the fields to include in the results.
+  auto fields = caf::get_or(args.inv.options, "vast.export.fields",
+                            std::vector<std::string>{});
+  auto handle = self->spawn(exporter, *expr, query_opts, std::move(fields));
   VAST_VERBOSE(self, "spawned an exporter for", to_string(*expr));
   // Wire the exporter to all components.
   auto [accountant, importer, archive, index]
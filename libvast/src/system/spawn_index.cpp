@@ -13,6 +13,8 @@
 
 #include "vast/system/spawn_index.hpp"
 
+#include "vast/concept/parseable/to.hpp"
+#include "vast/concept/parseable/vast/time.hpp"
 #include "vast/defaults.hpp"
 #include "vast/error.hpp"
 #include "vast/logger.hpp"
@@ -33,6 +35,14 @@ maybe_actor spawn_index(node_actor* self, spawn_arguments& args) {
   if (!filesystem)
     return make_error(ec::lookup_error, "failed to find filesystem actor");
   namespace sd = vast::defaults::system;
+  auto active_partition_timeout = sd::active_partition_timeout;
+  if (auto str = caf::get_if<std::string>(&args.inv.options,
+                                          "vast.active-partition-timeout")) {
+    auto parsed = to<duration>(*str);
+    if (!parsed)
+      return parsed.error();
+    active_partition_timeout = *parsed;
+  }
   auto handle = self->spawn(
     index, filesystem, args.dir / args.label,
     // TODO: Pass these options as a vast::data object instead.
@@ -40,7 +50,11 @@ maybe_actor spawn_index(node_actor* self, spawn_arguments& args) {
     opt("vast.max-resident-partitions", sd::max_in_mem_partitions),
     opt("vast.max-taste-partitions", sd::taste_partitions),
     opt("vast.max-queries", sd::num_query_supervisors),
-    opt("vast.meta-index-fp-rate", sd::string_synopsis_fp_rate));
+    opt("vast.meta-index-fp-rate", sd::string_synopsis_fp_rate),
+    opt("vast.max-predicate-cache-size", sd::max_predicate_cache_size)
+      * 1'048'576,
+    opt("vast.partition-per-layout", sd::partition_per_layout),
+    active_partition_timeout);
   VAST_VERBOSE(self, "spawned the index");
   if (auto accountant = self->state.registry.find_by_label("accountant"))
     self->send(handle, caf::actor_cast<accountant_actor>(accountant));
@@ -78,8 +78,13 @@ spawn_node(caf::scoped_actor& self, const caf::settings& opts) {
     else
       return x.error();
   }
+  auto filesystem_config = to_async_filesystem_config(
+    caf::get_or(opts, "vast.filesystem", caf::settings{}));
+  if (!filesystem_config)
+    return filesystem_config.error();
   // Pointer to the root command to system::node.
-  auto actor = self->spawn(system::node, id, abs_dir, shutdown_grace_period);
+  auto actor = self->spawn(system::node, id, abs_dir, shutdown_grace_period,
+                           std::move(*filesystem_config));
   actor->attach_functor([pid_file = std::move(pid_file)](const caf::error&) {
     VAST_DEBUG_ANON(__func__, "removes PID lock:", pid_file.str());
     rm(pid_file);
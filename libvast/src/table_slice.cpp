@@ -16,6 +16,7 @@
 #include "vast/chunk.hpp"
 #include "vast/defaults.hpp"
 #include "vast/detail/assert.hpp"
+#include "vast/detail/narrow.hpp"
 #include "vast/detail/overload.hpp"
 #include "vast/detail/string.hpp"
 #include "vast/error.hpp"
@@ -31,8 +32,14 @@
 
 #if VAST_ENABLE_ARROW
 #  include "vast/arrow_table_slice.hpp"
+#  include "vast/arrow_table_slice_builder.hpp"
+
+#  include <arrow/record_batch.h>
+#  include <arrow/type.h>
 #endif // VAST_ENABLE_ARROW
 
+#include <algorithm>
+
 namespace vast {
 
 // -- utility functions --------------------------------------------------------
@@ -544,6 +551,88 @@ split(const table_slice& slice, size_t partition_point) {
   return {std::move(xs.front()), std::move(xs.back())};
 }
 
+std::vector<size_t> resolve_columns(const record_type& layout,
+                                    const std::vector<std::string>& fields) {
+  // Checks whether a field is a suffix of a qualified name that starts at a
+  // component boundary.
+  auto is_suffix = [](std::string_view name, std::string_view field) {
+    return detail::ends_with(name, field)
+           && (name.size() == field.size()
+               || name[name.size() - field.size() - 1] == '.');
+  };
+  std::vector<size_t> result;
+  auto flat_layout = flatten(layout);
+  for (size_t column = 0; column < flat_layout.fields.size(); ++column) {
+    auto qualified = layout.name() + '.' + flat_layout.fields[column].name;
+    // The name of the column itself and of all enclosing records within the
+    // layout qualify for a match.
+    auto first = qualified.size() - flat_layout.fields[column].name.size();
+    auto selected = false;
+    for (auto end = qualified.size(); !selected && end > first;
+         end = qualified.rfind('.', end - 1)) {
+      auto name = std::string_view{qualified}.substr(0, end);
+      selected = std::any_of(fields.begin(), fields.end(), [&](auto& field) {
+        return !field.empty() && is_suffix(name, field);
+      });
+    }
+    if (selected)
+      result.push_back(column);
+  }
+  return result;
+}
+
+table_slice
+project(const table_slice& slice, const std::vector<size_t>& columns) {
+  VAST_ASSERT(slice.encoding() != table_slice_encoding::none);
+  VAST_ASSERT(!columns.empty());
+  VAST_ASSERT(std::is_sorted(columns.begin(), columns.end()));
+  auto flat_layout = flatten(slice.layout());
+  VAST_ASSERT(columns.back() < flat_layout.fields.size());
+  // Do all columns qualify?
+  if (columns.size() == flat_layout.fields.size())
+    return slice;
+  record_type projected;
+  for (auto column : columns)
+    projected.fields.push_back(flat_layout.fields[column]);
+  auto layout = unflatten(projected);
+  layout.name(slice.layout().name());
+  layout.attributes(slice.layout().attributes());
+#if VAST_ENABLE_ARROW
+  // Arrow stores columns separately, which allows for projecting without
+  // touching the individual values.
+  if (slice.encoding() == table_slice_encoding::arrow) {
+    auto batch = as_record_batch(slice);
+    auto fields = arrow::FieldVector{};
+    auto arrays = std::vector<std::shared_ptr<arrow::Array>>{};
+    for (auto column : columns) {
+      auto i = detail::narrow_cast<int>(column);
+      fields.push_back(batch->schema()->field(i));
+      arrays.push_back(batch->column(i));
+    }
+    auto schema = arrow::schema(std::move(fields), batch->schema()->metadata());
+    auto projected_batch = arrow::RecordBatch::Make(
+      std::move(schema), batch->num_rows(), std::move(arrays));
+    auto result = arrow_table_slice_builder::create(*projected_batch, layout);
+    result.offset(slice.offset());
+    return result;
+  }
+#endif // VAST_ENABLE_ARROW
+  auto builder
+    = factory<table_slice_builder>::make(builder_id(slice.encoding()), layout);
+  if (builder == nullptr) {
+    VAST_ERROR(__func__, "failed to get a table slice builder for",
+               slice.encoding());
+    return {};
+  }
+  for (size_t row = 0; row < slice.rows(); ++row)
+    for (auto column : columns)
+      if (!builder->add(slice.at(row, column, flat_layout.fields[column].type)))
+        return {};
+  auto result = builder->finish();
+  result.offset(slice.offset());
+  return result;
+}
+
 uint64_t rows(const std::vector<table_slice>& slices) {
   auto result = uint64_t{0};
   for (auto& slice : slices)
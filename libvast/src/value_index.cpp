@@ -13,11 +13,15 @@
 
 #include "vast/value_index.hpp"
 
+#include "vast/bitmap_algorithms.hpp"
 #include "vast/value_index_factory.hpp"
 
 #include <caf/deserializer.hpp>
 #include <caf/serializer.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace vast {
 
 value_index::value_index(vast::type t, caf::settings opts)
@@ -63,6 +67,18 @@ value_index::lookup(relational_operator op, data_view x) const {
       result.append_bits(!is_equal, mask_.size() - result.size());
     return result;
   }
+  // Membership in a list is the union of equality lookups, which concrete
+  // index types may compute in one go.
+  if (op == in || op == not_in) {
+    if (auto xs = caf::get_if<view<list>>(&x)) {
+      auto result = lookup_many(*xs);
+      if (result && op == not_in) {
+        result->flip();
+        *result &= mask_;
+      }
+      return result;
+    }
+  }
   // If x is not nil, we dispatch to the concrete implementation.
   auto result = lookup_impl(op, x);
   if (!result)
@@ -84,6 +100,38 @@ value_index::lookup(relational_operator op, data_view x) const {
   return std::move(*result);
 }
 
+caf::expected<ids> value_index::lookup_many(view<list> xs) const {
+  auto result = lookup_many_impl(xs);
+  if (!result)
+    return result;
+  *result &= mask_;
+  // The concrete implementations never see nil values, so we add them here
+  // if the list contains nil, just like an equality lookup for nil does.
+  auto is_nil = [](auto x) { return caf::holds_alternative<caf::none_t>(x); };
+  if (std::any_of(xs->begin(), xs->end(), is_nil))
+    *result |= none_;
+  if (result->size() < offset())
+    result->append_bits(false, offset() - result->size());
+  return std::move(*result);
+}
+
+caf::expected<ids> value_index::lookup_many_impl(view<list> xs) const {
+  std::vector<ids> bitmaps;
+  bitmaps.reserve(xs->size());
+  for (auto x : *xs) {
+    // Nil values are handled by lookup_many.
+    if (caf::holds_alternative<caf::none_t>(x))
+      continue;
+    auto result = lookup_impl(equal, x);
+    if (!result)
+      return result;
+    bitmaps.push_back(std::move(*result));
+  }
+  if (bitmaps.empty())
+    return ids{offset(), false};
+  return nary_or(bitmaps.begin(), bitmaps.end());
+}
+
 value_index::size_type value_index::offset() const {
   return std::max(none_.size(), mask_.size());
 }
@@ -22,9 +22,12 @@
 #include "vast/index/arithmetic_index.hpp"
 #include "vast/index/enumeration_index.hpp"
 #include "vast/index/hash_index.hpp"
+#include "vast/index/inverted_index.hpp"
 #include "vast/index/list_index.hpp"
 #include "vast/index/string_index.hpp"
 #include "vast/index/subnet_index.hpp"
+#include "vast/index/time_index.hpp"
+#include "vast/index/trie_index.hpp"
 #include "vast/logger.hpp"
 #include "vast/type.hpp"
 #include "vast/value_index.hpp"
@@ -62,6 +65,13 @@ value_index_ptr make(type x, caf::settings opts) {
     }
   }
   if (auto a = find_attribute(x, "index")) {
+    if constexpr (std::is_same_v<T, list_index>)
+      if (auto value = a->value; value && *value == "inverted"sv
+                                 && is_basic(caf::get<list_type>(x).value_type))
+        return std::make_unique<inverted_index>(std::move(x), std::move(opts));
+    if constexpr (detail::is_any_v<T, address_index, subnet_index>)
+      if (auto value = a->value; value && *value == "trie"sv)
+        return std::make_unique<trie_index>(std::move(x), std::move(opts));
     if (auto value = a->value)
       if (*value == "hash"sv) {
         auto i = opts.find("cardinality");
@@ -130,6 +140,21 @@ value_index_ptr make(type x, caf::settings opts) {
   return std::make_unique<T>(std::move(x), std::move(opts));
 }
 
+// Arithmetic types use a bit-sliced index with the attribute #index=bitslice,
+// and time values use sorted runs with the attribute #index=sorted.
+template <class T>
+value_index_ptr make_arithmetic(type x, caf::settings opts) {
+  using bitslice_index = arithmetic_index<T, void, bitslice_coder<ids>>;
+  if (auto a = find_attribute(x, "index")) {
+    if (auto value = a->value; value && *value == "bitslice"sv)
+      return std::make_unique<bitslice_index>(std::move(x), std::move(opts));
+    if constexpr (std::is_same_v<T, time>)
+      if (auto value = a->value; value && *value == "sorted"sv)
+        return std::make_unique<time_index>(std::move(x), std::move(opts));
+  }
+  return make<arithmetic_index<T>>(std::move(x), std::move(opts));
+}
+
 template <class T, class Index>
 auto add_value_index_factory() {
   return factory<value_index>::add(T{}, make<Index>);
@@ -140,7 +165,7 @@ auto add_arithmetic_index_factory() {
   static_assert(detail::is_any_v<T, integer_type, count_type, enumeration_type,
                                  real_type, duration_type, time_type>);
   using concrete_data = type_to_data<T>;
-  return add_value_index_factory<T, arithmetic_index<concrete_data>>();
+  return factory<value_index>::add(T{}, make_arithmetic<concrete_data>);
 }
 
 } // namespace <anonymous>
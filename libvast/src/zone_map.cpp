@@ -0,0 +1,274 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/zone_map.hpp"
+
+#include "vast/detail/assert.hpp"
+#include "vast/detail/overload.hpp"
+#include "vast/detail/string.hpp"
+#include "vast/expression.hpp"
+#include "vast/table_slice.hpp"
+#include "vast/view.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace vast {
+
+namespace {
+
+// Only columns with a total order benefit from a minimum and maximum.
+bool has_range(const type& t) {
+  return caf::holds_alternative<integer_type>(t)
+         || caf::holds_alternative<count_type>(t)
+         || caf::holds_alternative<real_type>(t)
+         || caf::holds_alternative<duration_type>(t)
+         || caf::holds_alternative<time_type>(t);
+}
+
+// Converts the literal of a predicate to the type of the summarized values,
+// if that is possible without changing the outcome of any comparison.
+caf::optional<data> coerce(const data& x, const data& like) {
+  auto f = [](const auto& lhs, const auto& rhs) -> caf::optional<data> {
+    using lhs_type = std::decay_t<decltype(lhs)>;
+    using rhs_type = std::decay_t<decltype(rhs)>;
+    if constexpr (std::is_same_v<lhs_type, rhs_type>) {
+      return data{rhs};
+    } else if constexpr (std::is_same_v<lhs_type, count>
+                         && std::is_same_v<rhs_type, integer>) {
+      if (rhs >= 0)
+        return data{static_cast<count>(rhs)};
+    } else if constexpr (std::is_same_v<lhs_type, integer>
+                         && std::is_same_v<rhs_type, count>) {
+      if (rhs <= static_cast<count>(std::numeric_limits<integer>::max()))
+        return data{static_cast<integer>(rhs)};
+    } else if constexpr (std::is_same_v<lhs_type, real>
+                         && (std::is_same_v<rhs_type, integer>
+                             || std::is_same_v<rhs_type, count>)) {
+      return data{static_cast<real>(rhs)};
+    }
+    return caf::none;
+  };
+  return caf::visit(f, like, x);
+}
+
+// Checks whether a column with the given summary may contain a value for
+// which `value op rhs` holds.
+bool may_match(const zone_map::column_range& x, uint64_t rows,
+               relational_operator op, const data& rhs) {
+  if (caf::holds_alternative<caf::none_t>(rhs)) {
+    if (op == equal)
+      return x.nils > 0;
+    if (op == not_equal)
+      return x.nils < rows;
+    return true;
+  }
+  if (op == in) {
+    if (auto xs = caf::get_if<list>(&rhs))
+      return std::any_of(xs->begin(), xs->end(), [&](const data& y) {
+        return may_match(x, rows, equal, y);
+      });
+    return true;
+  }
+  // Without a single non-nil value, no ordering can hold.
+  if (caf::holds_alternative<caf::none_t>(x.min))
+    return op != equal && op != less && op != less_equal && op != greater
+           && op != greater_equal;
+  auto y = coerce(rhs, x.min);
+  if (!y)
+    return true;
+  switch (op) {
+    default:
+      return true;
+    case equal:
+      return x.min <= *y && *y <= x.max;
+    case not_equal:
+      return x.nils > 0 || !(x.min == *y && x.max == *y);
+    case less:
+      return x.min < *y;
+    case less_equal:
+      return x.min <= *y;
+    case greater:
+      return x.max > *y;
+    case greater_equal:
+      return x.max >= *y;
+  }
+}
+
+/// Decides for a single table slice whether it may contain matching events.
+/// Every predicate that the summaries cannot decide evaluates to `true`.
+class zone_evaluator {
+public:
+  zone_evaluator(const std::vector<qualified_record_field>& columns,
+                 const std::vector<uint64_t>& layout_columns,
+                 const zone_map::zone& zone)
+    : columns_{columns}, layout_columns_{layout_columns}, zone_{zone} {
+    // nop
+  }
+
+  bool operator()(caf::none_t) const {
+    return true;
+  }
+
+  bool operator()(const conjunction& xs) const {
+    return std::all_of(xs.begin(), xs.end(), [&](const expression& x) {
+      return caf::visit(*this, x);
+    });
+  }
+
+  bool operator()(const disjunction& xs) const {
+    return std::any_of(xs.begin(), xs.end(), [&](const expression& x) {
+      return caf::visit(*this, x);
+    });
+  }
+
+  bool operator()(const negation&) const {
+    // A summary cannot rule out the complement of a predicate.
+    return true;
+  }
+
+  bool operator()(const predicate& x) const {
+    // Checks all columns of the table slice that the extractor refers to. A
+    // column without a summary can never be ruled out.
+    auto search = [&](auto match) {
+      for (auto column : layout_columns_) {
+        if (!match(columns_[column]))
+          continue;
+        auto range = std::find_if(
+          zone_.ranges.begin(), zone_.ranges.end(),
+          [&](const zone_map::column_range& r) { return r.column == column; });
+        if (range == zone_.ranges.end())
+          return true;
+        if (may_match(*range, zone_.rows, x.op, caf::get<data>(x.rhs)))
+          return true;
+      }
+      return false;
+    };
+    auto f = detail::overload{
+      [&](const attribute_extractor& lhs, const data& rhs) {
+        if (lhs.attr == atom::type_v)
+          return evaluate(data{zone_.layout}, x.op, rhs);
+        if (lhs.attr == atom::timestamp_v)
+          return search([](const qualified_record_field& field) {
+            return has_attribute(field.type, "timestamp");
+          });
+        return true;
+      },
+      [&](const field_extractor& lhs, const data&) {
+        return search([&](const qualified_record_field& field) {
+          return detail::ends_with(field.fqn(), lhs.field);
+        });
+      },
+      [&](const type_extractor& lhs, const data&) {
+        return search([&](const qualified_record_field& field) {
+          return congruent(field.type, lhs.type);
+        });
+      },
+      [](const auto&, const auto&) { return true; },
+    };
+    return caf::visit(f, x.lhs, x.rhs);
+  }
+
+private:
+  const std::vector<qualified_record_field>& columns_;
+  const std::vector<uint64_t>& layout_columns_;
+  const zone_map::zone& zone_;
+};
+
+} // namespace
+
+void zone_map::add(const table_slice& slice) {
+  VAST_ASSERT(slice.encoding() != table_slice_encoding::none);
+  if (slice.rows() == 0)
+    return;
+  auto layout = flatten(slice.layout());
+  const auto& columns = columns_for(layout);
+  auto result = zone{slice.offset(), slice.rows(), layout.name(), {}};
+  for (size_t column = 0; column < layout.fields.size(); ++column) {
+    if (!has_range(layout.fields[column].type))
+      continue;
+    auto range = column_range{columns[column], {}, {}, 0};
+    for (size_t row = 0; row < slice.rows(); ++row) {
+      auto x = slice.at(row, column);
+      if (caf::holds_alternative<caf::none_t>(x)) {
+        ++range.nils;
+        continue;
+      }
+      auto y = materialize(x);
+      // NaN is unordered, so we treat it like nil to stay conservative.
+      if (auto r = caf::get_if<real>(&y); r && std::isnan(*r)) {
+        ++range.nils;
+        continue;
+      }
+      if (caf::holds_alternative<caf::none_t>(range.min) || y < range.min)
+        range.min = y;
+      if (caf::holds_alternative<caf::none_t>(range.max) || range.max < y)
+        range.max = std::move(y);
+    }
+    result.ranges.push_back(std::move(range));
+  }
+  auto it = std::upper_bound(zones_.begin(), zones_.end(), result.offset,
+                             [](id x, const zone& z) { return x < z.offset; });
+  VAST_ASSERT(it == zones_.end() || result.offset + result.rows <= it->offset);
+  zones_.insert(it, std::move(result));
+}
+
+ids zone_map::lookup(const expression& expr) const {
+  std::unordered_map<std::string, std::vector<uint64_t>> layouts;
+  for (uint64_t i = 0; i < columns_.size(); ++i)
+    layouts[columns_[i].layout_name].push_back(i);
+  static const auto no_columns = std::vector<uint64_t>{};
+  ids result;
+  for (auto& zone : zones_) {
+    auto it = layouts.find(zone.layout);
+    const auto& columns = it != layouts.end() ? it->second : no_columns;
+    if (caf::visit(zone_evaluator{columns_, columns, zone}, expr)) {
+      VAST_ASSERT(zone.offset >= result.size());
+      result.append_bits(false, zone.offset - result.size());
+      result.append_bits(true, zone.rows);
+    }
+  }
+  return result;
+}
+
+bool zone_map::empty() const {
+  return zones_.empty();
+}
+
+const std::vector<qualified_record_field>& zone_map::columns() const {
+  return columns_;
+}
+
+const std::vector<zone_map::zone>& zone_map::zones() const {
+  return zones_;
+}
+
+const std::vector<uint64_t>& zone_map::columns_for(const record_type& layout) {
+  auto t = type{layout};
+  if (auto it = layout_columns_.find(t); it != layout_columns_.end())
+    return it->second;
+  std::vector<uint64_t> result;
+  result.reserve(layout.fields.size());
+  for (auto& field : layout.fields) {
+    auto qf = qualified_record_field{layout.name(), field};
+    auto it = std::find(columns_.begin(), columns_.end(), qf);
+    result.push_back(it - columns_.begin());
+    if (it == columns_.end())
+      columns_.push_back(std::move(qf));
+  }
+  return layout_columns_.emplace(std::move(t), std::move(result)).first->second;
+}
+
+} // namespace vast
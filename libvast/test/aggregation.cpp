@@ -0,0 +1,162 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE aggregation
+
+#include "vast/aggregation.hpp"
+
+#include "vast/test/fixtures/events.hpp"
+#include "vast/test/test.hpp"
+
+#include "vast/ids.hpp"
+#include "vast/table_slice.hpp"
+
+#include <map>
+#include <set>
+
+using namespace vast;
+
+namespace {
+
+struct fixture : fixtures::events {
+  static ids all(const table_slice& slice) {
+    return make_ids({{slice.offset(), slice.offset() + slice.rows()}});
+  }
+
+  static aggregation aggregate(aggregation_spec spec, size_t first,
+                               size_t last) {
+    auto result = aggregation{std::move(spec)};
+    for (auto i = first; i < last; ++i)
+      result.add(zeek_conn_log_full[i], all(zeek_conn_log_full[i]));
+    return result;
+  }
+};
+
+} // namespace
+
+FIXTURE_SCOPE(aggregation_tests, fixture)
+
+TEST(count by key) {
+  auto spec = aggregation_spec{};
+  spec.keys = {"proto"};
+  auto sut = aggregate(spec, 0, zeek_conn_log_full.size());
+  std::map<data, count> expected;
+  for (auto& slice : zeek_conn_log_full) {
+    auto column = resolve_columns(slice.layout(), {"proto"});
+    REQUIRE_EQUAL(column.size(), 1u);
+    for (size_t row = 0; row < slice.rows(); ++row)
+      ++expected[materialize(slice.at(row, column[0]))];
+  }
+  REQUIRE_EQUAL(sut.size(), expected.size());
+  CHECK_EQUAL(sut.threshold(), 0u);
+  auto total = count{0};
+  for (auto& r : sut.make_records()) {
+    auto n = caf::get<count>(r["count"]);
+    CHECK_EQUAL(n, expected[r["proto"]]);
+    CHECK_EQUAL(r.count("error"), 0u);
+    total += n;
+  }
+  CHECK_EQUAL(total, rows(zeek_conn_log_full));
+}
+
+TEST(count by ambiguous key) {
+  auto spec = aggregation_spec{};
+  spec.keys = {"id"};
+  auto sut = aggregation{spec};
+  std::set<data> expected;
+  for (auto& slice : zeek_conn_log) {
+    sut.add(slice, all(slice));
+    auto columns = resolve_columns(slice.layout(), {"id"});
+    REQUIRE_EQUAL(columns.size(), 4u);
+    for (size_t row = 0; row < slice.rows(); ++row) {
+      auto key = list{};
+      for (auto column : columns)
+        key.push_back(materialize(slice.at(row, column)));
+      expected.insert(std::move(key));
+    }
+  }
+  MESSAGE("the key consists of all columns that the field resolves to");
+  CHECK_EQUAL(sut.size(), expected.size());
+  for (auto& r : sut.make_records())
+    CHECK_EQUAL(expected.count(r["id"]), 1u);
+}
+
+TEST(selection) {
+  auto spec = aggregation_spec{};
+  spec.keys = {"proto"};
+  auto sut = aggregation{spec};
+  auto& slice = zeek_conn_log_full[0];
+  sut.add(slice, make_ids({{slice.offset() + 10, slice.offset() + 20}}));
+  auto total = count{0};
+  for (auto& r : sut.make_records())
+    total += caf::get<count>(r["count"]);
+  CHECK_EQUAL(total, 10u);
+}
+
+TEST(merge) {
+  auto spec = aggregation_spec{};
+  spec.keys = {"proto", "service"};
+  spec.sum = {"orig_bytes"};
+  spec.min = {"duration"};
+  spec.max = {"resp_bytes"};
+  spec.distinct = {"id.orig_h"};
+  auto n = zeek_conn_log_full.size();
+  auto whole = aggregate(spec, 0, n);
+  auto sut = aggregate(spec, 0, n / 3);
+  sut.merge(aggregate(spec, n / 3, n));
+  CHECK_EQUAL(sut.size(), whole.size());
+  CHECK_EQUAL(sut.make_records(), whole.make_records());
+  auto r = whole.make_records().front();
+  CHECK(r.count("proto") == 1 && r.count("service") == 1);
+  CHECK_EQUAL(r.count("sum(orig_bytes)"), 1u);
+  CHECK_EQUAL(r.count("min(duration)"), 1u);
+  CHECK_EQUAL(r.count("max(resp_bytes)"), 1u);
+  CHECK_EQUAL(r.count("distinct(id.orig_h)"), 1u);
+}
+
+TEST(distinct estimate) {
+  auto spec = aggregation_spec{};
+  spec.keys = {"proto"};
+  spec.distinct = {"id.resp_h"};
+  auto sut = aggregate(spec, 0, zeek_conn_log_full.size());
+  std::map<data, std::set<data>> expected;
+  for (auto& slice : zeek_conn_log_full) {
+    auto key = resolve_columns(slice.layout(), {"proto"});
+    auto value = resolve_columns(slice.layout(), {"id.resp_h"});
+    for (size_t row = 0; row < slice.rows(); ++row)
+      expected[materialize(slice.at(row, key[0]))].insert(
+        materialize(slice.at(row, value[0])));
+  }
+  for (auto& r : sut.make_records()) {
+    auto estimate = caf::get<count>(r["distinct(id.resp_h)"]);
+    auto actual = expected[r["proto"]].size();
+    CHECK_LESS_EQUAL(estimate, actual * 1.1 + 1);
+    CHECK_GREATER_EQUAL(estimate, actual * 0.9 - 1);
+  }
+}
+
+TEST(bounded number of groups) {
+  auto spec = aggregation_spec{};
+  spec.keys = {"uid"};
+  spec.max_groups = 100;
+  auto sut = aggregate(spec, 0, zeek_conn_log_full.size());
+  CHECK_LESS_EQUAL(sut.size(), 100u);
+  CHECK_GREATER(sut.threshold(), 0u);
+  for (auto& r : sut.make_records()) {
+    // Every uid occurs once, so the count overestimates by exactly the error.
+    auto error = r.count("error") ? caf::get<count>(r["error"]) : 0u;
+    CHECK_EQUAL(caf::get<count>(r["count"]) - error, 1u);
+  }
+}
+
+FIXTURE_SCOPE_END()
@@ -0,0 +1,91 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE flow_table
+
+#include "vast/detail/flow_table.hpp"
+
+#include "vast/test/test.hpp"
+
+#include "vast/community_id.hpp"
+#include "vast/flow.hpp"
+
+using namespace vast;
+using namespace std::string_view_literals;
+
+namespace {
+
+flow make_tcp_flow(uint16_t src_port) {
+  return unbox(make_flow<port::tcp>("10.0.0.1", "10.0.0.2", src_port, 80));
+}
+
+struct fixture {
+  fixture() : table(3) {
+    // nop
+  }
+
+  detail::flow_table table;
+};
+
+} // namespace
+
+FIXTURE_SCOPE(flow_table_tests, fixture)
+
+TEST(lookup) {
+  auto& st = table.touch(make_tcp_flow(1), 10);
+  CHECK_EQUAL(st.bytes, 0u);
+  CHECK_EQUAL(st.last, 10u);
+  st.bytes = 42;
+  auto& again = table.touch(make_tcp_flow(1), 11);
+  CHECK_EQUAL(again.bytes, 42u);
+  CHECK_EQUAL(again.last, 11u);
+  CHECK_EQUAL(table.size(), 1u);
+}
+
+TEST(community id) {
+  auto x = make_tcp_flow(1);
+  auto expected = community_id::compute<policy::base64>(x);
+  CHECK_EQUAL(table.touch(x, 0).community_id(), expected);
+  detail::flow_table without{3, false};
+  CHECK_EQUAL(without.touch(x, 0).community_id(), ""sv);
+}
+
+TEST(least recently used eviction) {
+  table.touch(make_tcp_flow(1), 1);
+  table.touch(make_tcp_flow(2), 2);
+  table.touch(make_tcp_flow(3), 3);
+  table.touch(make_tcp_flow(1), 4);
+  table.touch(make_tcp_flow(4), 5);
+  CHECK_EQUAL(table.size(), 3u);
+  CHECK(table.contains(make_tcp_flow(1)));
+  CHECK(!table.contains(make_tcp_flow(2)));
+  CHECK(table.contains(make_tcp_flow(3)));
+  CHECK(table.contains(make_tcp_flow(4)));
+}
+
+TEST(expiry) {
+  table.touch(make_tcp_flow(1), 1);
+  table.touch(make_tcp_flow(2), 2);
+  table.touch(make_tcp_flow(3), 8);
+  CHECK_EQUAL(table.expire(10, 5), 2u);
+  CHECK_EQUAL(table.size(), 1u);
+  CHECK(table.contains(make_tcp_flow(3)));
+  MESSAGE("expired slots get reused");
+  table.touch(make_tcp_flow(4), 11);
+  table.touch(make_tcp_flow(5), 12);
+  CHECK_EQUAL(table.size(), 3u);
+  CHECK_EQUAL(table.expire(100, 5), 3u);
+  CHECK(table.empty());
+}
+
+FIXTURE_SCOPE_END()
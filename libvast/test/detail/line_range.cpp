@@ -0,0 +1,126 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE line_range
+
+#include "vast/detail/line_range.hpp"
+
+#include "vast/test/test.hpp"
+
+#include "vast/detail/fdinbuf.hpp"
+#include "vast/detail/string.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace vast;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<std::string> lines(const std::string& input) {
+  std::istringstream in{input};
+  detail::line_range range{in};
+  std::vector<std::string> result;
+  for (range.next(); !range.done(); range.next())
+    result.emplace_back(range.get());
+  return result;
+}
+
+} // namespace
+
+TEST(find first of) {
+  auto str = std::string(100, 'x');
+  CHECK_EQUAL(detail::find_first_of(str, '\n', '\r'), std::string::npos);
+  // Hit every position relative to 16 and 32 byte blocks.
+  for (size_t i = 0; i < str.size(); ++i) {
+    auto copy = str;
+    copy[i] = '\r';
+    CHECK_EQUAL(detail::find_first_of(copy, '\n', '\r'), i);
+    CHECK_EQUAL(detail::find_first_of(copy, '\n', '\r', i + 1),
+                std::string::npos);
+  }
+}
+
+TEST(line breaks) {
+  auto xs = lines("foo\nbar\r\nbaz\rqux");
+  REQUIRE_EQUAL(xs.size(), 4u);
+  CHECK_EQUAL(xs[0], "foo");
+  CHECK_EQUAL(xs[1], "bar");
+  CHECK_EQUAL(xs[2], "baz");
+  CHECK_EQUAL(xs[3], "qux");
+}
+
+TEST(empty lines) {
+  std::istringstream in{"\n\nfoo\n\r\n\nbar\n"};
+  detail::line_range range{in};
+  range.next();
+  CHECK_EQUAL(range.get(), "foo");
+  CHECK_EQUAL(range.line_number(), 3u);
+  range.next();
+  CHECK_EQUAL(range.get(), "bar");
+  CHECK_EQUAL(range.line_number(), 6u);
+  range.next();
+  CHECK(range.done());
+}
+
+TEST(long lines) {
+  auto line = std::string(200'000, 'a');
+  auto xs = lines(line + '\n' + line + "\r\nb");
+  REQUIRE_EQUAL(xs.size(), 3u);
+  CHECK_EQUAL(xs[0], line);
+  CHECK_EQUAL(xs[1], line);
+  CHECK_EQUAL(xs[2], "b");
+}
+
+TEST(partial line across read timeouts) {
+  int pipefds[2];
+  REQUIRE_EQUAL(::pipe(pipefds), 0);
+  auto [read_end, write_end] = pipefds;
+  auto write = [fd = write_end](std::string_view x) {
+    auto result = ::write(fd, x.data(), x.size());
+    REQUIRE_EQUAL(static_cast<size_t>(result), x.size());
+  };
+  detail::fdinbuf buf{read_end};
+  std::istream in{&buf};
+  detail::line_range range{in};
+  MESSAGE("a complete line followed by the start of another one");
+  write("foo\nba");
+  CHECK(!range.next_timeout(10ms));
+  CHECK_EQUAL(range.get(), "foo");
+  MESSAGE("the partial line stays buffered while the input stalls");
+  for (auto i = 0; i < 3; ++i) {
+    CHECK(range.next_timeout(10ms));
+    CHECK_EQUAL(range.get(), "");
+    CHECK(!range.done());
+  }
+  MESSAGE("the rest of the line completes it exactly once");
+  write("r\nbaz");
+  CHECK(!range.next_timeout(10ms));
+  CHECK_EQUAL(range.get(), "bar");
+  CHECK_EQUAL(range.line_number(), 2u);
+  CHECK(range.next_timeout(10ms));
+  CHECK_EQUAL(range.get(), "");
+  MESSAGE("the end of input flushes the last partial line");
+  ::close(write_end);
+  CHECK(!range.next_timeout(10ms));
+  CHECK_EQUAL(range.get(), "baz");
+  CHECK_EQUAL(range.line_number(), 3u);
+  CHECK(!range.next_timeout(10ms));
+  CHECK(range.done());
+  ::close(read_end);
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE pcap_trace
+
+#include "vast/detail/pcap_trace.hpp"
+
+#include "vast/test/data.hpp"
+#include "vast/test/fixtures/filesystem.hpp"
+#include "vast/test/test.hpp"
+
+#include "vast/error.hpp"
+#include "vast/io/write.hpp"
+#include "vast/path.hpp"
+#include "vast/span.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace vast;
+
+TEST(classic pcap) {
+  auto trace = unbox(detail::pcap_trace::make(artifacts::traces::nmap_vsn));
+  auto first = unbox(trace.next());
+  // 2011-09-27T18:07:20.497541 UTC.
+  CHECK_EQUAL(first.timestamp.time_since_epoch().count(),
+              1317146840497541000);
+  CHECK_EQUAL(first.data.size(), 78u);
+  size_t packets = 1;
+  size_t bytes = first.data.size();
+  auto next = trace.next();
+  for (; next; next = trace.next()) {
+    ++packets;
+    bytes += next->data.size();
+  }
+  CHECK_EQUAL(next.error(), ec::end_of_input);
+  CHECK_EQUAL(packets, 547u);
+  CHECK_EQUAL(bytes, 24420u);
+}
+
+TEST(invalid magic) {
+  auto not_a_trace = detail::pcap_trace::make(__FILE__);
+  REQUIRE(!not_a_trace);
+  CHECK_EQUAL(not_a_trace.error(), ec::format_error);
+}
+
+FIXTURE_SCOPE(pcap_trace_tests, fixtures::filesystem)
+
+TEST(malformed pcapng section header) {
+  auto make = [&](const std::vector<uint32_t>& words) {
+    auto filename = directory / "trace.pcapng";
+    auto bytes = as_bytes(span<const uint32_t>{words.data(), words.size()});
+    REQUIRE_EQUAL(io::write(filename, bytes), caf::none);
+    return detail::pcap_trace::make(filename);
+  };
+  // Block type, block length, byte-order magic, major and minor version,
+  // section length (unspecified), and the trailing block length.
+  auto shb = [](uint32_t length) {
+    return std::vector<uint32_t>{0x0a0d0d0a, length,     0x1a2b3c4d, 0x00000001,
+                                 0xffffffff, 0xffffffff, length};
+  };
+  MESSAGE("valid section header");
+  {
+    auto trace = unbox(make(shb(28)));
+    CHECK_EQUAL(trace.next().error(), ec::end_of_input);
+  }
+  MESSAGE("zero, short, and unaligned block lengths");
+  for (auto length : {0u, 4u, 24u, 30u}) {
+    auto trace = make(shb(length));
+    REQUIRE(!trace);
+    CHECK_EQUAL(trace.error(), ec::format_error);
+  }
+  MESSAGE("truncated section header");
+  {
+    auto words = shb(28);
+    words.resize(4);
+    auto trace = make(words);
+    REQUIRE(!trace);
+    CHECK_EQUAL(trace.error(), ec::format_error);
+  }
+  MESSAGE("zero-length section header after a valid one");
+  {
+    auto words = shb(28);
+    auto next = shb(0);
+    words.insert(words.end(), next.begin(), next.end());
+    auto trace = unbox(make(words));
+    CHECK_EQUAL(trace.next().error(), ec::format_error);
+  }
+}
+
+FIXTURE_SCOPE_END()
@@ -0,0 +1,81 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE udp_receiver
+
+#include "vast/detail/udp_receiver.hpp"
+
+#include "vast/test/test.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+using namespace vast;
+using namespace std::chrono_literals;
+
+namespace {
+
+void send_datagram(uint16_t port, const std::string& x) {
+  auto fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  REQUIRE(fd >= 0);
+  ::sockaddr_in sa;
+  std::memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  auto sent = ::sendto(fd, x.data(), x.size(), 0,
+                       reinterpret_cast<::sockaddr*>(&sa), sizeof(sa));
+  CHECK_EQUAL(sent, static_cast<ssize_t>(x.size()));
+  ::close(fd);
+}
+
+} // namespace
+
+TEST(newline-delimited batches) {
+  auto opts = detail::udp_receiver::options{4, 16, 8, 0};
+  auto receiver = unbox(detail::udp_receiver::make(0, opts, [] {}));
+  REQUIRE_NOT_EQUAL(receiver->port(), 0u);
+  send_datagram(receiver->port(), "foo");
+  send_datagram(receiver->port(), "bar\n");
+  send_datagram(receiver->port(), "");
+  send_datagram(receiver->port(), "0123456789abcdefXYZ");
+  std::string text;
+  size_t datagrams = 0;
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (datagrams < 4 && std::chrono::steady_clock::now() < deadline) {
+    receiver->consume([&](span<char> batch, size_t n) {
+      text.append(batch.data(), batch.size());
+      datagrams += n;
+    });
+    std::this_thread::sleep_for(1ms);
+  }
+  CHECK_EQUAL(datagrams, 4u);
+  MESSAGE("datagrams get terminated by a newline and truncated at 15 bytes");
+  CHECK_EQUAL(text, "foo\nbar\n\n0123456789abcde\n");
+  auto stats = receiver->stats();
+  CHECK_EQUAL(stats.received, 4u);
+  CHECK_EQUAL(stats.truncated, 1u);
+  CHECK_EQUAL(stats.application_drops, 0u);
+}
+
+TEST(invalid options) {
+  auto opts = detail::udp_receiver::options{0, 16, 8, 0};
+  CHECK(!detail::udp_receiver::make(0, opts, [] {}));
+}
@@ -21,6 +21,7 @@
 #include "vast/fbs/partition.hpp"
 #include "vast/fbs/utils.hpp"
 #include "vast/fbs/uuid.hpp"
+#include "vast/io/read.hpp"
 #include "vast/meta_index.hpp"
 #include "vast/msgpack_table_slice.hpp"
 #include "vast/msgpack_table_slice_builder.hpp"
@@ -30,6 +31,7 @@
 #include "vast/system/index_client_actor.hpp"
 #include "vast/system/partition.hpp"
 #include "vast/system/posix_filesystem.hpp"
+#include "vast/system/predicate_cache.hpp"
 #include "vast/table_slice.hpp"
 #include "vast/table_slice_builder_factory.hpp"
 #include "vast/type.hpp"
@@ -60,7 +62,7 @@ TEST(index roundtrip) {
   vast::system::index_state state(/*self = */ nullptr);
   // The active partition is not supposed to appear in the
   // created flatbuffer
-  state.active_partition.id = vast::uuid::random();
+  state.active_partitions[""].id = vast::uuid::random();
   // Both unpersisted and persisted partitions should show up in the created
   // flatbuffer.
   state.unpersisted[vast::uuid::random()] = nullptr;
@@ -207,11 +209,17 @@ TEST(full partition roundtrip) {
   run();
   persist_promise.receive([](vast::atom::ok) { CHECK("persisting done"); },
                           [](caf::error err) { FAIL(err); });
+  // The serialized indexers get appended to the partition flatbuffer, which
+  // must still verify as a whole.
+  auto bytes = unbox(vast::io::read(directory / persist_path));
+  auto verifier = vast::fbs::make_verifier(span<const byte>{bytes});
+  CHECK(vast::fbs::VerifyPartitionBuffer(verifier));
   self->send_exit(partition, caf::exit_reason::user_shutdown);
   // Spawn a read-only partition from this chunk and try to query the data we
   // added. We make two queries, one "#type"-query and one "normal" query
+  auto cache = std::make_shared<vast::system::predicate_cache>(1'048'576);
   auto readonly_partition = sys.spawn(vast::system::passive_partition,
-                                      partition_uuid, fs, persist_path);
+                                      partition_uuid, fs, persist_path, cache);
   REQUIRE(readonly_partition);
   run();
   // A minimal `partition_client_actor`that stores the results in a local
@@ -257,6 +265,16 @@ TEST(full partition roundtrip) {
   test_expression(type_equals_y, 1);
   // For the query `#type == "foo"`, we expect no results.
   test_expression(type_equals_foo, 0);
+  // Connectives combine the results of their operands.
+  test_expression(vast::conjunction{type_equals_y, x_equals_zero}, 1);
+  test_expression(vast::conjunction{x_equals_one, type_equals_y}, 0);
+  test_expression(vast::disjunction{x_equals_one, type_equals_y}, 1);
+  test_expression(vast::negation{x_equals_zero}, 0);
+  // Repeated predicates on value indexes are answered from the cache.
+  auto misses = cache->stats().misses;
+  test_expression(x_equals_zero, 1);
+  CHECK_GREATER(cache->stats().hits, 0u);
+  CHECK_EQUAL(cache->stats().misses, misses);
   // Shut down test actors.
   self->send_exit(readonly_partition, caf::exit_reason::user_shutdown);
   self->send_exit(fs, caf::exit_reason::user_shutdown);
@@ -30,8 +30,10 @@
 #  include "vast/defaults.hpp"
 #  include "vast/detail/make_io_stream.hpp"
 #  include "vast/detail/narrow.hpp"
+#  include "vast/detail/posix.hpp"
 #  include "vast/table_slice.hpp"
 
+#  include <caf/settings.hpp>
 #  include <caf/sum_type.hpp>
 
 #  include <arrow/api.h>
@@ -40,6 +42,11 @@
 
 #  include <utility>
 
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+
 using caf::get;
 
 using namespace std::chrono;
@@ -94,6 +101,48 @@ TEST(arrow batch) {
   CHECK_EQUAL(slice_id, zeek_conn_log.size());
 }
 
+TEST(arrow batch in shared memory) {
+  auto socket_path = "vast-unit-test-arrow.sock"s;
+  auto server = detail::uds_listen(socket_path);
+  REQUIRE_GREATER_EQUAL(server, 0);
+  caf::settings options;
+  caf::put(options, "vast.export.arrow.shared-memory", socket_path);
+  format::arrow::writer writer{options};
+  auto consumer = detail::uds_accept(server);
+  REQUIRE_GREATER_EQUAL(consumer, 0);
+  auto& slice = zeek_conn_log[0];
+  REQUIRE_EQUAL(writer.write(slice), caf::none);
+  auto fd = detail::uds_recv_fd(consumer);
+  REQUIRE_GREATER_EQUAL(fd, 0);
+#  if VAST_LINUX
+  MESSAGE("the writer seals the shared memory");
+  auto seals = ::fcntl(fd, F_GET_SEALS);
+  CHECK_NOT_EQUAL(seals & F_SEAL_WRITE, 0);
+  CHECK_NOT_EQUAL(seals & F_SEAL_SHRINK, 0);
+#  endif
+  MESSAGE("map the shared memory and read the batch in place");
+  struct ::stat st;
+  REQUIRE_EQUAL(::fstat(fd, &st), 0);
+  auto size = detail::narrow_cast<size_t>(st.st_size);
+  auto addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  REQUIRE(addr != MAP_FAILED);
+  auto buf = std::make_shared<arrow::Buffer>(static_cast<const uint8_t*>(addr),
+                                             st.st_size);
+  arrow::io::BufferReader input_stream{buf};
+  auto reader_result = arrow::ipc::RecordBatchStreamReader::Open(&input_stream);
+  REQUIRE_OK(reader_result);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  REQUIRE_OK((*reader_result)->ReadNext(&batch));
+  REQUIRE(batch != nullptr);
+  CHECK(batch->schema()->Equals(*make_arrow_schema(slice.layout())));
+  CHECK_EQUAL(arrow_table_slice_builder::create(*batch, slice.layout()), slice);
+  ::munmap(addr, size);
+  ::close(fd);
+  ::close(consumer);
+  ::close(server);
+  ::unlink(socket_path.c_str());
+}
+
 FIXTURE_SCOPE_END()
 
 #endif // VAST_ENABLE_ARROW
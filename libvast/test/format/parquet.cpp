@@ -0,0 +1,97 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#include "vast/config.hpp"
+
+#if VAST_ENABLE_PARQUET
+
+#  define SUITE format
+
+#  include "vast/format/parquet.hpp"
+
+#  include "vast/test/fixtures/events.hpp"
+#  include "vast/test/fixtures/filesystem.hpp"
+#  include "vast/test/test.hpp"
+
+#  include "vast/data.hpp"
+#  include "vast/table_slice.hpp"
+
+#  include <caf/settings.hpp>
+
+#  include <fstream>
+#  include <limits>
+
+using namespace vast;
+
+namespace {
+
+struct fixture : fixtures::events, fixtures::filesystem {};
+
+} // namespace
+
+FIXTURE_SCOPE(parquet_tests, fixture)
+
+TEST(parquet roundtrip) {
+  caf::settings options;
+  caf::put(options, "vast.export.parquet.write", directory.str());
+  caf::put(options, "vast.export.parquet.row-group-size", 5000);
+  {
+    format::parquet::writer writer{options};
+    for (auto& slice : zeek_conn_log)
+      REQUIRE_EQUAL(writer.write(slice), caf::none);
+  }
+  auto filename = directory / "zeek.conn.parquet";
+  REQUIRE(exists(filename));
+  caf::put(options, "vast.import.parquet.read", filename.str());
+  format::parquet::reader reader{
+    options, std::make_unique<std::ifstream>(filename.str())};
+  std::vector<table_slice> slices;
+  auto add_slice = [&](table_slice x) { slices.push_back(std::move(x)); };
+  auto [err, produced] = reader.read(std::numeric_limits<size_t>::max(), 100,
+                                     add_slice);
+  CHECK_EQUAL(err, ec::end_of_input);
+  size_t rows = 0;
+  for (auto& slice : zeek_conn_log)
+    rows += slice.rows();
+  REQUIRE_EQUAL(produced, rows);
+  CHECK_EQUAL(slices.front().layout(), zeek_conn_log.front().layout());
+  // Row groups and record batches do not line up with the original slices,
+  // so we compare row by row.
+  auto actual = slices.begin();
+  size_t actual_row = 0;
+  for (auto& expected : zeek_conn_log) {
+    for (size_t row = 0; row < expected.rows(); ++row) {
+      if (actual_row == actual->rows()) {
+        ++actual;
+        actual_row = 0;
+      }
+      CHECK_LESS_EQUAL(actual->rows(), 100u);
+      for (size_t column = 0; column < expected.columns(); ++column)
+        CHECK_EQUAL(materialize(actual->at(actual_row, column)),
+                    materialize(expected.at(row, column)));
+      ++actual_row;
+    }
+  }
+}
+
+TEST(parquet invalid compression) {
+  caf::settings options;
+  caf::put(options, "vast.export.parquet.write", directory.str());
+  caf::put(options, "vast.export.parquet.compression", "zip");
+  format::parquet::writer writer{options};
+  CHECK(writer.write(zeek_conn_log.front()));
+}
+
+FIXTURE_SCOPE_END()
+
+#endif // VAST_ENABLE_PARQUET
@@ -11,7 +11,10 @@
  * contained in the LICENSE file.                                             *
  ******************************************************************************/
 
+#include "vast/defaults.hpp"
 #include "vast/detail/string.hpp"
+#include "vast/table_slice_builder_factory.hpp"
+#include "vast/type.hpp"
 
 #include "vast/format/ascii.hpp"
 #include "vast/format/csv.hpp"
@@ -25,6 +28,7 @@
 
 using namespace vast;
 using namespace std::string_literals;
+using namespace std::string_view_literals;
 
 FIXTURE_SCOPE(ascii_tests, fixtures::events)
 
@@ -37,6 +41,10 @@ auto first_csv_http_log_line = "type,ts,uid,id.orig_h,id.orig_p,id.resp_h,id.res
 
 auto last_csv_http_log_line = R"__(zeek.http,2009-11-19T07:17:28.829955072,"rydI6puScNa",192.168.1.104,1224,87.106.66.233,80,1,"POST","87.106.66.233","/rpc.html?e=bl",,"SCSDK-6.0.0",1064,96,200,"OK",100,"Continue",,"",,,,"application/octet-stream",,)__";
 
+auto nested_json_line = R"__({"id": 42, "x": {"msg": "say \"hi\" \\ back\n\tslash", "odd \"name\"": "0123456789abcdef\u0001\u007F tail"}})__";
+
+auto flattened_json_line = R"__({"id": 42, "x.msg": "say \"hi\" \\ back\n\tslash", "x.odd \"name\"": "0123456789abcdef\u0001\u007F tail"})__";
+
 auto first_zeek_conn_log_line = R"__({"ts": "2009-11-18T08:00:21.486539008", "uid": "Pii6cUUq1v4", "id.orig_h": "192.168.1.102", "id.orig_p": 68, "id.resp_h": "192.168.1.1", "id.resp_p": 67, "proto": "udp", "service": null, "duration": "163.82ms", "orig_bytes": 301, "resp_bytes": 300, "conn_state": "SF", "local_orig": null, "missed_bytes": 0, "history": "Dd", "orig_pkts": 1, "orig_ip_bytes": 329, "resp_pkts": 1, "resp_ip_bytes": 328, "tunnel_parents": []})__";
 // clang-format on
 
@@ -75,4 +83,36 @@ TEST(JSON writer) {
   CHECK_EQUAL(lines.front(), first_zeek_conn_log_line);
 }
 
+TEST(JSON writer - nested records and escaping) {
+  auto layout = record_type{
+    {"id", count_type{}},
+    {"x", record_type{
+            {"msg", string_type{}},
+            {"odd \"name\"", string_type{}},
+          }},
+  }.name("test.nested");
+  auto builder = factory<table_slice_builder>::make(
+    defaults::import::table_slice_type, layout);
+  REQUIRE(builder);
+  REQUIRE(builder->add(make_data_view(count{42})));
+  REQUIRE(builder->add(make_data_view("say \"hi\" \\ back\n\tslash"sv)));
+  // The escaped characters follow a full 16-byte block of clean characters.
+  REQUIRE(builder->add(make_data_view("0123456789abcdef\x01\x7f tail"sv)));
+  auto slice = builder->finish();
+  REQUIRE_NOT_EQUAL(slice.encoding(), table_slice_encoding::none);
+  auto to_json = [&](bool flat) {
+    std::string str;
+    caf::containerbuf<std::string> sb{str};
+    caf::settings options;
+    caf::put(options, "vast.export.json.flatten", flat);
+    format::json::writer writer{std::make_unique<std::ostream>(&sb), options};
+    if (auto err = writer.write(slice))
+      FAIL("failed to write event");
+    writer.flush();
+    return str;
+  };
+  CHECK_EQUAL(to_json(false), nested_json_line + "\n"s);
+  CHECK_EQUAL(to_json(true), flattened_json_line + "\n"s);
+}
+
 FIXTURE_SCOPE_END()
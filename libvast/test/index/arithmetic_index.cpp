@@ -157,4 +157,69 @@ TEST(none values - arithmetic) {
   CHECK_EQUAL(to_string(unbox(bm)), "00100");
 }
 
+TEST(bitslice) {
+  auto t = integer_type{}.attributes({{"index", "bitslice"}});
+  auto idx = factory<value_index>::make(t, caf::settings{});
+  REQUIRE(idx != nullptr);
+  using bitslice_index = arithmetic_index<integer, void, bitslice_coder<ids>>;
+  CHECK(dynamic_cast<bitslice_index*>(idx.get()) != nullptr);
+  auto reference = factory<value_index>::make(integer_type{}, caf::settings{});
+  REQUIRE(reference != nullptr);
+  auto xs = std::vector<integer>{-1000, 42, 0, -1, 7, 42, 1337, -43, 8, 0};
+  for (auto x : xs) {
+    REQUIRE(idx->append(make_data_view(x)));
+    REQUIRE(reference->append(make_data_view(x)));
+  }
+  REQUIRE(idx->append(make_data_view(caf::none)));
+  REQUIRE(reference->append(make_data_view(caf::none)));
+  MESSAGE("compare with the range-coded index");
+  auto ops = {less, less_equal, equal, not_equal, greater_equal, greater};
+  for (auto op : ops)
+    for (auto x : {integer{-1001}, integer{-1000}, integer{-43}, integer{-1},
+                   integer{0}, integer{1}, integer{42}, integer{1337},
+                   integer{1338}}) {
+      auto result = unbox(idx->lookup(op, make_data_view(x)));
+      CHECK_EQUAL(result, unbox(reference->lookup(op, make_data_view(x))));
+    }
+  auto result = idx->lookup(less, make_data_view(integer{0}));
+  CHECK_EQUAL(to_string(unbox(result)), "10010001000");
+  MESSAGE("serialization");
+  std::vector<char> buf;
+  CHECK_EQUAL(detail::serialize(buf, idx), caf::none);
+  value_index_ptr idx2;
+  REQUIRE_EQUAL(detail::deserialize(buf, idx2), caf::none);
+  result = idx2->lookup(greater, make_data_view(integer{7}));
+  CHECK_EQUAL(to_string(unbox(result)), "01000110100");
+}
+
+TEST(membership) {
+  auto idx = arithmetic_index<count>{count_type{}};
+  for (auto x : {1, 5, 2, 9, 3, 7})
+    REQUIRE(idx.append(make_data_view(count(x))));
+  REQUIRE(idx.append(make_data_view(caf::none)));
+  REQUIRE(idx.append(make_data_view(count{4})));
+  REQUIRE(idx.append(make_data_view(count{100})));
+  auto xs = list{count{4}, count{2}, count{9}, count{3},
+                 caf::none, count{42}, count{3}};
+  auto expected = ids{};
+  for (auto& x : xs)
+    if (!caf::holds_alternative<caf::none_t>(x))
+      expected |= unbox(idx.lookup(equal, make_data_view(x)));
+  auto result = unbox(idx.lookup(in, make_data_view(xs)));
+  CHECK_EQUAL(result, expected);
+  CHECK_EQUAL(to_string(result), "001110010");
+  result = unbox(idx.lookup(not_in, make_data_view(xs)));
+  CHECK_EQUAL(to_string(result), "110001001");
+  MESSAGE("binned values");
+  auto ts = arithmetic_index<vast::time>{time_type{}};
+  for (auto x : {"2014-01-16+05:30:15", "2014-01-16+05:30:16",
+                 "2014-01-16+05:30:18", "2014-01-16+05:30:20"})
+    REQUIRE(ts.append(make_data_view(unbox(to<vast::time>(x)))));
+  auto ys = list{unbox(to<vast::time>("2014-01-16+05:30:16")),
+                 unbox(to<vast::time>("2014-01-16+05:30:15")),
+                 unbox(to<vast::time>("2014-01-16+05:30:20"))};
+  result = unbox(ts.lookup(in, make_data_view(ys)));
+  CHECK_EQUAL(to_string(result), "1101");
+}
+
 FIXTURE_SCOPE_END()
@@ -48,6 +48,11 @@ TEST(string) {
   result = idx.lookup(not_equal, make_data_view("foo"));
   REQUIRE(result);
   CHECK_EQUAL(to_string(unbox(result)), "01101000101");
+  auto xs = list{"foo", "baz"};
+  result = idx.lookup(in, make_data_view(xs));
+  CHECK_EQUAL(to_string(unbox(result)), "10110000010");
+  result = idx.lookup(not_in, make_data_view(xs));
+  CHECK_EQUAL(to_string(unbox(result)), "01000000100");
 }
 
 TEST(serialization) {
@@ -15,6 +15,8 @@
 
 #include "vast/index/list_index.hpp"
 
+#include "vast/index/inverted_index.hpp"
+
 #include "vast/test/test.hpp"
 
 #include "vast/concept/printable/to_string.hpp"
@@ -25,6 +27,8 @@
 
 #include <caf/test/dsl.hpp>
 
+#include <limits>
+
 using namespace vast;
 using namespace std::string_literals;
 
@@ -69,4 +73,66 @@ TEST(list) {
   CHECK_EQUAL(to_string(*idx2.lookup(ni, make_data_view(x))), "11000000");
 }
 
+TEST(inverted list) {
+  auto container_type
+    = list_type{string_type{}}.attributes({{"index", "inverted"}});
+  auto idx = factory<value_index>::make(container_type, caf::settings{});
+  REQUIRE(idx != nullptr);
+  CHECK(dynamic_cast<inverted_index*>(idx.get()) != nullptr);
+  MESSAGE("append");
+  list xs{"foo", "bar", "foo"};
+  REQUIRE(idx->append(make_data_view(xs)));
+  xs = {"qux", "foo", "baz", "corge"};
+  REQUIRE(idx->append(make_data_view(xs)));
+  xs = {"bar"};
+  REQUIRE(idx->append(make_data_view(xs)));
+  REQUIRE(idx->append(make_data_view(caf::none)));
+  REQUIRE(idx->append(make_data_view(xs), 7));
+  MESSAGE("lookup");
+  auto x = "foo"s;
+  CHECK_EQUAL(to_string(*idx->lookup(ni, make_data_view(x))), "11000000");
+  CHECK_EQUAL(to_string(*idx->lookup(not_ni, make_data_view(x))), "00100001");
+  x = "bar";
+  CHECK_EQUAL(to_string(*idx->lookup(ni, make_data_view(x))), "10100001");
+  x = "not";
+  CHECK_EQUAL(to_string(*idx->lookup(ni, make_data_view(x))), "00000000");
+  CHECK(!idx->lookup(equal, make_data_view(x)));
+  MESSAGE("serialization");
+  std::vector<char> buf;
+  CHECK_EQUAL(detail::serialize(buf, idx), caf::none);
+  value_index_ptr idx2;
+  CHECK_EQUAL(detail::deserialize(buf, idx2), caf::none);
+  REQUIRE(idx2 != nullptr);
+  x = "foo";
+  CHECK_EQUAL(to_string(*idx2->lookup(ni, make_data_view(x))), "11000000");
+}
+
+TEST(inverted list with numbers) {
+  auto container_type
+    = list_type{integer_type{}}.attributes({{"index", "inverted"}});
+  auto idx = factory<value_index>::make(container_type, caf::settings{});
+  REQUIRE(idx != nullptr);
+  CHECK(dynamic_cast<inverted_index*>(idx.get()) != nullptr);
+  list xs{integer{1}, integer{-2}};
+  REQUIRE(idx->append(make_data_view(xs)));
+  xs = {integer{5}};
+  REQUIRE(idx->append(make_data_view(xs)));
+  MESSAGE("numbers convert to the element type");
+  auto lookup = [&](auto x) {
+    return to_string(unbox(idx->lookup(ni, make_data_view(x))));
+  };
+  CHECK_EQUAL(lookup(integer{1}), "10");
+  CHECK_EQUAL(lookup(count{1}), "10");
+  CHECK_EQUAL(lookup(count{5}), "01");
+  CHECK_EQUAL(lookup(real{-2.0}), "10");
+  CHECK_EQUAL(lookup(real{1.5}), "00");
+  CHECK_EQUAL(lookup(count{std::numeric_limits<count>::max()}), "00");
+  MESSAGE("lists of complex types fall back to the list index");
+  auto nested = list_type{list_type{string_type{}}}.attributes(
+    {{"index", "inverted"}});
+  auto fallback = factory<value_index>::make(nested, caf::settings{});
+  REQUIRE(fallback != nullptr);
+  CHECK(dynamic_cast<inverted_index*>(fallback.get()) == nullptr);
+}
+
 FIXTURE_SCOPE_END()
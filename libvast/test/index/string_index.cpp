@@ -109,6 +109,26 @@ TEST(string) {
   CHECK_EQUAL(to_string(unbox(result)), "0100010000");
 }
 
+TEST(string membership) {
+  string_index idx{string_type{}};
+  auto strings = std::vector<std::string>{"foo",  "foobar", "fo",  "bar",
+                                          "barn", "",       "baz", "foo",
+                                          "f",    "qux"};
+  for (auto& x : strings)
+    REQUIRE(idx.append(make_data_view(x)));
+  auto xs = list{"foo", "fo", "barn", "baz", "fob", "foo", ""};
+  auto expected = ids{};
+  for (auto& x : xs)
+    expected |= unbox(idx.lookup(equal, make_data_view(x)));
+  auto result = idx.lookup(in, make_data_view(xs));
+  CHECK_EQUAL(unbox(result), expected);
+  CHECK_EQUAL(to_string(unbox(result)), "1010111100");
+  result = idx.lookup(not_in, make_data_view(xs));
+  CHECK_EQUAL(to_string(unbox(result)), "0101000011");
+  result = idx.lookup(in, make_data_view(list{}));
+  CHECK_EQUAL(to_string(unbox(result)), "0000000000");
+}
+
 TEST(none values - string) {
   auto idx = factory<value_index>::make(string_type{}, caf::settings{});
   REQUIRE_NOT_EQUAL(idx, nullptr);
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE value_index
+
+#include "vast/index/time_index.hpp"
+
+#include "vast/test/test.hpp"
+
+#include "vast/concept/printable/to_string.hpp"
+#include "vast/concept/printable/vast/bitmap.hpp"
+#include "vast/detail/deserialize.hpp"
+#include "vast/detail/serialize.hpp"
+#include "vast/value_index_factory.hpp"
+
+#include <caf/test/dsl.hpp>
+
+using namespace vast;
+using namespace std::chrono_literals;
+
+TEST(sorted time) {
+  factory<value_index>::initialize();
+  auto t = time_type{}.attributes({{"index", "sorted"}});
+  auto idx = factory<value_index>::make(t, caf::settings{});
+  REQUIRE(idx != nullptr);
+  CHECK(dynamic_cast<time_index*>(idx.get()) != nullptr);
+  auto reference = factory<value_index>::make(time_type{}, caf::settings{});
+  REQUIRE(reference != nullptr);
+  auto epoch = time{};
+  auto append = [&](auto x, id pos) {
+    REQUIRE(idx->append(make_data_view(x), pos));
+    REQUIRE(reference->append(make_data_view(x), pos));
+  };
+  // Mostly ordered values with a few outliers, a nil, and a gap.
+  auto xs = std::vector<time>{epoch + 1s, epoch + 2s, epoch + 2s, epoch + 5s,
+                              epoch + 3s, epoch + 4s};
+  for (size_t i = 0; i < xs.size(); ++i)
+    append(xs[i], i);
+  append(caf::none, 6);
+  append(epoch + 8s, 7);
+  append(epoch + 9s, 10);
+  append(epoch + 9s, 11);
+  MESSAGE("compare with the range-coded index");
+  auto ops = {less, less_equal, equal, not_equal, greater_equal, greater};
+  for (auto op : ops)
+    for (auto x : {0s, 1s, 2s, 3s, 4s, 5s, 6s, 8s, 9s, 10s}) {
+      auto result = unbox(idx->lookup(op, make_data_view(epoch + x)));
+      CHECK_EQUAL(result,
+                  unbox(reference->lookup(op, make_data_view(epoch + x))));
+    }
+  auto result = idx->lookup(less, make_data_view(epoch + 4s));
+  CHECK_EQUAL(to_string(unbox(result)), "111010000000");
+  result = idx->lookup(greater_equal, make_data_view(epoch + 5s));
+  CHECK_EQUAL(to_string(unbox(result)), "000100010011");
+  MESSAGE("invalid operator");
+  CHECK(!idx->lookup(match, make_data_view(epoch)));
+  MESSAGE("serialization");
+  std::vector<char> buf;
+  CHECK_EQUAL(detail::serialize(buf, idx), caf::none);
+  value_index_ptr idx2;
+  REQUIRE_EQUAL(detail::deserialize(buf, idx2), caf::none);
+  CHECK(dynamic_cast<time_index*>(idx2.get()) != nullptr);
+  result = idx2->lookup(equal, make_data_view(epoch + 9s));
+  CHECK_EQUAL(to_string(unbox(result)), "000000000011");
+}
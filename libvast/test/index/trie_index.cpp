@@ -0,0 +1,149 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE value_index
+
+#include "vast/index/trie_index.hpp"
+
+#include "vast/test/test.hpp"
+
+#include "vast/concept/parseable/to.hpp"
+#include "vast/concept/parseable/vast/address.hpp"
+#include "vast/concept/parseable/vast/subnet.hpp"
+#include "vast/concept/printable/to_string.hpp"
+#include "vast/concept/printable/vast/bitmap.hpp"
+#include "vast/detail/deserialize.hpp"
+#include "vast/detail/serialize.hpp"
+#include "vast/subnet.hpp"
+
+#include <caf/test/dsl.hpp>
+
+using namespace vast;
+using namespace std::string_literals;
+
+TEST(trie address) {
+  trie_index idx{address_type{}};
+  MESSAGE("append");
+  for (auto str : {"192.168.0.1", "192.168.0.2", "192.168.0.3", "192.168.0.1",
+                   "192.168.0.1", "192.168.0.2", "192.168.0.128",
+                   "192.168.0.130", "192.168.0.240", "192.168.0.127",
+                   "192.168.0.33"})
+    REQUIRE(idx.append(make_data_view(unbox(to<address>(str)))));
+  MESSAGE("address equality");
+  auto x = unbox(to<address>("192.168.0.1"));
+  auto bm = idx.lookup(equal, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "10011000000");
+  bm = idx.lookup(not_equal, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "01100111111");
+  x = unbox(to<address>("192.168.0.5"));
+  CHECK_EQUAL(to_string(unbox(idx.lookup(equal, make_data_view(x)))),
+              "00000000000");
+  MESSAGE("invalid operator");
+  CHECK(!idx.lookup(match, make_data_view(x)));
+  CHECK(!idx.lookup(in, make_data_view(x)));
+  MESSAGE("prefix membership");
+  auto y = subnet{unbox(to<address>("192.168.0.128")), 25};
+  bm = idx.lookup(in, make_data_view(y));
+  CHECK_EQUAL(to_string(unbox(bm)), "00000011100");
+  bm = idx.lookup(not_in, make_data_view(y));
+  CHECK_EQUAL(to_string(unbox(bm)), "11111100011");
+  y = {unbox(to<address>("192.168.0.0")), 24};
+  bm = idx.lookup(in, make_data_view(y));
+  CHECK_EQUAL(to_string(unbox(bm)), "11111111111");
+  y = {unbox(to<address>("192.168.0.64")), 26};
+  bm = idx.lookup(not_in, make_data_view(y));
+  CHECK_EQUAL(to_string(unbox(bm)), "11111111101");
+  y = unbox(to<subnet>("10.0.0.0/8"));
+  bm = idx.lookup(in, make_data_view(y));
+  CHECK_EQUAL(to_string(unbox(bm)), "00000000000");
+  y = unbox(to<subnet>("::/0"));
+  bm = idx.lookup(in, make_data_view(y));
+  CHECK_EQUAL(to_string(unbox(bm)), "11111111111");
+  auto xs = list{unbox(to<address>("192.168.0.1")),
+                 unbox(to<address>("192.168.0.2")),
+                 unbox(to<address>("10.0.0.1"))};
+  CHECK_EQUAL(to_string(unbox(idx.lookup(in, make_data_view(xs)))),
+              "11011100000");
+  MESSAGE("gaps");
+  x = unbox(to<address>("192.168.0.2"));
+  REQUIRE(idx.append(make_data_view(x), 42));
+  auto str = "01000100000"s + std::string(42 - 11, '0') + '1';
+  CHECK_EQUAL(to_string(unbox(idx.lookup(equal, make_data_view(x)))), str);
+  MESSAGE("serialization");
+  std::vector<char> buf;
+  CHECK_EQUAL(detail::serialize(buf, idx), caf::none);
+  trie_index idx2{address_type{}};
+  CHECK_EQUAL(detail::deserialize(buf, idx2), caf::none);
+  CHECK_EQUAL(to_string(unbox(idx2.lookup(equal, make_data_view(x)))), str);
+}
+
+TEST(trie subnet) {
+  trie_index idx{subnet_type{}};
+  auto s0 = unbox(to<subnet>("192.168.0.0/24"));
+  auto s1 = unbox(to<subnet>("192.168.1.0/24"));
+  auto s2 = unbox(to<subnet>("fe80::/10"));
+  MESSAGE("append");
+  for (auto& x : {s0, s1, s0, s0, s2, s2})
+    REQUIRE(idx.append(make_data_view(x)));
+  MESSAGE("address lookup (ni)");
+  auto a = unbox(to<address>("192.168.0.1"));
+  auto bm = idx.lookup(ni, make_data_view(a));
+  CHECK_EQUAL(to_string(unbox(bm)), "101100");
+  a = unbox(to<address>("192.168.1.42"));
+  bm = idx.lookup(ni, make_data_view(a));
+  CHECK_EQUAL(to_string(unbox(bm)), "010000");
+  a = unbox(to<address>("feff::"));
+  bm = idx.lookup(ni, make_data_view(a));
+  CHECK_EQUAL(to_string(unbox(bm)), "000000");
+  a = unbox(to<address>("fe80::aaaa"));
+  bm = idx.lookup(not_ni, make_data_view(a));
+  CHECK_EQUAL(to_string(unbox(bm)), "111100");
+  MESSAGE("equality lookup");
+  bm = idx.lookup(equal, make_data_view(s0));
+  CHECK_EQUAL(to_string(unbox(bm)), "101100");
+  bm = idx.lookup(not_equal, make_data_view(s1));
+  CHECK_EQUAL(to_string(unbox(bm)), "101111");
+  MESSAGE("subset lookup (in)");
+  auto x = unbox(to<subnet>("192.168.0.0/23"));
+  bm = idx.lookup(in, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "111100");
+  x = unbox(to<subnet>("192.168.0.0/25"));
+  bm = idx.lookup(in, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "000000");
+  MESSAGE("superset lookup (ni)");
+  bm = idx.lookup(ni, make_data_view(s0));
+  CHECK_EQUAL(to_string(unbox(bm)), "101100");
+  x = unbox(to<subnet>("192.168.1.128/25"));
+  bm = idx.lookup(ni, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "010000");
+  x = unbox(to<subnet>("192.0.0.0/8"));
+  bm = idx.lookup(ni, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "000000");
+  MESSAGE("nested subnets");
+  REQUIRE(idx.append(make_data_view(unbox(to<subnet>("192.168.0.0/16")))));
+  a = unbox(to<address>("192.168.0.1"));
+  bm = idx.lookup(ni, make_data_view(a));
+  CHECK_EQUAL(to_string(unbox(bm)), "1011001");
+  x = unbox(to<subnet>("192.168.0.0/16"));
+  bm = idx.lookup(in, make_data_view(x));
+  CHECK_EQUAL(to_string(unbox(bm)), "1111001");
+  auto xs = list{s0, s1};
+  CHECK_EQUAL(to_string(unbox(idx.lookup(in, make_data_view(xs)))), "1111000");
+  MESSAGE("serialization");
+  std::vector<char> buf;
+  CHECK_EQUAL(detail::serialize(buf, idx), caf::none);
+  trie_index idx2{subnet_type{}};
+  CHECK_EQUAL(detail::deserialize(buf, idx2), caf::none);
+  bm = idx2.lookup(ni, make_data_view(a));
+  CHECK_EQUAL(to_string(unbox(bm)), "1011001");
+}
@@ -213,6 +213,28 @@ TEST(attribute extractor - type) {
   CHECK_EQUAL(lookup("#type !~ /x/"), ids);
 }
 
+TEST(estimate) {
+  auto estimate = [&](std::string_view expr) {
+    return meta_idx.estimate(unbox(to<expression>(expr)));
+  };
+  using bounds = std::pair<uint64_t, uint64_t>;
+  MESSAGE("type queries are exact");
+  CHECK_EQUAL(estimate("#type == \"foo\""), bounds(50, 50));
+  CHECK_EQUAL(estimate("#type != \"foo\""), bounds(50, 50));
+  CHECK_EQUAL(estimate("#type == \"bar\""), bounds(0, 0));
+  MESSAGE("time ranges that cover entire partitions are exact");
+  CHECK_EQUAL(estimate("#timestamp >= 1970-01-01+00:00:50.0"), bounds(50, 50));
+  CHECK_EQUAL(estimate("#timestamp < 1970-01-01+00:00:25.0"), bounds(25, 25));
+  MESSAGE("partially covered partitions widen the bounds");
+  CHECK_EQUAL(estimate("#timestamp >= 1970-01-01+00:00:10.0 && "
+                       "#timestamp <= 1970-01-01+00:00:30.0"),
+              bounds(0, 50));
+  CHECK_EQUAL(estimate("#type == \"foo\" || "
+                       "#timestamp >= 1970-01-01+00:01:30.0"),
+              bounds(50, 75));
+  CHECK_EQUAL(estimate("content == \"foo\""), bounds(0, 100));
+}
+
 TEST(meta index with bool synopsis) {
   MESSAGE("generate slice data and add it to the meta index");
   meta_index meta_idx;
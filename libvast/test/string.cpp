@@ -96,6 +96,21 @@ TEST(JSON string escaping) {
   CHECK_EQUAL(json_unescape("\"Hello®, world!\""), "Hello®, world!");
 }
 
+TEST(JSON escape search) {
+  auto str = std::string(100, 'x');
+  CHECK_EQUAL(find_json_escape(str), std::string::npos);
+  CHECK_EQUAL(find_json_escape("®\xFF"), std::string::npos);
+  // Hit every position relative to 16 byte blocks.
+  for (auto c : {'"', '\\', '\n', '\x01', '\x1f', '\x7f'}) {
+    for (size_t i = 0; i < str.size(); ++i) {
+      auto copy = str;
+      copy[i] = c;
+      CHECK_EQUAL(find_json_escape(copy), i);
+      CHECK_EQUAL(find_json_escape(copy, i + 1), std::string::npos);
+    }
+  }
+}
+
 TEST(percent escaping) {
   CHECK_EQUAL(percent_escape(""), "");
   CHECK_EQUAL(percent_unescape(""), "");
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE async_filesystem
+
+#include "vast/system/async_filesystem.hpp"
+
+#include "vast/test/fixtures/actor_system.hpp"
+#include "vast/test/test.hpp"
+
+#include "vast/chunk.hpp"
+#include "vast/io/read.hpp"
+
+#include <string>
+
+using namespace vast;
+using namespace vast::system;
+using namespace std::string_literals;
+
+namespace {
+
+struct fixture : fixtures::deterministic_actor_system {
+  fixture() {
+    auto config = async_filesystem_config{};
+    config.threads = 2;
+    config.queue_depth = 1;
+    config.sync = async_filesystem_config::sync_policy::full;
+    filesystem
+      = self->spawn<caf::detached>(async_filesystem, directory, config);
+  }
+
+  ~fixture() {
+    self->send_exit(filesystem, caf::exit_reason::user_shutdown);
+  }
+
+  filesystem_actor filesystem;
+};
+
+} // namespace
+
+FIXTURE_SCOPE(async_filesystem_tests, fixture)
+
+TEST(write and read) {
+  MESSAGE("issue more writes than the I/O threads accept at once");
+  for (auto i = 0; i < 5; ++i) {
+    auto name = "file-"s + std::to_string(i);
+    auto copy = name;
+    self->send(filesystem, atom::write_v, path{name},
+               chunk::make(std::move(copy)));
+  }
+  for (auto i = 0; i < 5; ++i)
+    self->receive([](atom::ok) {}, [](const caf::error& err) { FAIL(err); });
+  MESSAGE("read the files back");
+  for (auto i = 0; i < 5; ++i) {
+    auto name = "file-"s + std::to_string(i);
+    auto bytes = span<const char>{name.data(), name.size()};
+    CHECK_EQUAL(span<const byte>{unbox(io::read(directory / name))},
+                as_bytes(bytes));
+    self->request(filesystem, caf::infinite, atom::read_v, path{name})
+      .receive(
+        [&](const chunk_ptr& chk) {
+          CHECK_EQUAL(as_bytes(chk), as_bytes(bytes));
+        },
+        [](const caf::error& err) { FAIL(err); });
+  }
+}
+
+TEST(writes to the same file) {
+  MESSAGE("issue back-to-back writes to one file");
+  auto contents = [](int i) { return "version "s + std::to_string(i); };
+  for (auto i = 0; i < 10; ++i)
+    self->send(filesystem, atom::write_v, path{"index.bin"},
+               chunk::make(contents(i)));
+  for (auto i = 0; i < 10; ++i)
+    self->receive([](atom::ok) {}, [](const caf::error& err) { FAIL(err); });
+  MESSAGE("the last write wins");
+  auto last = contents(9);
+  auto bytes = span<const char>{last.data(), last.size()};
+  CHECK_EQUAL(span<const byte>{unbox(io::read(directory / "index.bin"))},
+              as_bytes(bytes));
+  CHECK(!exists(directory / "index.bin.tmp"));
+}
+
+TEST(status) {
+  self->request(filesystem, caf::infinite, atom::read_v, path{"not-there"})
+    .receive(
+      [&](const chunk_ptr&) { FAIL("should not receive chunk on failure"); },
+      [&](const caf::error&) {
+        // expected
+      });
+  self
+    ->request(filesystem, caf::infinite, atom::status_v,
+              status_verbosity::debug)
+    .receive(
+      [&](const caf::dictionary<caf::config_value>& status) {
+        CHECK_EQUAL(caf::get<uint64_t>(status, "filesystem.threads"), 2u);
+        auto failed
+          = caf::get<uint64_t>(status, "filesystem.operations.reads.failed");
+        CHECK_EQUAL(failed, 1u);
+        auto latency = caf::get_if<caf::settings>(
+          &status, "filesystem.operations.reads.latency");
+        REQUIRE(latency);
+        CHECK_EQUAL(latency->size(), 1u);
+      },
+      [&](const caf::error& err) { FAIL(err); });
+}
+
+TEST(config) {
+  auto opts = caf::settings{};
+  caf::put(opts, "threads", 8);
+  caf::put(opts, "sync", "data");
+  auto config = unbox(to_async_filesystem_config(opts));
+  CHECK_EQUAL(config.threads, 8u);
+  CHECK(config.sync == async_filesystem_config::sync_policy::data);
+  caf::put(opts, "sync", "sometimes");
+  CHECK(!to_async_filesystem_config(opts));
+}
+
+FIXTURE_SCOPE_END()
@@ -47,6 +47,7 @@ namespace {
 
 struct mock_client_state {
   uint64_t count = 0;
+  std::pair<uint64_t, uint64_t> bounds = {};
   bool received_done = false;
   static inline constexpr const char* name = "mock-client";
 };
@@ -58,6 +59,9 @@ caf::behavior mock_client(mock_client_actor* self) {
             CHECK(!self->state.received_done);
             self->state.count += x;
           },
+          [=](atom::estimate, uint64_t lower, uint64_t upper) {
+            self->state.bounds = {lower, upper};
+          },
           [=](atom::done) { self->state.received_done = true; }};
 }
 
@@ -67,7 +71,8 @@ struct fixture : fixtures::deterministic_actor_system_and_events {
     MESSAGE("spawn INDEX ingest 4 slices with 100 rows (= 1 partition) each");
     auto fs = self->spawn(vast::system::posix_filesystem, directory);
     index = self->spawn(system::index, fs, directory / "index",
-                        defaults::import::table_slice_size, 100, 3, 1, 0.01);
+                        defaults::import::table_slice_size, 100, 3, 1, 0.01, 0,
+                        false, duration::zero());
     archive = self->spawn(system::archive, directory / "archive",
                           defaults::system::segments,
                           defaults::system::max_segment_size);
@@ -85,11 +90,11 @@ struct fixture : fixtures::deterministic_actor_system_and_events {
   }
 
   // @pre index != nullptr
-  void spawn_aut(std::string_view query, bool skip_candidate_check) {
+  void spawn_aut(std::string_view query, count_mode mode) {
     if (index == nullptr)
       FAIL("cannot start AUT without INDEX");
     aut = sys.spawn(counter, unbox(to<expression>(query)), index, archive,
-                    skip_candidate_check);
+                    mode);
     run();
     anon_send(aut, atom::run_v, client);
     sched.run_once();
@@ -107,7 +112,7 @@ FIXTURE_SCOPE(counter_tests, fixture)
 
 TEST(count IP point query without candidate check) {
   MESSAGE("spawn the COUNTER for query ':addr == 192.168.1.104'");
-  spawn_aut(":addr == 192.168.1.104", true);
+  spawn_aut(":addr == 192.168.1.104", count_mode::estimate);
   // Once started, the COUNTER reaches out to the INDEX.
   expect((expression), from(aut).to(index));
   run();
@@ -123,7 +128,7 @@ TEST(count IP point query without candidate check) {
 
 TEST(count IP point query with candidate check) {
   MESSAGE("spawn the COUNTER for query ':addr == 192.168.1.104'");
-  spawn_aut(":addr == 192.168.1.104", false);
+  spawn_aut(":addr == 192.168.1.104", count_mode::exact);
   // Once started, the COUNTER reaches out to the INDEX.
   expect((expression), from(aut).to(index));
   run();
@@ -137,4 +142,28 @@ TEST(count IP point query with candidate check) {
   CHECK_EQUAL(client_state.received_done, true);
 }
 
+TEST(approximate type query) {
+  MESSAGE("spawn the COUNTER for query '#type == \"zeek.conn\"'");
+  spawn_aut("#type == \"zeek.conn\"", count_mode::approximate);
+  // The COUNTER only asks the INDEX for an estimate.
+  expect((atom::estimate, expression), from(aut).to(index));
+  run();
+  auto& client_state = deref<mock_client_actor>(client).state;
+  CHECK_EQUAL(client_state.bounds, std::pair(uint64_t{400}, uint64_t{400}));
+  CHECK_EQUAL(client_state.received_done, true);
+}
+
+TEST(approximate IP point query) {
+  MESSAGE("spawn the COUNTER for query ':addr == 192.168.1.104'");
+  spawn_aut(":addr == 192.168.1.104", count_mode::approximate);
+  expect((atom::estimate, expression), from(aut).to(index));
+  run();
+  // The address synopses cannot prove that all events match, but the upper
+  // bound must cover the 133 matching events in the INDEX.
+  auto& [lower, upper] = deref<mock_client_actor>(client).state.bounds;
+  CHECK_EQUAL(lower, 0u);
+  CHECK_GREATER_EQUAL(upper, 133u);
+  CHECK_LESS_EQUAL(upper, 400u);
+}
+
 FIXTURE_SCOPE_END()
@@ -21,17 +21,27 @@
 #include "vast/test/fixtures/actor_system_and_events.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iterator>
+#include <string>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 
 #include <caf/exit_reason.hpp>
 #include <caf/io/middleman.hpp>
 #include <caf/send.hpp>
 
+#include "vast/format/syslog.hpp"
 #include "vast/format/zeek.hpp"
 
 using namespace vast;
 using namespace vast::system;
+using namespace std::chrono_literals;
 
 namespace {
 
@@ -59,6 +69,54 @@ caf::behavior test_sink(test_sink_type* self, caf::actor src) {
   }};
 }
 
+// Notifies a listener once the stream is open and forwards the number of
+// rows of every table slice to it.
+caf::behavior
+forwarding_sink(caf::event_based_actor* self, caf::actor src,
+                caf::actor listener) {
+  self->send(src, atom::sink_v, self);
+  return {[=](caf::stream<table_slice> in) {
+    return self->make_sink(
+      in, [=](caf::unit_t&) { self->send(listener, atom::ok_v); },
+      [=](caf::unit_t&, table_slice slice) {
+        self->send(listener, uint64_t{slice.rows()});
+      },
+      [](caf::unit_t&, const error&) {
+        // nop
+      });
+  }};
+}
+
+// Returns a local UDP port that is currently not in use.
+uint16_t unused_udp_port() {
+  auto fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  REQUIRE(fd >= 0);
+  ::sockaddr_in sa;
+  std::memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  auto len = ::socklen_t{sizeof(sa)};
+  auto sa_ptr = reinterpret_cast<::sockaddr*>(&sa);
+  REQUIRE_EQUAL(::bind(fd, sa_ptr, sizeof(sa)), 0);
+  REQUIRE_EQUAL(::getsockname(fd, sa_ptr, &len), 0);
+  ::close(fd);
+  return ntohs(sa.sin_port);
+}
+
+void send_datagram(uint16_t port, const std::string& x) {
+  auto fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  REQUIRE(fd >= 0);
+  ::sockaddr_in sa;
+  std::memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  auto sent = ::sendto(fd, x.data(), x.size(), 0,
+                       reinterpret_cast<::sockaddr*>(&sa), sizeof(sa));
+  CHECK_EQUAL(sent, static_cast<ssize_t>(x.size()));
+  ::close(fd);
+}
+
 } // namespace <anonymous>
 
 FIXTURE_SCOPE(source_tests, fixtures::deterministic_actor_system_and_events)
@@ -72,8 +130,9 @@ TEST(zeek conn source) {
   mpx.provide_datagram_servant(8080, hdl);
   auto src
     = mm.spawn_broker(datagram_source<bf::reader>, uint16_t{8080},
-                      std::move(reader), 100u, caf::none, type_registry_actor{},
-                      vast::schema{}, std::string{}, accountant_actor{});
+                      detail::udp_receiver::options{}, std::move(reader), 100u,
+                      caf::none, type_registry_actor{}, vast::schema{},
+                      std::string{}, accountant_actor{});
   run();
   MESSAGE("start sink and initialize stream");
   auto snk = self->spawn(test_sink, src);
@@ -99,3 +158,41 @@ TEST(zeek conn source) {
 }
 
 FIXTURE_SCOPE_END()
+
+// The batched receive path runs a dedicated thread that notifies the source
+// asynchronously, so this test needs an actor system with a real scheduler.
+FIXTURE_SCOPE(batched_source_tests, fixtures::actor_system_and_events)
+
+TEST(syslog source with batched reception) {
+  MESSAGE("start source that receives up to 4 datagrams per batch");
+  auto port = unused_udp_port();
+  auto opts = detail::udp_receiver::options{4, 1024, 8, 0};
+  auto src = sys.middleman().spawn_broker(
+    datagram_source<format::syslog::reader>, port, opts,
+    format::syslog::reader{caf::settings{}}, 100u, caf::none,
+    type_registry_actor{}, vast::schema{}, std::string{}, accountant_actor{});
+  MESSAGE("start sink and initialize stream");
+  auto listener = caf::actor_cast<caf::actor>(self);
+  auto snk = sys.spawn(forwarding_sink, src, listener);
+  self->receive([](atom::ok) {},
+                caf::after(10s) >> [] { FAIL("failed to open stream"); });
+  MESSAGE("send one syslog message per datagram");
+  constexpr auto num_datagrams = 10u;
+  for (auto i = 0u; i < num_datagrams; ++i)
+    send_datagram(port, "<34>1 2003-10-11T22:14:15.003Z mymachine.example.com "
+                        "su - ID"
+                          + std::to_string(i)
+                          + " - 'su root' failed for lonvick on /dev/pts/8");
+  MESSAGE("all datagrams arrive as events");
+  uint64_t rows = 0;
+  auto timed_out = false;
+  while (rows < num_datagrams && !timed_out)
+    self->receive([&](uint64_t n) { rows += n; },
+                  caf::after(10s) >> [&] { timed_out = true; });
+  CHECK(!timed_out);
+  CHECK_EQUAL(rows, num_datagrams);
+  self->send_exit(src, caf::exit_reason::user_shutdown);
+  self->send_exit(snk, caf::exit_reason::user_shutdown);
+}
+
+FIXTURE_SCOPE_END()
@@ -101,6 +101,9 @@ mock_index(system::index_actor::stateful_pointer<mock_index_state> self) {
       FAIL("no mock implementation available");
     },
     [=](atom::erase, uuid) -> ids { FAIL("no mock implementation available"); },
+    [=](atom::estimate, expression) -> caf::result<uint64_t, uint64_t> {
+      FAIL("no mock implementation available");
+    },
   };
 }
 
@@ -118,6 +121,12 @@ mock_archive(system::archive_actor::stateful_pointer<mock_archive_state> self) {
     [=](atom::exporter, caf::actor) {
       FAIL("no mock implementation available");
     },
+    [=](atom::exporter, caf::actor, std::vector<std::string>, expression) {
+      FAIL("no mock implementation available");
+    },
+    [=](atom::exporter, caf::actor, expression, aggregation_spec) {
+      FAIL("no mock implementation available");
+    },
     [=](system::accountant_actor) { FAIL("no mock implementation available"); },
     [=](ids) { FAIL("no mock implementation available"); },
     [=](ids, system::archive_client_actor) {
@@ -197,7 +206,7 @@ TEST(eraser on actual INDEX with Zeek conn logs) {
   MESSAGE("spawn INDEX ingest 4 slices with 100 rows (= 1 partition) each");
   auto fs = self->spawn(vast::system::posix_filesystem, directory);
   index = self->spawn(system::index, fs, directory / "index", slice_size, 100,
-                      taste_count, 1, 0.01);
+                      taste_count, 1, 0.01, 0, false, duration::zero());
   detail::spawn_container_source(sys, std::move(slices), index);
   run();
   // Predicate for running all actors *except* aut.
@@ -24,6 +24,7 @@
 #include "vast/concept/parseable/vast/expression.hpp"
 #include "vast/expression.hpp"
 
+#include <memory>
 #include <vector>
 
 using namespace vast;
@@ -63,9 +64,13 @@ ids select(const counts& xs, curried_predicate pred) {
 }
 
 // Dummy actor representing an INDEXER for field `x`.
-vast::system::indexer_actor::behavior_type dummy_indexer(counts xs) {
+vast::system::indexer_actor::behavior_type
+dummy_indexer(counts xs, std::shared_ptr<size_t> lookups) {
   return {
-    [xs = std::move(xs)](curried_predicate pred) { return select(xs, pred); },
+    [xs = std::move(xs), lookups](curried_predicate pred) {
+      ++*lookups;
+      return select(xs, pred);
+    },
     [](atom::shutdown) { FAIL("received shutdown request as dummy indexer"); },
   };
 }
@@ -87,8 +92,11 @@ struct fixture : fixtures::deterministic_actor_system_and_events {
   /// Maps predicates to a list of actors.
   std::map<std::string, std::vector<system::indexer_actor>> indexers;
 
+  /// Counts the requests to all dummy indexers.
+  std::shared_ptr<size_t> lookups = std::make_shared<size_t>(0);
+
   void add_indexer(std::vector<system::indexer_actor>& container, counts data) {
-    container.emplace_back(sys.spawn(dummy_indexer, std::move(data)));
+    container.emplace_back(sys.spawn(dummy_indexer, std::move(data), lookups));
   }
 
   record_type layout;
@@ -106,7 +114,7 @@ struct fixture : fixtures::deterministic_actor_system_and_events {
       for (auto& x : xs)
         triples.emplace_back(expr_position, curried(pred), x);
     }
-    auto eval = sys.spawn(system::evaluator, expr, std::move(triples));
+    auto eval = sys.spawn(system::evaluator, expr, std::move(triples), ids{});
     self->send(eval, caf::actor_cast<system::partition_client_actor>(self));
     run();
     ids result;
@@ -174,4 +182,22 @@ TEST(disjunctions) {
   CHECK_QUERY("x == 75 || y == 77", ({3, 5}));
 }
 
+TEST(early termination) {
+  MESSAGE("an empty conjunct skips the remaining conjuncts");
+  *lookups = 0;
+  CHECK_QUERY("x == 33 && y != 10", ({}));
+  CHECK_EQUAL(*lookups, 2u);
+  *lookups = 0;
+  CHECK_QUERY("x == 75 && y == 77 && x == 42", ({}));
+  CHECK_EQUAL(*lookups, 4u);
+  MESSAGE("a non-empty intersection evaluates all conjuncts");
+  *lookups = 0;
+  CHECK_QUERY("x == 42 && y != 10", ({1, 3, 4}));
+  CHECK_EQUAL(*lookups, 4u);
+  MESSAGE("disjunctions evaluate all predicates at once");
+  *lookups = 0;
+  CHECK_QUERY("x == 33 || y != 10", ({1, 3, 4, 8}));
+  CHECK_EQUAL(*lookups, 4u);
+}
+
 FIXTURE_SCOPE_END()
@@ -13,12 +13,18 @@
 
 #define SUITE explorer
 
+#include "vast/test/fixtures/actor_system_and_events.hpp"
 #include "vast/test/test.hpp"
 
+#include "vast/system/explorer.hpp"
 #include "vast/system/spawn_explorer.hpp"
+#include "vast/table_slice_column.hpp"
 #include "vast/time.hpp"
 
 #include <caf/settings.hpp>
+#include <caf/stateful_actor.hpp>
+
+#include <set>
 
 using namespace std::chrono_literals;
 
@@ -73,3 +79,102 @@ TEST(explorer config) {
     CHECK_EQUAL(vast::system::explorer_validate_args(settings), caf::none);
   }
 }
+
+namespace {
+
+struct fixture : fixtures::deterministic_actor_system_and_events {
+  fixture() {
+    aut = sys.spawn(vast::system::explorer, caf::actor{},
+                    vast::system::explorer_state::event_limits{100, 10},
+                    std::nullopt, std::nullopt, std::nullopt);
+    run();
+  }
+
+  ~fixture() {
+    self->send_exit(aut, caf::exit_reason::user_shutdown);
+    run();
+  }
+
+  auto& state() {
+    return deref<caf::stateful_actor<vast::system::explorer_state>>(aut).state;
+  }
+
+  size_t distinct(const vast::table_slice& slice, const std::string& field) {
+    auto column = unbox(vast::table_slice_column::make(slice, field));
+    std::set<vast::data> xs;
+    for (size_t i = 0; i < column.size(); ++i)
+      xs.insert(materialize(column[i]));
+    return xs.size();
+  }
+
+  caf::actor aut;
+};
+
+} // namespace
+
+FIXTURE_SCOPE(explorer_tests, fixture)
+
+TEST(context queries merge overlapping time boxes) {
+  auto& slice = zeek_conn_log[0];
+  auto& st = state();
+  MESSAGE("time boxes that span the entire slice merge into one");
+  st.before = vast::duration{24h};
+  st.after = vast::duration{24h};
+  auto query = st.make_context_query(slice);
+  REQUIRE(query);
+  CHECK_EQUAL(query->second, slice.rows());
+  auto conj = caf::get_if<vast::conjunction>(&query->first);
+  REQUIRE(conj);
+  CHECK_EQUAL(conj->size(), 2u);
+  MESSAGE("empty time boxes only merge for identical timestamps");
+  st.before = vast::duration{0s};
+  st.after = vast::duration{0s};
+  query = st.make_context_query(slice);
+  REQUIRE(query);
+  auto num_timestamps = distinct(slice, "ts");
+  if (num_timestamps > 1) {
+    auto disj = caf::get_if<vast::disjunction>(&query->first);
+    REQUIRE(disj);
+    CHECK_EQUAL(disj->size(), num_timestamps);
+  }
+}
+
+TEST(context queries with one-sided time boxes) {
+  auto& slice = zeek_conn_log[0];
+  auto& st = state();
+  auto check = [&](vast::relational_operator op) {
+    auto query = st.make_context_query(slice);
+    REQUIRE(query);
+    CHECK_EQUAL(query->second, slice.rows());
+    MESSAGE("all open time boxes merge into a single bound");
+    auto pred = caf::get_if<vast::predicate>(&query->first);
+    REQUIRE(pred);
+    CHECK_EQUAL(pred->op, op);
+  };
+  MESSAGE("only after");
+  st.after = vast::duration{1h};
+  check(vast::less_equal);
+  MESSAGE("only before");
+  st.before = vast::duration{1h};
+  st.after = std::nullopt;
+  check(vast::greater_equal);
+}
+
+TEST(context queries group by field values) {
+  auto& slice = zeek_conn_log[0];
+  auto& st = state();
+  st.by = "id.orig_h";
+  auto query = st.make_context_query(slice);
+  REQUIRE(query);
+  CHECK_EQUAL(query->second, slice.rows());
+  auto num_values = distinct(slice, "id.orig_h");
+  if (num_values > 1) {
+    auto disj = caf::get_if<vast::disjunction>(&query->first);
+    REQUIRE(disj);
+    CHECK_EQUAL(disj->size(), num_values);
+  } else {
+    CHECK(caf::holds_alternative<vast::predicate>(query->first));
+  }
+}
+
+FIXTURE_SCOPE_END()
@@ -63,7 +63,7 @@ struct fixture : fixture_base {
   void spawn_index() {
     auto fs = self->spawn(system::posix_filesystem, directory);
     index = self->spawn(system::index, fs, directory / "index", 10000, 5, 5, 1,
-                        0.01);
+                        0.01, 0, false, vast::duration::zero());
   }
 
   void spawn_archive() {
@@ -75,8 +75,9 @@ struct fixture : fixture_base {
                            index, type_registry);
   }
 
-  void spawn_exporter(query_options opts) {
-    exporter = self->spawn(system::exporter, expr, opts);
+  void spawn_exporter(query_options opts,
+                      std::vector<std::string> fields = {}) {
+    exporter = self->spawn(system::exporter, expr, opts, std::move(fields));
   }
 
   void importer_setup() {
@@ -91,8 +92,9 @@ struct fixture : fixture_base {
     run();
   }
 
-  void exporter_setup(query_options opts) {
-    spawn_exporter(opts);
+  void exporter_setup(query_options opts,
+                      std::vector<std::string> fields = {}) {
+    spawn_exporter(opts, std::move(fields));
     send(exporter, archive);
     send(exporter, index);
     send(exporter, atom::sink_v, self);
@@ -171,6 +173,31 @@ TEST(historical query with importer) {
   verify(fetch_results());
 }
 
+TEST(historical query with projection) {
+  MESSAGE("spawn index and archive");
+  spawn_index();
+  spawn_archive();
+  run();
+  MESSAGE("ingest conn.log into archive and index");
+  vast::detail::spawn_container_source(sys, zeek_conn_log, index, archive);
+  run();
+  MESSAGE("spawn exporter for historical query that only wants the uid");
+  exporter_setup(historical, {"uid"});
+  auto results = fetch_results();
+  for (auto& slice : results) {
+    CHECK_EQUAL(slice.layout().name(), "zeek.conn");
+    REQUIRE_EQUAL(slice.columns(), 1u);
+  }
+  auto xs = to_data(results);
+  REQUIRE_EQUAL(xs.size(), 5u);
+  auto has_uid = [&](const std::string& uid) {
+    return std::any_of(xs.begin(), xs.end(),
+                       [&](auto& x) { return x[0] == data{uid}; });
+  };
+  CHECK(has_uid("xvWLhxgUmj5"));
+  CHECK(has_uid("07mJRfg5RU5"));
+}
+
 TEST(continuous query with exporter only) {
   MESSAGE("prepare exporter for continuous query");
   spawn_exporter(continuous);
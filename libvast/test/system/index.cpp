@@ -45,13 +45,16 @@ struct fixture : fixtures::deterministic_actor_system_and_events {
   static constexpr uint32_t taste_count = 4;
   static constexpr size_t num_query_supervisors = 1;
   static constexpr double meta_index_fp_rate = 0.01;
+  static constexpr size_t predicate_cache_size = 1'048'576;
+  static constexpr vast::duration active_partition_timeout = minutes{1};
 
   fixture() {
     directory /= "index";
     auto fs = self->spawn(system::posix_filesystem, directory);
     index = self->spawn(system::index, fs, directory / "index", slice_size,
                         in_mem_partitions, taste_count, num_query_supervisors,
-                        meta_index_fp_rate);
+                        meta_index_fp_rate, predicate_cache_size, false,
+                        vast::duration::zero());
   }
 
   ~fixture() {
@@ -216,4 +219,56 @@ TEST(iterable zeek conn log query result) {
   }
 }
 
+TEST(partitions per layout) {
+  MESSAGE("restart the index with one partition per layout");
+  anon_send_exit(index, caf::exit_reason::user_shutdown);
+  run();
+  auto fs = self->spawn(system::posix_filesystem, directory);
+  index = self->spawn(system::index, fs, directory / "per-layout", slice_size,
+                      in_mem_partitions, taste_count, num_query_supervisors,
+                      meta_index_fp_rate, predicate_cache_size, true,
+                      active_partition_timeout);
+  MESSAGE("ingest interleaved conn.log and dns.log slices");
+  std::vector<table_slice> slices;
+  for (size_t i = 0; i < zeek_dns_log.size(); ++i) {
+    if (i < zeek_conn_log.size())
+      slices.push_back(zeek_conn_log[i]);
+    slices.push_back(zeek_dns_log[i]);
+  }
+  detail::spawn_container_source(sys, slices, index);
+  run();
+  auto& active = state().active_partitions;
+  CHECK_EQUAL(active.size(), 2u);
+  CHECK_EQUAL(active.count("zeek.conn"), 1u);
+  CHECK_EQUAL(active.count("zeek.dns"), 1u);
+  MESSAGE("type queries select only partitions of that layout");
+  {
+    auto [query_id, hits, scheduled] = query("#type == \"zeek.dns\"");
+    CHECK_EQUAL(hits, zeek_dns_log.size());
+    auto result = receive_result(query_id, hits, scheduled);
+    CHECK_EQUAL(rank(result), rows(zeek_dns_log));
+  }
+  {
+    auto expected_result = make_ids({5, 6, 9, 11});
+    auto [query_id, hits, scheduled]
+      = query("#type == \"zeek.conn\" && id.orig_h == 192.168.1.104");
+    CHECK_LESS_EQUAL(hits, zeek_conn_log.size());
+    auto result = receive_result(query_id, hits, scheduled);
+    expected_result.append_bits(false, result.size() - expected_result.size());
+    CHECK_EQUAL(result, expected_result);
+  }
+  MESSAGE("persist active partitions that receive no more events");
+  auto dns_partition = active["zeek.dns"].id;
+  sched.advance_time(active_partition_timeout);
+  run();
+  CHECK(active.empty());
+  CHECK_EQUAL(state().persisted_partitions.count(dns_partition), 1u);
+  CHECK(exists(directory / "per-layout" / to_string(dns_partition)));
+  MESSAGE("new events of a layout get a new active partition");
+  detail::spawn_container_source(sys, std::vector{zeek_dns_log[0]}, index);
+  run();
+  REQUIRE_EQUAL(active.size(), 1u);
+  CHECK_NOT_EQUAL(active["zeek.dns"].id, dns_partition);
+}
+
 FIXTURE_SCOPE_END()
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE predicate_cache
+
+#include "vast/system/predicate_cache.hpp"
+
+#include "vast/test/test.hpp"
+
+#include "vast/ids.hpp"
+
+using namespace vast;
+using namespace vast::system;
+
+namespace {
+
+struct fixture {
+  fixture() {
+    p0 = uuid::random();
+    p1 = uuid::random();
+    xs = make_ids({{0, 10}, {42, 50}}, 100);
+  }
+
+  predicate_cache::key make_key(const uuid& partition, count x) {
+    return {partition, 3, equal, data{x}};
+  }
+
+  uuid p0;
+  uuid p1;
+  ids xs;
+};
+
+} // namespace
+
+FIXTURE_SCOPE(predicate_cache_tests, fixture)
+
+TEST(lookup) {
+  predicate_cache cache{1'048'576};
+  CHECK(!cache.lookup(make_key(p0, 42)));
+  cache.insert(make_key(p0, 42), xs);
+  auto result = cache.lookup(make_key(p0, 42));
+  REQUIRE(result);
+  CHECK_EQUAL(*result, xs);
+  MESSAGE("every part of the key matters");
+  CHECK(!cache.lookup(make_key(p1, 42)));
+  CHECK(!cache.lookup(make_key(p0, 43)));
+  CHECK(!cache.lookup({p0, 4, equal, data{count{42}}}));
+  CHECK(!cache.lookup({p0, 3, not_equal, data{count{42}}}));
+  auto stats = cache.stats();
+  CHECK_EQUAL(stats.hits, 1u);
+  CHECK_EQUAL(stats.misses, 5u);
+  CHECK_EQUAL(cache.size(), 1u);
+}
+
+TEST(eviction) {
+  predicate_cache probe{1'048'576};
+  probe.insert(make_key(p0, 0), xs);
+  auto bytes = probe.size_bytes();
+  REQUIRE_GREATER(bytes, 0u);
+  predicate_cache cache{2 * bytes};
+  cache.insert(make_key(p0, 0), xs);
+  cache.insert(make_key(p0, 1), xs);
+  MESSAGE("lookups refresh entries");
+  CHECK(cache.lookup(make_key(p0, 0)));
+  cache.insert(make_key(p0, 2), xs);
+  CHECK_EQUAL(cache.size(), 2u);
+  CHECK_EQUAL(cache.size_bytes(), 2 * bytes);
+  CHECK_EQUAL(cache.stats().evictions, 1u);
+  CHECK(cache.lookup(make_key(p0, 0)));
+  CHECK(!cache.lookup(make_key(p0, 1)));
+  CHECK(cache.lookup(make_key(p0, 2)));
+  MESSAGE("results that exceed the capacity are not cached");
+  predicate_cache tiny{1};
+  tiny.insert(make_key(p0, 0), xs);
+  CHECK_EQUAL(tiny.size(), 0u);
+  CHECK_EQUAL(tiny.size_bytes(), 0u);
+}
+
+TEST(erase) {
+  predicate_cache cache{1'048'576};
+  cache.insert(make_key(p0, 0), xs);
+  cache.insert(make_key(p1, 0), xs);
+  cache.insert(make_key(p0, 1), xs);
+  cache.erase(p0);
+  CHECK_EQUAL(cache.size(), 1u);
+  CHECK(!cache.lookup(make_key(p0, 0)));
+  CHECK(!cache.lookup(make_key(p0, 1)));
+  CHECK(cache.lookup(make_key(p1, 0)));
+}
+
+FIXTURE_SCOPE_END()
@@ -71,6 +71,9 @@ mock_index(system::index_actor::stateful_pointer<mock_index_state> self) {
       FAIL("no mock implementation available");
     },
     [=](atom::erase, uuid) -> ids { FAIL("no mock implementation available"); },
+    [=](atom::estimate, expression) -> caf::result<uint64_t, uint64_t> {
+      FAIL("no mock implementation available");
+    },
   };
 }
 
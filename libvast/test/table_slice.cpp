@@ -28,6 +28,8 @@
 #include <caf/make_copy_on_write.hpp>
 #include <caf/test/dsl.hpp>
 
+#include <numeric>
+
 using namespace vast;
 using namespace std::string_literals;
 
@@ -191,6 +193,45 @@ TEST(split) {
   CHECK_EQUAL(split_sut(7), manual_split_sut(7));
 }
 
+TEST(resolve columns) {
+  auto flat_layout = flatten(zeek_conn_log[0].layout());
+  auto names = [&](const std::vector<std::string>& fields) {
+    std::vector<std::string> result;
+    for (auto column : resolve_columns(zeek_conn_log[0].layout(), fields))
+      result.push_back(flat_layout.fields[column].name);
+    return result;
+  };
+  using strings = std::vector<std::string>;
+  CHECK_EQUAL(names({"id.orig_h", "ts"}), (strings{"ts", "id.orig_h"}));
+  CHECK_EQUAL(names({"resp_h"}), strings{"id.resp_h"});
+  CHECK_EQUAL(names({"conn.uid"}), strings{"uid"});
+  CHECK_EQUAL(names({"id"}), (strings{"id.orig_h", "id.orig_p", "id.resp_h",
+                                      "id.resp_p"}));
+  CHECK_EQUAL(names({"d"}), strings{});
+  CHECK_EQUAL(names({"foo"}), strings{});
+}
+
+TEST(project) {
+  auto sut = zeek_conn_log[0];
+  sut.offset(100);
+  auto columns = resolve_columns(sut.layout(), {"ts", "id.orig_h"});
+  REQUIRE_EQUAL(columns.size(), 2u);
+  auto projected = project(sut, columns);
+  CHECK_EQUAL(projected.encoding(), sut.encoding());
+  CHECK_EQUAL(projected.layout().name(), "zeek.conn");
+  CHECK_EQUAL(projected.offset(), 100u);
+  REQUIRE_EQUAL(projected.rows(), sut.rows());
+  REQUIRE_EQUAL(projected.columns(), 2u);
+  for (size_t row = 0; row < sut.rows(); ++row)
+    for (size_t i = 0; i < columns.size(); ++i)
+      CHECK_EQUAL(materialize(projected.at(row, i)),
+                  materialize(sut.at(row, columns[i])));
+  MESSAGE("projecting onto all columns yields the same slice");
+  std::vector<size_t> all(sut.columns());
+  std::iota(all.begin(), all.end(), size_t{0});
+  CHECK_EQUAL(project(sut, all), sut);
+}
+
 TEST(evaluate) {
   auto sut = zeek_conn_log[0];
   sut.offset(0);
@@ -25,6 +25,7 @@
 #include "vast/concept/parseable/vast/time.hpp"
 #include "vast/concept/printable/to_string.hpp"
 #include "vast/concept/printable/vast/bitmap.hpp"
+#include "vast/concept/printable/vast/type.hpp"
 #include "vast/detail/deserialize.hpp"
 #include "vast/detail/serialize.hpp"
 #include "vast/table_slice.hpp"
@@ -108,6 +109,29 @@ TEST(integer) {
   CHECK(to_string(unbox(less_than_leet)) == "1111011");
 }
 
+TEST(membership with nil) {
+  auto check = [](const type& t, data x, data y) {
+    MESSAGE("checking " << to_string(t));
+    auto idx = factory<value_index>::make(t, caf::settings{});
+    REQUIRE_NOT_EQUAL(idx, nullptr);
+    REQUIRE(idx->append(make_data_view(x)));
+    REQUIRE(idx->append(make_data_view(caf::none)));
+    REQUIRE(idx->append(make_data_view(y)));
+    auto lookup = [&](relational_operator op, const list& xs) {
+      return to_string(unbox(idx->lookup(op, make_data_view(xs))));
+    };
+    CHECK_EQUAL(lookup(in, list{x}), "100");
+    CHECK_EQUAL(lookup(in, list{caf::none, x}), "110");
+    CHECK_EQUAL(lookup(in, list{caf::none}), "010");
+    CHECK_EQUAL(lookup(not_in, list{caf::none, x}), "001");
+  };
+  check(integer_type{}, integer{42}, integer{-7});
+  check(string_type{}, "foo"s, "bar"s);
+  check(address_type{}, unbox(to<address>("10.0.0.1")),
+        unbox(to<address>("10.0.0.2")));
+  check(string_type{}.attributes({{"index", "hash"}}), "foo"s, "bar"s);
+}
+
 // This was the first attempt in figuring out where the bug sat. It didn't fire.
 TEST(regression - checking the result single bitmap) {
   ewah_bitmap bm;
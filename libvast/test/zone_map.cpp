@@ -0,0 +1,152 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#define SUITE zone_map
+
+#include "vast/zone_map.hpp"
+
+#include "vast/test/test.hpp"
+
+#include "vast/bitmap_algorithms.hpp"
+#include "vast/defaults.hpp"
+#include "vast/detail/deserialize.hpp"
+#include "vast/detail/serialize.hpp"
+#include "vast/expression.hpp"
+#include "vast/ids.hpp"
+#include "vast/table_slice.hpp"
+#include "vast/table_slice_builder_factory.hpp"
+#include "vast/view.hpp"
+
+using namespace vast;
+
+using std::literals::operator""s;
+
+namespace {
+
+const vast::time epoch;
+
+struct fixture {
+  fixture() {
+    factory<table_slice_builder>::initialize();
+    layout = record_type{{"timestamp", time_type{}.attributes({{"timestamp"}})},
+                         {"x", count_type{}},
+                         {"content", string_type{}}}
+               .name("foo");
+    // Three table slices with the IDs [0, 10), [10, 20), and [25, 30). The
+    // last value of `x` in the second slice is nil, and all values of `x` in
+    // the third slice are nil.
+    sut.add(make_slice(0, 10, 0, false));
+    sut.add(make_slice(25, 5, 100, true));
+    sut.add(make_slice(10, 10, 10, false));
+  }
+
+  table_slice make_slice(id offset, size_t rows, count first, bool nil) {
+    auto builder = factory<table_slice_builder>::make(
+      defaults::import::table_slice_type, layout);
+    for (size_t i = 0; i < rows; ++i) {
+      auto x = first + i;
+      vast::time ts = epoch + std::chrono::seconds(x);
+      CHECK(builder->add(make_data_view(ts)));
+      if (nil || x == 19)
+        CHECK(builder->add(data_view{}));
+      else
+        CHECK(builder->add(make_data_view(x)));
+      CHECK(builder->add(make_data_view("foo")));
+    }
+    auto slice = builder->finish();
+    slice.offset(offset);
+    return slice;
+  }
+
+  record_type layout;
+  zone_map sut;
+};
+
+predicate timestamp(relational_operator op, vast::time x) {
+  return {attribute_extractor{atom::timestamp_v}, op, data{x}};
+}
+
+predicate field(std::string name, relational_operator op, data x) {
+  return {field_extractor{std::move(name)}, op, std::move(x)};
+}
+
+} // namespace
+
+FIXTURE_SCOPE(zone_map_tests, fixture)
+
+TEST(summaries) {
+  REQUIRE_EQUAL(sut.zones().size(), 3u);
+  CHECK_EQUAL(sut.columns().size(), 3u);
+  auto& zone = sut.zones()[1];
+  CHECK_EQUAL(zone.offset, 10u);
+  CHECK_EQUAL(zone.rows, 10u);
+  CHECK_EQUAL(zone.layout, "foo");
+  // The string column has no summary.
+  REQUIRE_EQUAL(zone.ranges.size(), 2u);
+  CHECK_EQUAL(zone.ranges[0].min, data{epoch + 10s});
+  CHECK_EQUAL(zone.ranges[0].max, data{epoch + 19s});
+  CHECK_EQUAL(zone.ranges[1].min, data{count{10}});
+  CHECK_EQUAL(zone.ranges[1].max, data{count{18}});
+  CHECK_EQUAL(zone.ranges[1].nils, 1u);
+  CHECK_EQUAL(sut.zones()[2].ranges[1].min, data{});
+  CHECK_EQUAL(sut.zones()[2].ranges[1].nils, 5u);
+}
+
+TEST(time ranges) {
+  auto result = sut.lookup(timestamp(greater_equal, epoch + 12s));
+  CHECK_EQUAL(result, make_ids({{10, 20}, {25, 30}}));
+  result = sut.lookup(timestamp(less, epoch + 10s));
+  CHECK_EQUAL(result, make_ids({{0, 10}}));
+  result = sut.lookup(conjunction{timestamp(greater, epoch + 20s),
+                                  timestamp(less, epoch + 100s)});
+  CHECK_EQUAL(rank(result), 0u);
+}
+
+TEST(values) {
+  CHECK_EQUAL(sut.lookup(field("x", equal, count{5})), make_ids({{0, 10}}));
+  CHECK_EQUAL(sut.lookup(field("x", equal, integer{15})),
+              make_ids({{10, 20}}));
+  CHECK_EQUAL(rank(sut.lookup(field("x", greater, count{100}))), 0u);
+  CHECK_EQUAL(sut.lookup(field("x", equal, caf::none)),
+              make_ids({{10, 20}, {25, 30}}));
+  CHECK_EQUAL(sut.lookup(field("x", in, list{count{3}, count{42}})),
+              make_ids({{0, 10}}));
+}
+
+TEST(undecidable predicates) {
+  auto all_slices = make_ids({{0, 20}, {25, 30}});
+  CHECK_EQUAL(sut.lookup(field("content", equal, "bar")), all_slices);
+  CHECK_EQUAL(sut.lookup(negation{field("x", equal, count{5})}), all_slices);
+  // A literal of another type cannot be compared to the summary.
+  CHECK_EQUAL(sut.lookup(field("timestamp", equal, count{5})), all_slices);
+}
+
+TEST(connectives and types) {
+  auto type = predicate{attribute_extractor{atom::type_v}, equal, data{"bar"}};
+  CHECK_EQUAL(rank(sut.lookup(type)), 0u);
+  auto expr = disjunction{field("x", equal, count{5}),
+                          timestamp(greater, epoch + 100s)};
+  CHECK_EQUAL(sut.lookup(expr), make_ids({{0, 10}, {25, 30}}));
+}
+
+TEST(serialization) {
+  std::vector<char> buf;
+  CHECK_EQUAL(detail::serialize(buf, sut), caf::none);
+  zone_map copy;
+  REQUIRE_EQUAL(detail::deserialize(buf, copy), caf::none);
+  CHECK_EQUAL(copy.zones().size(), sut.zones().size());
+  CHECK_EQUAL(copy.lookup(timestamp(greater_equal, epoch + 12s)),
+              make_ids({{10, 20}, {25, 30}}));
+}
+
+FIXTURE_SCOPE_END()
@@ -0,0 +1,172 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/fwd.hpp"
+
+#include "vast/aliases.hpp"
+#include "vast/data.hpp"
+#include "vast/defaults.hpp"
+#include "vast/detail/hyperloglog.hpp"
+#include "vast/ids.hpp"
+#include "vast/type.hpp"
+
+#include <caf/meta/type_name.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vast {
+
+/// Describes a group-by aggregation over events. Every field names columns
+/// with the same suffix matching as `resolve_columns`. If a field matches
+/// several columns, e.g., `id` for `id.orig_h` and `id.resp_h`, a key consists
+/// of the list of their values, and an aggregate includes the values of all
+/// of them.
+struct aggregation_spec {
+  /// The fields whose values identify a group.
+  std::vector<std::string> keys;
+
+  /// The fields to sum up per group.
+  std::vector<std::string> sum;
+
+  /// The fields to compute the minimum of per group.
+  std::vector<std::string> min;
+
+  /// The fields to compute the maximum of per group.
+  std::vector<std::string> max;
+
+  /// The fields to estimate the number of distinct values of per group.
+  std::vector<std::string> distinct;
+
+  /// The maximum number of groups. Beyond that, an aggregation only keeps
+  /// track of the most frequent groups.
+  uint64_t max_groups = defaults::count::max_groups;
+
+  template <class Inspector>
+  friend auto inspect(Inspector& f, aggregation_spec& x) {
+    return f(caf::meta::type_name("vast.aggregation_spec"), x.keys, x.sum,
+             x.min, x.max, x.distinct, x.max_groups);
+  }
+};
+
+/// The partial result of a group-by aggregation. Aggregations over disjoint
+/// sets of events merge into the aggregation over their union.
+///
+/// To bound the memory usage for keys with a high cardinality, an aggregation
+/// only keeps the most frequent groups once it exceeds the maximum number of
+/// groups, similar to the Space-Saving algorithm: the count of every group is
+/// an upper bound that exceeds the true count by at most its error, and no
+/// evicted group has a count above the threshold.
+class aggregation {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// The partial aggregates of a group.
+  struct group {
+    /// The number of events in the group.
+    uint64_t count = 0;
+
+    /// The maximum overestimation of `count`.
+    uint64_t error = 0;
+
+    /// The partial aggregates in the order of the fields in the spec.
+    std::vector<data> sum;
+    std::vector<data> min;
+    std::vector<data> max;
+    std::vector<detail::hyperloglog<>> distinct;
+
+    template <class Inspector>
+    friend auto inspect(Inspector& f, group& x) {
+      return f(caf::meta::type_name("vast.aggregation.group"), x.count,
+               x.error, x.sum, x.min, x.max, x.distinct);
+    }
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  aggregation() = default;
+
+  explicit aggregation(aggregation_spec spec);
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Aggregates rows of a table slice.
+  /// @param slice The table slice to aggregate.
+  /// @param selection The IDs of the rows to aggregate.
+  void add(const table_slice& slice, const ids& selection);
+
+  /// Merges another aggregation with the same spec into this one.
+  /// @param other The aggregation to merge.
+  void merge(const aggregation& other);
+
+  // -- properties -------------------------------------------------------------
+
+  /// @returns the spec of the aggregation.
+  const aggregation_spec& spec() const;
+
+  /// @returns the number of groups.
+  size_t size() const;
+
+  /// @returns whether the aggregation has no groups.
+  bool empty() const;
+
+  /// @returns an upper bound for the count of every group that the
+  ///          aggregation does not keep track of.
+  uint64_t threshold() const;
+
+  /// Renders the groups in descending order of their count. Every record
+  /// contains the key fields, the count, and one field per aggregate, e.g.,
+  /// `sum(orig_bytes)`.
+  std::vector<record> make_records() const;
+
+  // -- concepts ---------------------------------------------------------------
+
+  template <class Inspector>
+  friend auto inspect(Inspector& f, aggregation& x) {
+    return f(caf::meta::type_name("vast.aggregation"), x.spec_, x.groups_,
+             x.threshold_);
+  }
+
+private:
+  /// The columns of a layout that the fields of the spec resolve to.
+  struct columns {
+    std::vector<std::vector<size_t>> keys;
+    std::vector<std::vector<size_t>> sum;
+    std::vector<std::vector<size_t>> min;
+    std::vector<std::vector<size_t>> max;
+    std::vector<std::vector<size_t>> distinct;
+  };
+
+  /// @returns the columns for a layout.
+  const columns& columns_for(const record_type& layout);
+
+  /// @returns the group for a key, creating it if necessary.
+  group& find_or_add(data&& key);
+
+  /// Evicts the least frequent groups if the aggregation exceeds its maximum
+  /// number of groups.
+  void prune();
+
+  aggregation_spec spec_;
+  std::unordered_map<data, group> groups_;
+  uint64_t threshold_ = 0;
+
+  /// Caches the resolved columns per layout.
+  std::unordered_map<type, columns> columns_;
+};
+
+} // namespace vast
@@ -63,6 +63,17 @@ public:
   static table_slice_builder_ptr
   make(record_type layout, size_t initial_buffer_size = default_buffer_size);
 
+  /// Creates an Arrow table slice from an existing record batch, e.g., one
+  /// that was read from a file.
+  /// @param record_batch The record batch with the columns of the slice.
+  /// @param layout The layout of the slice.
+  /// @param initial_buffer_size The buffer size the builder starts with.
+  /// @pre The schema of *record_batch* matches `make_arrow_schema(layout)`.
+  /// @returns A table slice that shares no memory with *record_batch*.
+  static table_slice
+  create(const arrow::RecordBatch& record_batch, const record_type& layout,
+         size_t initial_buffer_size = default_buffer_size);
+
   /// Destroys an Arrow table slice builder.
   ~arrow_table_slice_builder() noexcept override;
 
@@ -99,6 +110,17 @@ private:
   /// @returns `true` on success.
   bool add_impl(data_view x) override;
 
+  /// Packs a record batch into a table slice.
+  /// @param builder The FlatBuffers builder for the table slice.
+  /// @param layout_buffer The serialized layout in *builder*.
+  /// @param record_batch The record batch to pack.
+  /// @param layout The layout of the slice.
+  /// @returns The finished table slice.
+  static table_slice
+  pack(flatbuffers::FlatBufferBuilder& builder,
+       flatbuffers::Offset<flatbuffers::Vector<uint8_t>> layout_buffer,
+       const arrow::RecordBatch& record_batch, const record_type& layout);
+
   /// Current column index.
   size_t column_ = 0;
 
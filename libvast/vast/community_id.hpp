@@ -121,19 +121,19 @@ constexpr size_t max_length() {
     static_assert(detail::always_false_v<Policy>, "unsupported plicy");
 }
 
-/// Calculates the Community ID for a given flow.
+/// Calculates the Community ID for a given flow into a caller-provided buffer.
 /// @tparam Policy The rendering policy to select Base64 or ASCII.
+/// @param out The output buffer with room for at least `max_length<Policy>()`
+///            bytes.
 /// @param x The flow tuple.
 /// @param seed An optional seed to the SHA-1 hash.
-/// @returns A string representation of the Community ID for *x*.
+/// @returns The number of bytes written to *out*.
 template <class Policy>
-std::string compute(const flow& x, uint16_t seed = 0) {
-  std::string result;
-  // Perform exactly one allocator round-trip.
-  result.reserve(max_length<Policy>());
+size_t compute(char* out, const flow& x, uint16_t seed = 0) {
   // The version prefix is always present.
-  result += version;
-  result += ':';
+  out[0] = version;
+  out[1] = ':';
+  auto offset = version_prefix_length();
   // Compute a SHA-1 hash over the flow tuple.
   sha1 hasher;
   hash_append(hasher, detail::to_network_order(seed));
@@ -144,16 +144,30 @@ std::string compute(const flow& x, uint16_t seed = 0) {
     constexpr auto element_size = sizeof(sha1::result_type::value_type);
     constexpr auto num_bytes = element_size * digest.size();
     auto ptr = reinterpret_cast<const uint8_t*>(digest.data());
-    result.resize(max_length<Policy>());
-    auto offset = version_prefix_length();
-    auto n = detail::base64::encode(result.data() + offset, ptr, num_bytes);
-    result.resize(offset + n);
+    return offset + detail::base64::encode(out + offset, ptr, num_bytes);
   } else if constexpr (std::is_same_v<Policy, policy::ascii>) {
-    auto bytes = as_bytes(span{digest.data(), digest.size()});
-    detail::hexify<policy::lowercase>(bytes, result);
+    for (auto b : as_bytes(span{digest.data(), digest.size()})) {
+      auto [hi, lo] = detail::byte_to_hex<policy::lowercase>(b);
+      out[offset++] = hi;
+      out[offset++] = lo;
+    }
+    return offset;
   } else {
     static_assert(detail::always_false_v<Policy>, "unsupported plicy");
   }
+}
+
+/// Calculates the Community ID for a given flow.
+/// @tparam Policy The rendering policy to select Base64 or ASCII.
+/// @param x The flow tuple.
+/// @param seed An optional seed to the SHA-1 hash.
+/// @returns A string representation of the Community ID for *x*.
+template <class Policy>
+std::string compute(const flow& x, uint16_t seed = 0) {
+  std::string result;
+  // Perform exactly one allocator round-trip.
+  result.resize(max_length<Policy>());
+  result.resize(compute<Policy>(result.data(), x, seed));
   return result;
 }
 
@@ -72,6 +72,21 @@ constexpr std::chrono::milliseconds batch_timeout = std::chrono::seconds{10};
 constexpr std::chrono::milliseconds read_timeout
   = std::chrono::milliseconds{20};
 
+/// Maximum number of datagrams a UDP source receives per batch on its
+/// dedicated receive thread. A value of 0 makes the source receive every
+/// datagram through the multiplexer instead.
+constexpr size_t udp_batch_size = 128;
+
+/// Maximum size of a single datagram for batched UDP reception. Longer
+/// datagrams get truncated.
+constexpr size_t udp_max_datagram_size = 16'384; // 16 KiB
+
+/// Number of batches a UDP source can buffer before it drops datagrams.
+constexpr size_t udp_buffers = 16;
+
+/// Requested socket receive buffer size of UDP sources.
+constexpr size_t udp_socket_buffer_size = 8'388'608; // 8 MiB
+
 /// Contains settings for the zeek subcommand.
 struct zeek {
   /// Nested category in config files for this subcommand.
@@ -133,6 +148,15 @@ struct syslog {
   static constexpr auto read = shared::read;
 };
 
+/// Contains settings for the parquet subcommand.
+struct parquet {
+  /// Nested category in config files for this subcommand.
+  static constexpr const char* category = "vast.import.parquet";
+
+  /// Path for reading input events.
+  static constexpr auto read = shared::read;
+};
+
 /// Contains settings for the test subcommand.
 struct test {
   /// Nested category in config files for this subcommand.
@@ -180,6 +204,32 @@ struct pcap {
 
 } // namespace import
 
+// -- constants for the bench command ------------------------------------------
+
+namespace bench {
+
+/// Number of synthetic events to ingest.
+constexpr size_t events = 1'000'000;
+
+/// Seed for generating the synthetic events. A fixed default makes the
+/// workloads of two runs identical.
+constexpr size_t seed = 42;
+
+/// Number of times to run every query.
+constexpr size_t runs = 10;
+
+} // namespace bench
+
+// -- constants for the count command ------------------------------------------
+
+namespace count {
+
+/// Maximum number of groups that a grouped count keeps track of. Beyond that,
+/// only the most frequent groups remain.
+constexpr uint64_t max_groups = 10'000;
+
+} // namespace count
+
 // -- constants for the explore command and its subcommands --------------------
 
 namespace explore {
@@ -197,6 +247,9 @@ constexpr size_t max_events_query = 100;
 /// Maximum number of results for every explored context.
 constexpr size_t max_events_context = 100;
 
+/// Maximum number of concurrently running EXPORTERs for context queries.
+constexpr size_t max_running_exporters = 10;
+
 } // namespace explore
 
 // -- constants for the export command and its subcommands ---------------------
@@ -278,6 +331,24 @@ struct arrow {
   static constexpr auto write = vast::defaults::export_::shared::write;
 };
 
+/// Contains settings for the parquet subcommand.
+struct parquet {
+  /// Nested category in config files for this subcommand.
+  static constexpr const char* category = "vast.export.parquet";
+
+  /// Directory for writing one Parquet file per layout.
+  static constexpr std::string_view write = ".";
+
+  /// Compression codec for column chunks.
+  static constexpr std::string_view compression = "snappy";
+
+  /// Whether to dictionary-encode columns.
+  static constexpr bool dictionary = true;
+
+  /// Maximum number of rows per row group.
+  static constexpr size_t row_group_size = 262'144; // 256 Ki
+};
+
 /// Contains settings for the pcap subcommand.
 struct pcap {
   /// Nested category in config files for this subcommand.
@@ -306,6 +377,16 @@ struct infer {
   static constexpr size_t buffer_size = 8'192;
 };
 
+// -- constants for the pivot command ------------------------------------------
+
+namespace pivot {
+
+/// Number of distinct pivot values to collect before issuing a query for the
+/// target type while another query is still running.
+constexpr size_t batch_size = 10'000;
+
+} // namespace pivot
+
 // -- constants for the index --------------------------------------------------
 
 /// Contains constants for value index parameterization.
@@ -371,6 +452,23 @@ constexpr size_t taste_partitions = 5;
 /// Maximum number of concurrent INDEX queries.
 constexpr size_t num_query_supervisors = 10;
 
+/// Maximum size of the INDEX predicate cache in MiB.
+constexpr size_t max_predicate_cache_size = 64;
+
+/// Whether the INDEX builds a separate partition for every layout.
+constexpr bool partition_per_layout = false;
+
+/// Duration without new events after which the INDEX persists an active
+/// partition.
+constexpr caf::timespan active_partition_timeout = std::chrono::minutes{10};
+
+/// Number of I/O threads of the filesystem. A value of 0 performs all
+/// operations synchronously in the filesystem actor.
+constexpr size_t filesystem_threads = 4;
+
+/// Maximum number of outstanding operations per filesystem I/O thread.
+constexpr size_t filesystem_queue_depth = 4;
+
 /// Number of cached ARCHIVE segments.
 constexpr size_t segments = 10;
 
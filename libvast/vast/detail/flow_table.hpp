@@ -0,0 +1,159 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/community_id.hpp"
+#include "vast/flow.hpp"
+
+#include <tsl/robin_map.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace vast::detail {
+
+/// The per-flow state tracked by a ::flow_table.
+struct flow_state {
+  /// The number of payload bytes seen so far.
+  uint64_t bytes = 0;
+
+  /// The timestamp of the most recent packet in seconds.
+  uint64_t last = 0;
+
+  /// @returns the Community ID of the flow, or an empty string if the table
+  ///          does not compute Community IDs.
+  std::string_view community_id() const {
+    return {community_id_buffer.data(), community_id_size};
+  }
+
+  /// Inline storage for the Base64-encoded Community ID.
+  std::array<char, community_id::max_length<policy::base64>()>
+    community_id_buffer;
+
+  /// The number of valid bytes in `community_id_buffer`.
+  uint8_t community_id_size = 0;
+};
+
+/// A bounded flow table with open addressing and an intrusive age list. The
+/// table keeps all flow states in a flat slab and maintains a doubly-linked
+/// list through the slab in order of last access. Expiring inactive flows and
+/// evicting the least recently used flow therefore only touch the affected
+/// entries instead of the whole table.
+class flow_table {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using index_type = uint32_t;
+
+  // -- constructors, destructors, and assignment operators -------------------
+
+  /// Constructs a flow table.
+  /// @param max_size The maximum number of concurrent flows.
+  /// @param community_id Whether to compute the Community ID for new flows.
+  explicit flow_table(size_t max_size, bool community_id = true);
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Retrieves the state for a flow and marks it as most recently used. If
+  /// the flow does not exist yet, it gets created, evicting the least
+  /// recently used flow if the table is full.
+  /// @param x The flow to look up.
+  /// @param timestamp The packet timestamp in seconds.
+  /// @returns A reference to the flow state that remains valid until the
+  ///          next call to `touch`.
+  flow_state& touch(const flow& x, uint64_t timestamp);
+
+  /// Removes all flows that have been inactive for more than `max_age`
+  /// seconds. Runs in time linear to the number of expired flows.
+  /// @param now The current timestamp in seconds.
+  /// @param max_age The maximum age of a flow in seconds.
+  /// @returns The number of expired flows.
+  size_t expire(uint64_t now, uint64_t max_age);
+
+  /// Removes all flows.
+  void clear();
+
+  // -- properties -------------------------------------------------------------
+
+  /// @returns the number of tracked flows.
+  size_t size() const noexcept {
+    return index_.size();
+  }
+
+  /// @returns the maximum number of tracked flows.
+  size_t max_size() const noexcept {
+    return max_size_;
+  }
+
+  /// @returns whether the table contains no flows.
+  bool empty() const noexcept {
+    return index_.empty();
+  }
+
+  /// @returns whether the table contains a given flow.
+  bool contains(const flow& x) const {
+    return index_.find(x) != index_.end();
+  }
+
+private:
+  // -- implementation details -------------------------------------------------
+
+  static constexpr index_type nil = std::numeric_limits<index_type>::max();
+
+  struct entry {
+    flow key;
+    flow_state state;
+    index_type prev = nil;
+    index_type next = nil;
+  };
+
+  /// Removes an entry from the age list.
+  void unlink(index_type i);
+
+  /// Appends an entry to the back of the age list.
+  void link_back(index_type i);
+
+  /// Removes an entry from the table and recycles its slot.
+  void erase(index_type i);
+
+  /// Maps flows to slots in `entries_`. Stores hash values in the buckets to
+  /// avoid recomputing them on rehash.
+  tsl::robin_map<flow, index_type, std::hash<flow>, std::equal_to<flow>,
+                 std::allocator<std::pair<flow, index_type>>, true>
+    index_;
+
+  /// Flat storage for all flow states. The index and the age list refer to
+  /// entries by their position, which stays valid when the vector grows;
+  /// references to entries do not.
+  std::vector<entry> entries_;
+
+  /// Unused slots in `entries_`.
+  std::vector<index_type> free_;
+
+  /// The least recently used entry.
+  index_type head_ = nil;
+
+  /// The most recently used entry.
+  index_type tail_ = nil;
+
+  size_t max_size_;
+  bool community_id_;
+};
+
+} // namespace vast::detail
@@ -0,0 +1,99 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/detail/bit.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace vast::detail {
+
+/// A HyperLogLog sketch that estimates the number of distinct elements from
+/// their 64-bit hash digests. The relative standard error of the estimate is
+/// `1.04 / sqrt(2^Precision)`, i.e., about 3% for the default precision.
+/// @note The registers are allocated lazily, such that empty sketches are
+/// cheap to create, copy, and serialize.
+template <int Precision = 10>
+class hyperloglog {
+  static_assert(Precision >= 4 && Precision <= 16);
+
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// The number of registers.
+  static constexpr size_t num_registers = size_t{1} << Precision;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a hash digest to the sketch.
+  void add(uint64_t digest) {
+    if (registers_.empty())
+      registers_.resize(num_registers, 0);
+    auto index = digest >> (64 - Precision);
+    auto rest = digest << Precision;
+    auto rank = static_cast<uint8_t>(
+      std::min(countl_zero(rest), 64 - Precision) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  /// Merges another sketch into this one, such that the result estimates the
+  /// number of distinct elements in the union of both.
+  void merge(const hyperloglog& other) {
+    if (other.registers_.empty())
+      return;
+    if (registers_.empty()) {
+      registers_ = other.registers_;
+      return;
+    }
+    for (size_t i = 0; i < num_registers; ++i)
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// @returns the estimated number of distinct elements.
+  double estimate() const {
+    if (registers_.empty())
+      return 0.0;
+    constexpr auto m = static_cast<double>(num_registers);
+    constexpr auto alpha = 0.7213 / (1.0 + 1.079 / m);
+    auto sum = 0.0;
+    auto zeros = size_t{0};
+    for (auto x : registers_) {
+      sum += std::ldexp(1.0, -x);
+      if (x == 0)
+        ++zeros;
+    }
+    auto result = alpha * m * m / sum;
+    // Fall back to linear counting for small cardinalities.
+    if (result <= 2.5 * m && zeros > 0)
+      result = m * std::log(m / static_cast<double>(zeros));
+    return result;
+  }
+
+  // -- concepts ---------------------------------------------------------------
+
+  template <class Inspector>
+  friend auto inspect(Inspector& f, hyperloglog& x) {
+    return f(x.registers_);
+  }
+
+private:
+  std::vector<uint8_t> registers_;
+};
+
+} // namespace vast::detail
@@ -18,16 +18,26 @@
 #include <chrono>
 #include <cstdint>
 #include <istream>
-#include <string>
+#include <string_view>
+#include <vector>
 
 namespace vast::detail {
 
-// A range of non-empty lines, extracted via `std::getline`.
+// A range of non-empty lines. The range reads its input in large chunks into
+// an internal buffer and locates line breaks with vectorized scanning, so
+// lines are views into the buffer rather than copies. Recognizes `\n`, `\r\n`
+// and `\r` as line breaks.
 class line_range : range_facade<line_range> {
 public:
+  /// The number of readable bytes that follow every line in the buffer. This
+  /// allows for parsers that read past the end of their input, e.g., simdjson.
+  static constexpr size_t padding = 64;
+
   explicit line_range(std::istream& input);
 
-  const std::string& get() const;
+  // The returned view is valid until the next call to `next` or
+  // `next_timeout`.
+  std::string_view get() const;
 
   void next_impl();
   void next();
@@ -45,16 +55,27 @@ public:
 
   bool done() const;
 
-  std::string& line();
-
   size_t line_number() const;
 
 private:
+  // Reads more input into the buffer.
+  // @returns `false` if no input is available due to a timeout or the end of
+  // the input.
+  bool fill();
+
   std::istream& input_;
-  std::string line_;
+  std::vector<char> buffer_;
+  // The unconsumed input is in [begin_, end_), and [begin_, scanned_) contains
+  // no line break.
+  size_t begin_ = 0;
+  size_t scanned_ = 0;
+  size_t end_ = 0;
+  std::string_view line_;
   size_t line_number_ = 0;
   bool timed_out_ = false;
+  // Whether the last line ended in `\r` at the end of the buffer, such that a
+  // subsequent `\n` belongs to the same line break.
+  bool skip_newline_ = false;
 };
 
 } // namespace vast::detail
-
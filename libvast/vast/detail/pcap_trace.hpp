@@ -0,0 +1,93 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/byte.hpp"
+#include "vast/chunk.hpp"
+#include "vast/fwd.hpp"
+#include "vast/span.hpp"
+#include "vast/time.hpp"
+
+#include <caf/expected.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vast::detail {
+
+/// A memory-mapped PCAP or PCAPNG trace file. Packets are handed out as views
+/// into the mapping, so walking a trace neither copies packet data nor goes
+/// through libpcap's per-packet buffer management. Only Ethernet traces are
+/// supported.
+class pcap_trace {
+public:
+  /// A single packet in the trace.
+  struct packet {
+    /// The capture timestamp.
+    vast::time timestamp;
+
+    /// The captured bytes of the frame.
+    span<const byte> data;
+  };
+
+  /// Memory-maps a trace file and validates its header.
+  /// @param filename The path to the trace file.
+  /// @returns The trace or an error if *filename* is not a supported trace.
+  static caf::expected<pcap_trace> make(const path& filename);
+
+  /// Advances to the next packet.
+  /// @returns The next packet, or an error with code `ec::end_of_input` after
+  ///          the last packet.
+  caf::expected<packet> next();
+
+private:
+  enum class file_format : uint8_t { pcap, pcapng };
+
+  explicit pcap_trace(chunk_ptr chunk);
+
+  caf::expected<packet> next_pcap();
+
+  caf::expected<packet> next_pcapng();
+
+  /// Parses a PCAPNG Section Header Block at `offset_`.
+  caf::error read_section_header();
+
+  /// Parses a PCAPNG Interface Description Block body.
+  caf::error read_interface_description(size_t body, size_t body_size);
+
+  /// Reads an integer from the mapping, adjusting for the trace byte order.
+  template <class T>
+  T load(size_t offset) const;
+
+  /// @returns The number of remaining bytes in the mapping.
+  size_t remaining() const;
+
+  /// Holds the mapping of the trace file.
+  chunk_ptr chunk_;
+
+  /// The current position in the mapping.
+  size_t offset_ = 0;
+
+  file_format format_ = file_format::pcap;
+
+  /// Whether the trace byte order differs from the host byte order.
+  bool swap_ = false;
+
+  /// The number of timestamp ticks per second for PCAP traces, or for each
+  /// interface in the current section of a PCAPNG trace.
+  std::vector<uint64_t> resolutions_;
+};
+
+} // namespace vast::detail
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <iterator>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -134,6 +135,22 @@ std::string double_unescape(std::string_view str, std::string_view esc);
 std::string replace_all(std::string str, std::string_view search,
                         std::string_view replace);
 
+/// Finds the first occurrence of either of two characters. This scans 16 or
+/// 32 bytes at a time on processors with SSE2 or AVX2.
+/// @param str The string to search.
+/// @param a The first character to look for.
+/// @param b The second character to look for.
+/// @param pos The position at which to start the search.
+/// @returns The position of the first match or `std::string_view::npos`.
+size_t find_first_of(std::string_view str, char a, char b, size_t pos = 0);
+
+/// Finds the first character that requires escaping in a JSON string, i.e.,
+/// a double quote, a backslash, or a control character.
+/// @param str The string to search.
+/// @param pos The position at which to start the search.
+/// @returns The position of the first match or `std::string_view::npos`.
+size_t find_json_escape(std::string_view str, size_t pos = 0);
+
 /// Splits a character sequence into a vector of substrings.
 /// @param str The string to split.
 /// @param sep The seperator where to split.
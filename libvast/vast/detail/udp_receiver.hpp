@@ -0,0 +1,148 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/span.hpp"
+
+#include <caf/expected.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vast::detail {
+
+/// Receives UDP datagrams on a dedicated thread. The thread reads many
+/// datagrams per system call (via `recvmmsg(2)` where available) into a ring
+/// of preallocated buffers and hands them out in batches. Each batch is a
+/// single contiguous buffer with one datagram per line, so line-based readers
+/// can consume it in one go.
+class udp_receiver {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Configures a ::udp_receiver.
+  struct options {
+    /// The maximum number of datagrams per batch.
+    size_t batch_size;
+
+    /// The maximum number of bytes per datagram; longer datagrams are
+    /// truncated.
+    size_t max_datagram_size;
+
+    /// The number of batches that can be in flight before the receiver drops
+    /// datagrams.
+    size_t num_buffers;
+
+    /// The requested socket receive buffer size in bytes, or 0 to keep the
+    /// system default.
+    size_t socket_buffer_size;
+  };
+
+  /// Counters since the start of the receiver.
+  struct statistics {
+    /// Number of received datagrams.
+    uint64_t received = 0;
+
+    /// Number of datagrams that the kernel dropped because the socket
+    /// receive buffer was full. Only available on Linux.
+    uint64_t kernel_drops = 0;
+
+    /// Number of datagrams that the receiver dropped because all buffers were
+    /// still in use by the consumer.
+    uint64_t application_drops = 0;
+
+    /// Number of datagrams that exceeded the maximum datagram size.
+    uint64_t truncated = 0;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Opens a UDP socket and starts the receive thread.
+  /// @param port The local port to bind to, or 0 to pick an ephemeral one.
+  /// @param opts The receiver configuration.
+  /// @param notify Gets called from the receive thread whenever a batch
+  ///        becomes available and no other batches were pending.
+  /// @returns A running receiver or an error if the socket cannot be opened.
+  static caf::expected<std::unique_ptr<udp_receiver>>
+  make(uint16_t port, options opts, std::function<void()> notify);
+
+  udp_receiver(const udp_receiver&) = delete;
+  udp_receiver& operator=(const udp_receiver&) = delete;
+
+  /// Stops the receive thread and closes the socket.
+  ~udp_receiver();
+
+  // -- properties -------------------------------------------------------------
+
+  /// @returns The local port of the socket.
+  uint16_t port() const;
+
+  /// @returns The current counters.
+  statistics stats() const;
+
+  // -- consumer interface -----------------------------------------------------
+
+  /// Hands all pending batches to a function and recycles their buffers
+  /// afterwards. The function must not hold on to the text after returning.
+  /// @param f The function to call with the text of each batch and the number
+  ///        of datagrams it contains.
+  /// @returns The number of consumed batches.
+  size_t consume(const std::function<void(span<char>, size_t)>& f);
+
+private:
+  struct buffer {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+    size_t datagrams = 0;
+  };
+
+  /// The message headers for a batch, owned by the receive thread.
+  struct message_headers;
+
+  udp_receiver(int fd, uint16_t port, options opts,
+               std::function<void()> notify);
+
+  /// The loop of the receive thread.
+  void run();
+
+  /// Fills one buffer from the socket.
+  /// @returns The number of received datagrams, or -1 on error with `errno`
+  ///          set accordingly.
+  int receive(buffer& buf);
+
+  int fd_;
+  uint16_t port_;
+  options options_;
+  std::function<void()> notify_;
+  std::unique_ptr<message_headers> headers_;
+  /// The first `num_buffers` entries cycle between the receive thread and
+  /// the consumer; the last one receives datagrams that get dropped.
+  std::vector<buffer> buffers_;
+  std::atomic<bool> stop_ = false;
+  std::thread thread_;
+
+  /// Protects `free_`, `ready_`, and `stats_`.
+  mutable std::mutex mtx_;
+  std::vector<size_t> free_;
+  std::vector<size_t> ready_;
+  statistics stats_;
+};
+
+} // namespace vast::detail
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "vast/defaults.hpp"
+#include "vast/detail/posix.hpp"
 #include "vast/format/writer.hpp"
 #include "vast/fwd.hpp"
 #include "vast/type.hpp"
@@ -29,7 +30,10 @@
 
 namespace vast::format::arrow {
 
-/// An Arrow writer.
+/// An Arrow writer. By default, the writer prints an Arrow IPC stream to
+/// STDOUT. Alternatively, it places every record batch into a shared memory
+/// file and passes the file descriptor over a UNIX domain socket, which
+/// allows local consumers to map the batches without copying them.
 class writer : public format::writer {
 public:
   using defaults = vast::defaults::export_::arrow;
@@ -56,6 +60,16 @@ public:
   bool layout(const record_type& t);
 
 private:
+  /// Passes a record batch in shared memory over `socket_`.
+  caf::error write_shared(const ::arrow::RecordBatch& batch);
+
+  /// An error in the configuration, which the writer reports on the first
+  /// write.
+  caf::error config_error_;
+
+  /// The UNIX domain socket for passing shared memory to a local consumer.
+  std::shared_ptr<detail::unix_domain_socket> socket_;
+
   output_stream_ptr out_;
   record_type current_layout_;
   table_slice_builder_ptr current_builder_;
@@ -57,7 +57,7 @@ private:
 class reader final : public single_layout_reader {
 public:
   using super = single_layout_reader;
-  using iterator_type = std::string::const_iterator;
+  using iterator_type = std::string_view::const_iterator;
   using parser_type = type_erased_parser<iterator_type>;
 
   /// Constructs a CSV reader.
@@ -24,11 +24,15 @@
 #include "vast/json.hpp"
 #include "vast/logger.hpp"
 #include "vast/schema.hpp"
+#include "vast/type.hpp"
+#include "vast/view.hpp"
 
 #include <caf/expected.hpp>
 #include <caf/settings.hpp>
 
 #include <chrono>
+#include <string>
+#include <vector>
 
 namespace vast::format::json {
 
@@ -45,7 +49,31 @@ public:
   const char* name() const override;
 
 private:
+  /// The output fragments between the values of a layout, which only depend
+  /// on the field names and therefore get computed once per layout.
+  struct layout_state {
+    /// The layout of the table slices.
+    record_type layout;
+
+    /// The types of the columns.
+    std::vector<type> types;
+
+    /// The text before the value of each column, e.g., `, "uid": `.
+    std::vector<std::string> prefixes;
+
+    /// The text after the last value of a row, including the newline.
+    std::string suffix;
+  };
+
+  /// @returns the output fragments for *layout*.
+  const layout_state& state_for(const record_type& layout);
+
+  /// Appends a single value to `buf_`.
+  void append_value(data_view x);
+
   bool flatten_ = false;
+
+  std::vector<layout_state> layouts_;
 };
 
 /// Adds a JSON object to a table slice builder according to a given layout.
@@ -169,7 +197,7 @@ caf::error reader<Selector>::read_impl(size_t max_events, size_t max_slice_size,
       VAST_DEBUG(this, "stalled at line", lines_->line_number());
       return ec::stalled;
     }
-    auto& line = lines_->get();
+    auto line = lines_->get();
     ++num_lines_;
     if (line.empty()) {
       // Ignore empty lines.
@@ -180,7 +208,7 @@ caf::error reader<Selector>::read_impl(size_t max_events, size_t max_slice_size,
     if (!parsers::json(line, j)) {
       if (num_invalid_lines_ == 0)
         VAST_WARNING(this, "failed to parse line", lines_->line_number(), ":",
-                     line);
+                     std::string{line});
       ++num_invalid_lines_;
       continue;
     }
@@ -191,7 +219,7 @@ caf::error reader<Selector>::read_impl(size_t max_events, size_t max_slice_size,
     if (!layout) {
       if (num_unknown_layouts_ == 0)
         VAST_WARNING(this, "failed to find a matching type at line",
-                     lines_->line_number(), ":", line);
+                     lines_->line_number(), ":", std::string{line});
       ++num_unknown_layouts_;
       continue;
     }
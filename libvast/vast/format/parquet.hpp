@@ -0,0 +1,136 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/defaults.hpp"
+#include "vast/format/reader.hpp"
+#include "vast/format/writer.hpp"
+#include "vast/fwd.hpp"
+#include "vast/path.hpp"
+#include "vast/schema.hpp"
+#include "vast/type.hpp"
+
+#include <caf/error.hpp>
+#include <caf/expected.hpp>
+
+#include <arrow/io/api.h>
+#include <arrow/record_batch.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vast::format::parquet {
+
+/// The key in the schema metadata of a Parquet file that holds the
+/// serialized VAST layout.
+constexpr const char* layout_key = "VAST:layout";
+
+/// A writer for Apache Parquet. Because a Parquet file has a single schema,
+/// the writer creates one file per layout in its output directory.
+class writer : public format::writer {
+public:
+  using defaults = vast::defaults::export_::parquet;
+
+  explicit writer(const caf::settings& options);
+
+  writer(writer&&) = default;
+
+  writer& operator=(writer&&) = default;
+
+  /// Writes the remaining row groups and the footers of all files.
+  ~writer() override;
+
+  caf::error write(const table_slice& x) override;
+
+  const char* name() const override;
+
+private:
+  /// An open Parquet file for a single layout.
+  struct file_state {
+    record_type layout;
+    std::shared_ptr<::arrow::io::FileOutputStream> out;
+    std::unique_ptr<::parquet::arrow::FileWriter> writer;
+
+    /// Record batches that wait for the next row group.
+    std::vector<std::shared_ptr<::arrow::RecordBatch>> batches;
+
+    /// The number of rows in `batches`.
+    int64_t rows = 0;
+  };
+
+  /// @returns the open file for *layout*, opening it if necessary.
+  caf::expected<file_state*> file_for(const record_type& layout);
+
+  /// Writes the pending record batches of a file as row groups.
+  caf::error write_row_groups(file_state& file);
+
+  /// Writes the pending row groups and the footer of a file.
+  caf::error close(file_state& file);
+
+  /// An error in the configuration, which the writer reports on the first
+  /// write.
+  caf::error config_error_;
+
+  path directory_;
+  int64_t row_group_size_;
+  std::shared_ptr<::parquet::WriterProperties> properties_;
+  std::vector<std::unique_ptr<file_state>> files_;
+};
+
+/// A reader for Apache Parquet files that a ::writer produced. Parquet
+/// requires random access, so the reader maps regular files and buffers
+/// other input in memory.
+class reader final : public format::reader {
+public:
+  using super = format::reader;
+
+  /// Constructs a Parquet reader.
+  /// @param options Additional options.
+  /// @param in The input stream with the Parquet file.
+  reader(const caf::settings& options, std::unique_ptr<std::istream> in);
+
+  ~reader() override;
+
+  caf::error schema(vast::schema x) override;
+
+  vast::schema schema() const override;
+
+  const char* name() const override;
+
+protected:
+  caf::error read_impl(size_t max_events, size_t max_slice_size,
+                       consumer& f) override;
+
+private:
+  /// Opens the Parquet file and restores its layout.
+  caf::error open();
+
+  std::unique_ptr<std::istream> input_;
+  std::string filename_;
+  record_type layout_;
+  std::unique_ptr<::parquet::arrow::FileReader> file_;
+  std::unique_ptr<::arrow::RecordBatchReader> batches_;
+
+  /// The current record batch and the offset of its next row.
+  std::shared_ptr<::arrow::RecordBatch> batch_;
+  int64_t offset_ = 0;
+};
+
+} // namespace vast::format::parquet
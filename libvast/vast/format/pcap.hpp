@@ -17,7 +17,9 @@
 #include "vast/concept/hashable/hash_append.hpp"
 #include "vast/concept/hashable/xxhash.hpp"
 #include "vast/defaults.hpp"
+#include "vast/detail/flow_table.hpp"
 #include "vast/detail/operators.hpp"
+#include "vast/detail/pcap_trace.hpp"
 #include "vast/flow.hpp"
 #include "vast/format/reader.hpp"
 #include "vast/format/single_layout_reader.hpp"
@@ -32,8 +34,6 @@
 
 #include <chrono>
 #include <pcap.h>
-#include <random>
-#include <unordered_map>
 
 namespace vast {
 namespace format {
@@ -67,33 +67,20 @@ protected:
                        consumer& f) override;
 
 private:
-  struct flow_state {
-    uint64_t bytes;
-    uint64_t last;
-    std::string community_id;
-  };
-
-  /// @returns either an existing state associated to `x` or a new state for
-  ///          the flow.
-  flow_state& state(const flow& x);
-
   /// @returns whether `true` if the flow remains active, `false` if the flow
   ///          reached the configured cutoff.
-  bool update_flow(const flow& x, uint64_t packet_time, uint64_t payload_size);
+  bool update_flow(detail::flow_state& st, uint64_t payload_size);
 
   /// Evict all flows that have been inactive for the maximum age.
   void evict_inactive(uint64_t packet_time);
 
-  /// Evicts random flows when exceeding the maximum configured flow count.
-  void shrink_to_max_size();
-
   pcap_t* pcap_ = nullptr;
-  std::unordered_map<flow, flow_state> flows_;
+  caf::optional<detail::pcap_trace> trace_;
   std::string input_;
   caf::optional<std::string> interface_;
   uint64_t cutoff_;
   size_t max_flows_;
-  std::mt19937 generator_;
+  detail::flow_table flows_;
   uint64_t max_age_;
   uint64_t expire_interval_;
   uint64_t last_expire_ = 0;
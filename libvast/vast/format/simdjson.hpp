@@ -164,18 +164,22 @@ caf::error reader<Selector>::read_impl(size_t max_events, size_t max_slice_size,
       VAST_DEBUG(this, "stalled at line", lines_->line_number());
       return ec::stalled;
     }
-    auto& line = lines_->get();
+    auto line = lines_->get();
     ++num_lines_;
     if (line.empty()) {
       // Ignore empty lines.
       VAST_DEBUG(this, "ignores empty line at", lines_->line_number());
       continue;
     }
-    const auto [j, parse_error] = json_parser_.parse(line);
+    // The line range guarantees enough trailing bytes for simdjson to parse
+    // the line in place.
+    static_assert(detail::line_range::padding >= ::simdjson::SIMDJSON_PADDING);
+    const auto [j, parse_error]
+      = json_parser_.parse(line.data(), line.size(), false);
     if (parse_error != ::simdjson::SUCCESS) {
       if (num_invalid_lines_ == 0)
         VAST_WARNING(this, "failed to parse line", lines_->line_number(), ":",
-                     line);
+                     std::string{line});
       ++num_invalid_lines_;
       continue;
     }
@@ -186,7 +190,7 @@ caf::error reader<Selector>::read_impl(size_t max_events, size_t max_slice_size,
     if (!layout) {
       if (num_unknown_layouts_ == 0)
         VAST_WARNING(this, "failed to find a matching type at line",
-                     lines_->line_number(), ":", line);
+                     lines_->line_number(), ":", std::string{line});
       ++num_unknown_layouts_;
       continue;
     }
@@ -69,6 +69,7 @@ struct v0;
 
 class abstract_type;
 class address;
+class aggregation;
 class arrow_table_slice_builder;
 class bitmap;
 class chunk;
@@ -97,6 +98,7 @@ class table_slice_column;
 class type;
 class uuid;
 class value_index;
+class zone_map;
 
 namespace format {
 
@@ -123,6 +125,7 @@ class start_command;
 // -- structs ------------------------------------------------------------------
 
 struct address_type;
+struct aggregation_spec;
 struct alias_type;
 struct attribute_extractor;
 struct bool_type;
@@ -282,6 +285,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(vast, caf::first_custom_type_id)
   VAST_ADD_ATOM(empty, "empty")
   VAST_ADD_ATOM(enable, "enable")
   VAST_ADD_ATOM(erase, "erase")
+  VAST_ADD_ATOM(estimate, "estimate")
   VAST_ADD_ATOM(exists, "exists")
   VAST_ADD_ATOM(extract, "extract")
   VAST_ADD_ATOM(filesystem, "filesystem")
@@ -368,6 +372,8 @@ CAF_BEGIN_TYPE_ID_BLOCK(vast, caf::first_custom_type_id)
 
 #define VAST_ADD_TYPE_ID(type) CAF_ADD_TYPE_ID(vast, type)
 
+  VAST_ADD_TYPE_ID((vast::aggregation))
+  VAST_ADD_TYPE_ID((vast::aggregation_spec))
   VAST_ADD_TYPE_ID((vast::attribute_extractor))
   VAST_ADD_TYPE_ID((vast::bitmap))
   VAST_ADD_TYPE_ID((vast::conjunction))
@@ -48,6 +48,10 @@ private:
   caf::expected<ids>
   lookup_impl(relational_operator op, data_view x) const override;
 
+  /// Looks up addresses in sorted order, such that addresses with a common
+  /// prefix share the lookups of its bytes.
+  caf::expected<ids> lookup_many_impl(view<list> xs) const override;
+
   std::array<byte_index, 16> bytes_;
   type_index v4_;
 };
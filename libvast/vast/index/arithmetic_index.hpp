@@ -14,6 +14,7 @@
 #pragma once
 
 #include "vast/base.hpp"
+#include "vast/bitmap_algorithms.hpp"
 #include "vast/bitmap_index.hpp"
 #include "vast/coder.hpp"
 #include "vast/concept/parseable/to.hpp"
@@ -22,7 +23,6 @@
 #include "vast/detail/overload.hpp"
 #include "vast/error.hpp"
 #include "vast/ids.hpp"
-#include "vast/index/container_lookup.hpp"
 #include "vast/type.hpp"
 #include "vast/value_index.hpp"
 #include "vast/view.hpp"
@@ -34,13 +34,20 @@
 #include <caf/settings.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace vast {
 
 /// An index for arithmetic values.
-template <class T, class Binner = void>
+/// @tparam T The type of the values.
+/// @tparam Binner The binning policy, or `void` for a type-specific default.
+/// @tparam Coder The bitmap coder, or `void` for a multi-level range coder.
+///         A `bitslice_coder` stores one bitmap per bit of the value and
+///         answers range lookups in a single pass over the bits.
+template <class T, class Binner = void, class Coder = void>
 class arithmetic_index : public value_index {
 public:
   // clang-format off
@@ -65,7 +72,11 @@ public:
   using coder_type = std::conditional_t<
     std::is_same_v<T, bool>,
     singleton_coder<ids>,
-    multi_level_range_coder
+    std::conditional_t<
+      std::is_void_v<Coder>,
+      multi_level_range_coder,
+      Coder
+    >
   >;
   // clang-format on
 
@@ -106,6 +117,10 @@ public:
         VAST_ASSERT(b); // pre-condition is that this was validated
         bmi_ = bitmap_index_type{base{std::move(*b)}};
       }
+    } else if constexpr (is_bitslice_coder<coder_type>{}) {
+      using coder_value_type = typename coder_type::value_type;
+      bmi_ = bitmap_index_type{
+        size_t{std::numeric_limits<coder_value_type>::digits}};
     }
   }
 
@@ -154,11 +169,68 @@ private:
       [&](view<time> x) -> caf::expected<ids> {
         return bmi_.lookup(op, x.time_since_epoch().count());
       },
-      [&](view<list> xs) { return detail::container_lookup(*this, op, xs); },
     };
     return caf::visit(f, d);
   };
 
+  caf::expected<ids> lookup_many_impl(view<list> xs) const override {
+    std::vector<value_type> values;
+    values.reserve(xs->size());
+    for (auto x : *xs) {
+      auto f = [&](auto y) -> caf::error {
+        using view_type = decltype(y);
+        if constexpr (std::is_same_v<view_type, caf::none_t>) {
+          // Nil values are handled by lookup_many.
+        } else if constexpr (detail::is_any_v<view_type, view<bool>,
+                                              view<integer>, view<count>,
+                                              view<real>>) {
+          values.push_back(static_cast<value_type>(y));
+        } else if constexpr (std::is_same_v<view_type, view<duration>>) {
+          values.push_back(y.count());
+        } else if constexpr (std::is_same_v<view_type, view<time>>) {
+          values.push_back(y.time_since_epoch().count());
+        } else {
+          return make_error(ec::type_clash, value_type{}, materialize(y));
+        }
+        return caf::none;
+      };
+      if (auto err = caf::visit(f, x))
+        return err;
+    }
+    // Values that fall into the same bin have the same bitmap, so we only
+    // look up one value per bin.
+    auto bin = [](value_type x) { return binner_type::bin(x); };
+    std::sort(values.begin(), values.end(),
+              [&](auto lhs, auto rhs) { return bin(lhs) < bin(rhs); });
+    auto same_bin = [&](auto lhs, auto rhs) { return bin(lhs) == bin(rhs); };
+    values.erase(std::unique(values.begin(), values.end(), same_bin),
+                 values.end());
+    std::vector<ids> bitmaps;
+    if constexpr (std::is_integral_v<value_type>
+                  && !std::is_same_v<value_type, bool>) {
+      // Consecutive bins form a range, which costs two lookups in total
+      // rather than one per value.
+      for (size_t i = 0; i < values.size();) {
+        auto j = i;
+        while (j + 1 < values.size()
+               && bin(values[j + 1]) == bin(values[j]) + 1)
+          ++j;
+        if (i == j)
+          bitmaps.push_back(bmi_.lookup(equal, values[i]));
+        else
+          bitmaps.push_back(bmi_.lookup(greater_equal, values[i])
+                            & bmi_.lookup(less_equal, values[j]));
+        i = j + 1;
+      }
+    } else {
+      for (auto x : values)
+        bitmaps.push_back(bmi_.lookup(equal, x));
+    }
+    if (bitmaps.empty())
+      return ids{offset(), false};
+    return nary_or(bitmaps.begin(), bitmaps.end());
+  }
+
   bitmap_index_type bmi_;
 };
 
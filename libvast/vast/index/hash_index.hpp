@@ -187,67 +187,53 @@ private:
 
   caf::expected<ids>
   lookup_impl(relational_operator op, data_view x) const override {
-    VAST_ASSERT(rank(this->mask()) == digests_.size());
-    // Implementation of the one-pass search algorithm that computes the
-    // resulting ID set. The predicate depends on the operator and RHS.
-    auto scan = [&](auto predicate) -> ids {
-      ewah_bitmap result;
-      auto rng = select(this->mask());
-      if (rng.done())
-        return result;
-      for (size_t i = 0, last_match = 0; i < digests_.size(); ++i) {
-        if (predicate(digests_[i])) {
-          auto digests_since_last_match = i - last_match;
-          if (digests_since_last_match > 0)
-            rng.next(digests_since_last_match);
-          result.append_bits(false, rng.get() - result.size());
-          result.append_bit(true);
-          last_match = i;
-        }
-      }
-      return result;
-    };
     if (op == equal || op == not_equal) {
       auto k = find_digest(x);
       auto eq = [=](const digest_type& digest) { return k == digest; };
       auto ne = [=](const digest_type& digest) { return k != digest; };
       return op == equal ? scan(eq) : scan(ne);
     }
-    if (op == in || op == not_in) {
-      // Ensure that the RHS is a list of strings.
-      auto keys = caf::visit(
-        detail::overload{
-          [&](auto xs) -> caf::expected<std::vector<key>> {
-            using view_type = decltype(xs);
-            if constexpr (std::is_same_v<view_type, view<list>>) {
-              std::vector<key> result;
-              result.reserve(xs.size());
-              for (auto x : xs)
-                result.emplace_back(find_digest(x));
-              return result;
-            } else {
-              return make_error(ec::type_clash, "expected list on RHS",
-                                materialize(x));
-            }
-          },
-        },
-        x);
-      if (!keys)
-        return keys.error();
-      // We're good to go with: create the set predicates an run the scan.
-      auto in_pred = [&](const digest_type& digest) {
-        auto cmp = [=](auto& k) { return k == digest; };
-        return std::any_of(keys->begin(), keys->end(), cmp);
-      };
-      auto not_in_pred = [&](const digest_type& digest) {
-        auto cmp = [=](auto& k) { return k == digest; };
-        return std::none_of(keys->begin(), keys->end(), cmp);
-      };
-      return op == in ? scan(in_pred) : scan(not_in_pred);
-    }
+    // Membership lookups with a list on the RHS go through lookup_many_impl.
+    if (op == in || op == not_in)
+      return make_error(ec::type_clash, "expected list on RHS",
+                        materialize(x));
     return make_error(ec::unsupported_operator, op);
   }
 
+  caf::expected<ids> lookup_many_impl(view<list> xs) const override {
+    // A hash set of the keys keeps the scan linear in the number of digests,
+    // even for large lists on the RHS.
+    std::unordered_set<key, key_hasher> keys;
+    for (auto x : *xs)
+      if (!caf::holds_alternative<caf::none_t>(x))
+        keys.insert(find_digest(x));
+    return scan([&](const digest_type& digest) {
+      return keys.count(key{digest}) > 0;
+    });
+  }
+
+  /// Implementation of the one-pass search algorithm that computes the
+  /// resulting ID set. The predicate depends on the operator and RHS.
+  template <class Predicate>
+  ids scan(Predicate predicate) const {
+    VAST_ASSERT(rank(this->mask()) == digests_.size());
+    ewah_bitmap result;
+    auto rng = select(this->mask());
+    if (rng.done())
+      return result;
+    for (size_t i = 0, last_match = 0; i < digests_.size(); ++i) {
+      if (predicate(digests_[i])) {
+        auto digests_since_last_match = i - last_match;
+        if (digests_since_last_match > 0)
+          rng.next(digests_since_last_match);
+        result.append_bits(false, rng.get() - result.size());
+        result.append_bit(true);
+        last_match = i;
+      }
+    }
+    return result;
+  }
+
   bool immutable() const {
     return unique_digests_.empty() && !digests_.empty();
   }
@@ -0,0 +1,63 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/concept/hashable/xxhash.hpp"
+#include "vast/ids.hpp"
+#include "vast/value_index.hpp"
+#include "vast/view.hpp"
+
+#include <caf/error.hpp>
+#include <caf/expected.hpp>
+#include <caf/fwd.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace vast {
+
+/// An index for lists that maps every element value to the IDs of the lists
+/// containing it. In contrast to the `list_index`, which keeps one value index
+/// per element position, a membership lookup is a single hash table probe and
+/// every distinct element costs one bitmap, independent of the list length.
+/// Elements are keyed by their 64-bit digest, so lookups may yield false
+/// positives in the rare case of a hash collision. Numbers in lookups convert
+/// to the element type first, as long as the conversion is exact.
+/// @note Only supports the operators `ni` and `not_ni`.
+/// @note The factory only creates inverted indexes for lists of basic types;
+///       other lists fall back to the `list_index`.
+class inverted_index : public value_index {
+public:
+  /// The hash function for element digests.
+  using hasher_type = xxhash64;
+
+  /// Constructs an inverted index for a list type.
+  /// @param t The list type.
+  /// @param opts Runtime options for the index.
+  explicit inverted_index(vast::type t, caf::settings opts = {});
+
+  caf::error serialize(caf::serializer& sink) const override;
+
+  caf::error deserialize(caf::deserializer& source) override;
+
+private:
+  bool append_impl(data_view x, id pos) override;
+
+  caf::expected<ids>
+  lookup_impl(relational_operator op, data_view x) const override;
+
+  std::unordered_map<uint64_t, ids> elements_;
+};
+
+} // namespace vast
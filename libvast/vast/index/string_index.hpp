@@ -55,6 +55,10 @@ private:
   caf::expected<ids>
   lookup_impl(relational_operator op, data_view x) const override;
 
+  /// Looks up all strings of a list in one pass over their sorted sequence,
+  /// such that strings with a common prefix share its bitmap lookups.
+  caf::expected<ids> lookup_many_impl(view<list> xs) const override;
+
   size_t max_length_;
   length_bitmap_index length_;
   std::vector<char_bitmap_index> chars_;
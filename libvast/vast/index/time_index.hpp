@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/aliases.hpp"
+#include "vast/ids.hpp"
+#include "vast/time.hpp"
+#include "vast/value_index.hpp"
+#include "vast/view.hpp"
+
+#include <caf/error.hpp>
+#include <caf/expected.hpp>
+#include <caf/fwd.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace vast {
+
+/// An exact index for time values that exploits the nearly monotonic order of
+/// event timestamps. It splits the values into runs of consecutive IDs with
+/// non-decreasing values. A range query then boils down to a binary search
+/// per run, where every run contributes at most one sequence of IDs.
+/// @note Values that arrive out of order start a new run, so the index
+///       degrades gracefully for unordered values.
+class time_index : public value_index {
+public:
+  /// Constructs a time index.
+  /// @param t The time type.
+  /// @param opts Runtime options for the index.
+  explicit time_index(vast::type t, caf::settings opts = {});
+
+  caf::error serialize(caf::serializer& sink) const override;
+
+  caf::error deserialize(caf::deserializer& source) override;
+
+private:
+  /// A sequence of consecutive IDs with non-decreasing values.
+  struct run {
+    /// The ID of the first value.
+    id first;
+
+    /// The position of the first value in `values_`.
+    uint64_t position;
+
+    template <class Inspector>
+    friend auto inspect(Inspector& f, run& x) {
+      return f(x.first, x.position);
+    }
+  };
+
+  bool append_impl(data_view x, id pos) override;
+
+  caf::expected<ids>
+  lookup_impl(relational_operator op, data_view x) const override;
+
+  /// The runs, ordered by their first ID.
+  std::vector<run> runs_;
+
+  /// The values of all runs in nanoseconds since the epoch, in order.
+  std::vector<duration::rep> values_;
+};
+
+} // namespace vast
@@ -0,0 +1,112 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/address.hpp"
+#include "vast/ids.hpp"
+#include "vast/subnet.hpp"
+#include "vast/value_index.hpp"
+#include "vast/view.hpp"
+
+#include <caf/error.hpp>
+#include <caf/expected.hpp>
+#include <caf/fwd.hpp>
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace vast {
+
+/// An index for addresses and subnets that stores all values in a binary
+/// prefix trie with path compression, where every node maps a prefix to the
+/// IDs of the values equal to it. IPv4 values occupy the IPv4-mapped part of
+/// the IPv6 address space. Addresses are prefixes of length 128.
+///
+/// Subset queries (`in`) collect the subtree below a prefix, and superset
+/// queries (`ni`) collect the nodes on the path towards a prefix, each in a
+/// single traversal. Membership queries for a list of values descend into
+/// the trie once for all of them.
+class trie_index : public value_index {
+public:
+  /// Constructs a trie index.
+  /// @param t An address or subnet type.
+  /// @param opts Runtime options for the index.
+  explicit trie_index(vast::type t, caf::settings opts = {});
+
+  caf::error serialize(caf::serializer& sink) const override;
+
+  caf::error deserialize(caf::deserializer& source) override;
+
+private:
+  /// A network prefix with the host bits set to zero.
+  struct prefix {
+    address key;
+    uint8_t length;
+
+    friend bool operator<(const prefix& x, const prefix& y) {
+      return std::tie(x.key, x.length) < std::tie(y.key, y.length);
+    }
+
+    friend bool operator==(const prefix& x, const prefix& y) {
+      return x.key == y.key && x.length == y.length;
+    }
+  };
+
+  /// A node of the trie. Nodes that only exist for branching have no IDs.
+  struct node {
+    address key;
+    uint8_t length = 0;
+    ids rows;
+    std::array<uint32_t, 2> children = {{0, 0}};
+
+    template <class Inspector>
+    friend auto inspect(Inspector& f, node& x) {
+      return f(x.key, x.length, x.rows, x.children);
+    }
+  };
+
+  /// Converts a subnet into a prefix of the IPv6 address space.
+  static prefix make_prefix(const subnet& x);
+
+  bool append_impl(data_view x, id pos) override;
+
+  caf::expected<ids>
+  lookup_impl(relational_operator op, data_view x) const override;
+
+  caf::expected<ids> lookup_many_impl(view<list> xs) const override;
+
+  /// Returns the position of the node for a prefix, adding it if necessary.
+  uint32_t insert(const prefix& x);
+
+  /// Collects the IDs of all values that are equal to one of the sorted
+  /// prefixes, or that lie within one of them, starting at a given node.
+  void collect(uint32_t position, const prefix* first, const prefix* last,
+               bool within, std::vector<ids>& result) const;
+
+  /// Collects the IDs of all values in the subtree of a node.
+  void collect_subtree(uint32_t position, std::vector<ids>& result) const;
+
+  /// Collects the IDs of all values that include a prefix.
+  void collect_supersets(const prefix& x, std::vector<ids>& result) const;
+
+  /// Computes the union of collected IDs.
+  ids unite(const std::vector<ids>& xs) const;
+
+  /// The nodes of the trie, with the root for the empty prefix at position 0.
+  std::vector<node> nodes_;
+};
+
+} // namespace vast
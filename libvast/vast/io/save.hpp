@@ -26,4 +26,11 @@ namespace vast::io {
 /// @returns An error if the operation failed.
 [[nodiscard]] caf::error save(const path& filename, span<const byte> xs);
 
+/// Writes the concatenation of a sequence of chunks to a temporary file and
+/// atomically renames it to *filename* afterwards.
+/// @param filename The file to write to.
+/// @param xs The chunks to read from.
+/// @returns An error if the operation failed.
+[[nodiscard]] caf::error save(const path& filename, span<const chunk_ptr> xs);
+
 } // namespace vast::io
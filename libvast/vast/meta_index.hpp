@@ -32,6 +32,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace vast {
@@ -62,6 +63,9 @@ struct partition_synopsis {
 
   /// Synopsis data structures for individual columns.
   std::unordered_map<qualified_record_field, synopsis_ptr> field_synopses_;
+
+  /// The number of events per layout.
+  std::unordered_map<std::string, uint64_t> layout_events_;
 };
 
 /// The meta index is the first data structure that queries hit. The result
@@ -96,6 +100,15 @@ public:
   /// @returns A vector of UUIDs representing candidate partitions.
   std::vector<uuid> lookup(const expression& expr) const;
 
+  /// Bounds the number of events that match an expression from the event
+  /// counts per layout and the synopses alone, i.e., without asking the
+  /// partitions.
+  /// @param expr The expression to estimate.
+  /// @returns A lower and an upper bound for the number of matching events.
+  /// @note The lower bound assumes that columns with a synopsis contain no
+  ///       null values.
+  std::pair<uint64_t, uint64_t> estimate(const expression& expr) const;
+
   /// @returns A best-effort estimate of the amount of memory used for this meta
   /// index (in bytes).
   size_t size_bytes() const;
@@ -15,6 +15,8 @@
 
 #include "vast/fwd.hpp"
 
+#include "vast/aggregation.hpp"
+#include "vast/expression.hpp"
 #include "vast/ids.hpp"
 #include "vast/store.hpp"
 #include "vast/system/accountant_actor.hpp"
@@ -23,15 +25,39 @@
 
 #include <memory>
 #include <queue>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace vast::system {
 
 /// @relates archive
 struct archive_state {
+  /// The fields that an exporter asked for, along with its query that
+  /// determines the additional columns for its candidate check.
+  struct projection {
+    std::vector<std::string> fields;
+    expression expr;
+    /// Caches the selected columns per layout.
+    std::unordered_map<type, std::vector<size_t>> columns;
+  };
+  /// The query of a client that aggregates in the ARCHIVE, along with the
+  /// partial aggregation of the current session.
+  struct aggregator {
+    expression expr;
+    /// Caches the query tailored to different layouts.
+    std::unordered_map<type, expression> checkers;
+    vast::aggregation partial;
+  };
   void send_report();
   void next_session();
+  /// Aggregates the rows of a table slice that match the query of a client.
+  void aggregate(aggregator& x, const table_slice& slice, const ids& selection);
+  /// Trims a table slice to the columns that a requester asked for.
+  /// @returns the projected slice, or an invalid slice if the layout of *slice*
+  ///          has none of the requested fields.
+  table_slice project(const caf::actor_addr& requester, table_slice slice);
   archive_actor::pointer self;
   std::unique_ptr<vast::store> store;
   std::unique_ptr<vast::store::lookup> session;
@@ -39,6 +65,8 @@ struct archive_state {
   std::queue<archive_client_actor> requesters;
   std::unordered_map<caf::actor_addr, std::queue<ids>> unhandled_ids;
   std::unordered_set<caf::actor_addr> active_exporters;
+  std::unordered_map<caf::actor_addr, projection> projections;
+  std::unordered_map<caf::actor_addr, aggregator> aggregators;
   vast::system::measurement measurement;
   accountant_actor accountant;
   static inline const char* name = "archive";
@@ -21,6 +21,9 @@
 
 #include <caf/typed_event_based_actor.hpp>
 
+#include <string>
+#include <vector>
+
 namespace vast::system {
 
 using archive_actor = caf::typed_actor<
@@ -30,6 +33,13 @@ using archive_actor = caf::typed_actor<
   // Register an exporter actor.
   // TODO: This should probably take an archive_client_actor.
   caf::reacts_to<atom::exporter, caf::actor>,
+  // Register an exporter actor that only wants the given fields of the events
+  // that match its query.
+  caf::reacts_to<atom::exporter, caf::actor, std::vector<std::string>,
+                 expression>,
+  // Register a client that receives partial aggregations of the events that
+  // match its query instead of the events themselves.
+  caf::reacts_to<atom::exporter, caf::actor, expression, aggregation_spec>,
   // Registers the ARCHIVE with the ACCOUNTANT.
   caf::reacts_to<accountant_actor>,
   // Starts handling a query for the given ids.
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/fwd.hpp"
+
+#include "vast/defaults.hpp"
+#include "vast/path.hpp"
+#include "vast/system/filesystem_actor.hpp"
+#include "vast/system/filesystem_statistics.hpp"
+
+#include <caf/actor.hpp>
+#include <caf/expected.hpp>
+#include <caf/settings.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace vast::system {
+
+/// Configures an ::async_filesystem.
+struct async_filesystem_config {
+  /// Controls how writes reach stable storage.
+  enum class sync_policy {
+    /// Leaves flushing to the operating system.
+    none,
+    /// Flushes the file contents before renaming the file into place.
+    data,
+    /// Additionally flushes the file metadata and the parent directory, which
+    /// makes the write survive a power loss.
+    full,
+  };
+
+  /// The number of I/O threads. A value of 0 performs all operations
+  /// synchronously in the filesystem actor.
+  size_t threads = defaults::system::filesystem_threads;
+
+  /// The maximum number of outstanding operations per I/O thread. The
+  /// filesystem queues further operations until an I/O thread catches up.
+  size_t queue_depth = defaults::system::filesystem_queue_depth;
+
+  /// The durability guarantee for writes.
+  sync_policy sync = sync_policy::none;
+
+  /// Evicts written files from the page cache. This keeps large partition
+  /// writes from displacing hot data, similar to `O_DIRECT`.
+  bool drop_cache = false;
+};
+
+/// Reads the filesystem configuration from the `vast.filesystem` settings.
+/// @relates async_filesystem_config
+caf::expected<async_filesystem_config>
+to_async_filesystem_config(const caf::settings& opts);
+
+/// The state for the asynchronous filesystem.
+/// @relates async_filesystem
+struct async_filesystem_state {
+  /// A deferred operation that waits for an available I/O thread. Takes the
+  /// index of the I/O thread to run on.
+  using operation = std::function<void(size_t)>;
+
+  /// The configuration.
+  async_filesystem_config config;
+
+  /// The I/O threads.
+  std::vector<caf::actor> workers;
+
+  /// The number of outstanding operations per I/O thread.
+  std::vector<size_t> load;
+
+  /// Operations that exceed the queue depth of all I/O threads.
+  std::deque<operation> pending;
+
+  /// The files with a write in progress, mapped to the writes that wait for
+  /// it to complete.
+  std::unordered_map<path, std::deque<std::function<void()>>> writes;
+
+  /// Statistics about filesystem operations.
+  filesystem_statistics stats;
+
+  /// Latencies from receiving a request until delivering its response.
+  latency_histogram write_latency;
+  latency_histogram read_latency;
+  latency_histogram mmap_latency;
+
+  /// The actor name.
+  static inline const char* name = "async-filesystem";
+};
+
+/// A filesystem that performs blocking I/O on a pool of dedicated threads so
+/// that a large write does not delay all other operations behind it.
+/// @param self The actor handle.
+/// @param root The filesystem root. The actor prepends this path to all
+///             operations that include a path parameter.
+/// @param config The filesystem configuration.
+/// @returns The actor behavior.
+filesystem_actor::behavior_type
+async_filesystem(filesystem_actor::stateful_pointer<async_filesystem_state> self,
+                 path root, async_filesystem_config config);
+
+} // namespace vast::system
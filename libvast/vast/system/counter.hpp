@@ -15,6 +15,7 @@
 
 #include "vast/fwd.hpp"
 
+#include "vast/aggregation.hpp"
 #include "vast/expression.hpp"
 #include "vast/ids.hpp"
 #include "vast/system/archive_actor.hpp"
@@ -25,6 +26,16 @@
 
 namespace vast::system {
 
+/// Determines how the COUNTER evaluates a query.
+enum class count_mode {
+  /// Counts exactly by checking the candidates from the INDEX.
+  exact,
+  /// Estimates an upper bound by skipping the candidate checks.
+  estimate,
+  /// Bounds the count from the META INDEX without querying any partitions.
+  approximate,
+};
+
 class counter_state : public query_processor {
 public:
   // -- member types -----------------------------------------------------------
@@ -40,7 +51,7 @@ public:
   counter_state(caf::event_based_actor* self);
 
   void init(expression expr, index_actor index, archive_actor archive,
-            bool skip_candidate_check);
+            count_mode mode, aggregation_spec spec);
 
 protected:
   // -- implementation hooks ---------------------------------------------------
@@ -58,6 +69,10 @@ private:
   /// Stores the user-defined query.
   expression expr_;
 
+  /// Groups the results if it has keys, in which case the ARCHIVE performs
+  /// the candidate checks and aggregates the results.
+  aggregation_spec spec_;
+
   /// Points to the ARCHIVE for performing candidate checks.
   archive_actor archive_;
 
@@ -76,6 +91,7 @@ private:
 
 caf::behavior
 counter(caf::stateful_actor<counter_state>* self, expression expr,
-        index_actor index, archive_actor archive, bool skip_candidate_check);
+        index_actor index, archive_actor archive, count_mode mode,
+        aggregation_spec spec = {});
 
 } // namespace vast::system
@@ -21,13 +21,16 @@
 #include "vast/concept/printable/vast/expression.hpp"
 #include "vast/defaults.hpp"
 #include "vast/detail/assert.hpp"
+#include "vast/detail/udp_receiver.hpp"
 #include "vast/error.hpp"
 #include "vast/expression.hpp"
 #include "vast/expression_visitors.hpp"
 #include "vast/logger.hpp"
 #include "vast/schema.hpp"
 #include "vast/system/accountant_actor.hpp"
+#include "vast/system/report.hpp"
 #include "vast/system/source.hpp"
+#include "vast/span.hpp"
 #include "vast/table_slice.hpp"
 #include "vast/table_slice_builder_factory.hpp"
 
@@ -35,10 +38,13 @@
 #include <caf/event_based_actor.hpp>
 #include <caf/expected.hpp>
 #include <caf/io/broker.hpp>
+#include <caf/send.hpp>
 #include <caf/stateful_actor.hpp>
 #include <caf/stream_source.hpp>
 #include <caf/streambuf.hpp>
 
+#include <memory>
+#include <string>
 #include <unordered_map>
 
 namespace vast::system {
@@ -63,6 +69,13 @@ struct datagram_source_state : source_state<Reader, caf::io::broker> {
 
   /// Timestamp when the source was started.
   caf::timestamp start_time;
+
+  /// Receives datagrams in batches on a dedicated thread, unless the source
+  /// uses the datagram servant of the multiplexer.
+  std::unique_ptr<detail::udp_receiver> receiver;
+
+  /// The receiver counters at the last heartbeat.
+  detail::udp_receiver::statistics receiver_stats;
 };
 
 template <class Reader>
@@ -73,6 +86,8 @@ using datagram_source_actor = caf::stateful_actor<datagram_source_state<Reader>,
 /// @tparam Reader The concrete source implementation.
 /// @param self The actor handle.
 /// @param udp_listening_port The requested port.
+/// @param receiver_options Configures batched reception on a dedicated thread;
+///        a batch size of 0 uses the datagram servant of the multiplexer.
 /// @param reader The reader instance.
 /// @param table_slice_size The maximum size for a table slice.
 /// @param max_events The optional maximum amount of events to import.
@@ -83,20 +98,39 @@ using datagram_source_actor = caf::stateful_actor<datagram_source_state<Reader>,
 template <class Reader>
 caf::behavior
 datagram_source(datagram_source_actor<Reader>* self,
-                uint16_t udp_listening_port, Reader reader,
+                uint16_t udp_listening_port,
+                detail::udp_receiver::options receiver_options, Reader reader,
                 size_t table_slice_size, caf::optional<size_t> max_events,
                 type_registry_actor type_registry, vast::schema local_schema,
                 std::string type_filter, accountant_actor accountant) {
+  auto& st = self->state;
   // Try to open requested UDP port.
-  auto udp_res = self->add_udp_datagram_servant(udp_listening_port);
-  if (!udp_res) {
-    VAST_ERROR(self, "could not open port", udp_listening_port);
-    self->quit(std::move(udp_res.error()));
-    return {};
+  if (receiver_options.batch_size > 0) {
+    // The receive thread must not keep the source alive.
+    auto weak_self = caf::actor_cast<caf::weak_actor_ptr>(self);
+    auto notify = [weak_self] {
+      if (auto hdl = weak_self.lock())
+        caf::anon_send(caf::actor_cast<caf::actor>(hdl), atom::wakeup_v);
+    };
+    auto receiver = detail::udp_receiver::make(udp_listening_port,
+                                               receiver_options, notify);
+    if (!receiver) {
+      VAST_ERROR(self, "could not open port", udp_listening_port);
+      self->quit(std::move(receiver.error()));
+      return {};
+    }
+    st.receiver = std::move(*receiver);
+    VAST_DEBUG(self, "starts listening at port", st.receiver->port());
+  } else {
+    auto udp_res = self->add_udp_datagram_servant(udp_listening_port);
+    if (!udp_res) {
+      VAST_ERROR(self, "could not open port", udp_listening_port);
+      self->quit(std::move(udp_res.error()));
+      return {};
+    }
+    VAST_DEBUG(self, "starts listening at port", udp_res->second);
   }
-  VAST_DEBUG(self, "starts listening at port", udp_res->second);
   // Initialize state.
-  auto& st = self->state;
   st.init(self, std::move(reader), std::move(max_events),
           std::move(type_registry), std::move(local_schema),
           std::move(type_filter), std::move(accountant));
@@ -112,41 +146,55 @@ datagram_source(datagram_source_actor<Reader>* self,
     },
     // done?
     [=](const caf::unit_t&) { return self->state.done; });
+  // Parses a buffer that holds one or more datagrams.
+  auto handle_input = [=](span<char> input, size_t datagrams) {
+    // Check whether we can buffer more slices in the stream.
+    auto& st = self->state;
+    auto t = timer::start(st.metrics);
+    auto capacity = st.mgr->out().capacity();
+    if (capacity == 0) {
+      st.dropped_packets += datagrams;
+      return;
+    }
+    // Extract events until the source has exhausted its input or until
+    // we have completed a batch.
+    caf::arraybuf<> buf{input.data(), input.size()};
+    st.reader.reset(std::make_unique<std::istream>(&buf));
+    auto push_slice = [&](table_slice slice) {
+      VAST_DEBUG(self, "produced a slice with", slice.rows(), "rows");
+      st.mgr->out().push(std::move(slice));
+    };
+    auto events = capacity * table_slice_size;
+    if (st.requested)
+      events = std::min(events, *st.requested - st.count);
+    auto [err, produced] = st.reader.read(events, table_slice_size,
+                                          push_slice);
+    t.stop(produced);
+    st.count += produced;
+    if (st.requested && st.count >= *st.requested)
+      st.done = true;
+    if (err != caf::none && err != ec::end_of_input)
+      VAST_WARNING(self,
+                   "has not enough capacity left in stream, dropping input!");
+    if (produced > 0)
+      st.mgr->push();
+    if (st.done)
+      st.send_report();
+  };
   return {
     [=](caf::io::new_datagram_msg& msg) {
-      // Check whether we can buffer more slices in the stream.
       VAST_DEBUG(self, "got a new datagram of size", msg.buf.size());
+      handle_input(span<char>{msg.buf.data(), msg.buf.size()}, 1);
+    },
+    [=](atom::wakeup) {
       auto& st = self->state;
-      auto t = timer::start(st.metrics);
-      auto capacity = st.mgr->out().capacity();
-      if (capacity == 0) {
-        st.dropped_packets++;
+      if (!st.receiver)
         return;
-      }
-      // Extract events until the source has exhausted its input or until
-      // we have completed a batch.
-      caf::arraybuf<> buf{msg.buf.data(), msg.buf.size()};
-      st.reader.reset(std::make_unique<std::istream>(&buf));
-      auto push_slice = [&](table_slice slice) {
-        VAST_DEBUG(self, "produced a slice with", slice.rows(), "rows");
-        st.mgr->out().push(std::move(slice));
-      };
-      auto events = capacity * table_slice_size;
-      if (st.requested)
-        events = std::min(events, *st.requested - st.count);
-      auto [err, produced] = st.reader.read(events, table_slice_size,
-                                            push_slice);
-      t.stop(produced);
-      st.count += produced;
-      if (st.requested && st.count >= *st.requested)
-        st.done = true;
-      if (err != caf::none && err != ec::end_of_input)
-        VAST_WARNING(self,
-                     "has not enough capacity left in stream, dropping input!");
-      if (produced > 0)
-        st.mgr->push();
+      auto batches = st.receiver->consume(handle_input);
+      VAST_DEBUG(self, "consumed", batches, "batches of datagrams");
+      // Stop receiving once we reached the maximum number of events.
       if (st.done)
-        st.send_report();
+        st.receiver.reset();
     },
     [=](accountant_actor accountant) {
       VAST_DEBUG(self, "sets accountant to", accountant);
@@ -202,6 +250,33 @@ datagram_source(datagram_source_actor<Reader>* self,
                      st.dropped_packets, "packets");
         st.dropped_packets = 0;
       }
+      if (st.receiver) {
+        using namespace std::string_literals;
+        auto stats = st.receiver->stats();
+        auto& last = st.receiver_stats;
+        uint64_t received = stats.received - last.received;
+        uint64_t kernel_drops = stats.kernel_drops - last.kernel_drops;
+        uint64_t application_drops
+          = stats.application_drops - last.application_drops;
+        uint64_t truncated = stats.truncated - last.truncated;
+        last = stats;
+        if (kernel_drops > 0)
+          VAST_WARNING(self, "lost", kernel_drops,
+                       "datagrams in a full socket receive buffer");
+        if (application_drops > 0)
+          VAST_WARNING(self, "has no buffers left and dropped",
+                       application_drops, "datagrams");
+        if (truncated > 0)
+          VAST_WARNING(self, "truncated", truncated, "oversized datagrams");
+        auto name = std::string{st.name};
+        self->send(st.accountant,
+                   report{
+                     {name + ".udp.recv"s, received},
+                     {name + ".udp.kernel-drop"s, kernel_drops},
+                     {name + ".udp.application-drop"s, application_drops},
+                     {name + ".udp.truncated"s, truncated},
+                   });
+      }
       if (!st.done)
         self->delayed_send(self, defaults::system::telemetry_rate,
                            atom::telemetry_v);
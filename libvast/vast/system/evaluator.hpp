@@ -43,10 +43,14 @@ struct evaluator_state {
   /// Evaluates the predicate-tree and may produces new deltas.
   void evaluate();
 
-  /// Decrements the `pending_responses` and sends 'done' to the client when it
-  /// reaches 0.
+  /// Decrements the `pending_responses` and dispatches the next stage when it
+  /// reaches 0, or sends 'done' to the client if no rows can match anymore.
   void decrement_pending();
 
+  /// Requests the hits of all predicates in the next stage from the INDEXER
+  /// actors.
+  void dispatch();
+
   /// Returns the `predicate_hits` entry for `pred` or `nullptr`.
   predicate_hits_map::mapped_type* hits_for(const offset& position);
 
@@ -59,6 +63,20 @@ struct evaluator_state {
   /// Stores hits for the expression.
   ids hits;
 
+  /// Restricts the hits to these IDs, unless empty.
+  ids candidates;
+
+  /// Groups of evaluation triples that get dispatched one after another. A
+  /// top-level conjunction has one stage per conjunct, so that the evaluation
+  /// can stop as soon as the conjuncts cannot match any row together.
+  std::vector<std::vector<evaluation_triple>> stages;
+
+  /// The position of the next stage to dispatch.
+  size_t next_stage = 0;
+
+  /// Stores the intersection of the hits of all completed conjuncts.
+  ids intersection;
+
   /// Points to the parent actor.
   evaluator_actor::pointer self;
 
@@ -77,9 +95,15 @@ struct evaluator_state {
 
 /// Wraps a query expression in an actor. Upon receiving hits from INDEXER
 /// actors, re-evaluates the expression and relays new hits to the INDEX CLIENT.
+/// The conjuncts of a top-level conjunction are evaluated one after another in
+/// the order of their first evaluation triple, and skipped once no row can
+/// satisfy all completed conjuncts.
+/// @param candidates The IDs that may match the expression, e.g., as
+///        determined by a zone map. An empty set applies no restriction.
 /// @pre `!eval.empty()`
 evaluator_actor::behavior_type
 evaluator(evaluator_actor::stateful_pointer<evaluator_state> self,
-          expression expr, std::vector<evaluation_triple> eval);
+          expression expr, std::vector<evaluation_triple> eval,
+          ids candidates);
 
 } // namespace vast::system
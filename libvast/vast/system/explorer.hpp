@@ -15,16 +15,19 @@
 
 #include "vast/fwd.hpp"
 
+#include "vast/defaults.hpp"
 #include "vast/expression.hpp"
+#include "vast/ids.hpp"
 #include "vast/system/node.hpp"
 #include "vast/type.hpp"
 
 #include <caf/actor.hpp>
 #include <caf/fwd.hpp>
 
+#include <deque>
+#include <optional>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 
 namespace vast::system {
 
@@ -41,6 +44,22 @@ struct explorer_state {
   /// Send the results to the sink, after removing duplicates.
   void forward_results(vast::table_slice slice);
 
+  /// Builds a single query for the context around all events of a table
+  /// slice. Merges overlapping time boxes and events with identical values of
+  /// the `by` field.
+  /// @param slice The results of the initial query.
+  /// @returns The query along with the number of events whose context it
+  ///          covers, or `std::nullopt` if no event has a context.
+  std::optional<std::pair<expression, size_t>>
+  make_context_query(const table_slice& slice) const;
+
+  /// Spawns EXPORTERs for pending context queries until reaching the maximum
+  /// number of concurrently running EXPORTERs.
+  void spawn_exporters();
+
+  /// Terminates the EXPLORER once all queries completed.
+  void quit_if_done();
+
   /// Maximum number of events to output.
   event_limits limits;
 
@@ -58,11 +77,18 @@ struct explorer_state {
 
   /// Keeps a record of the ids that were already returned to the sink,
   /// for the purpose of deduplication.
-  std::unordered_set<size_t> returned_ids;
+  vast::ids returned_ids;
+
+  /// Context queries that wait for an EXPORTER, along with the maximum number
+  /// of events to export for them.
+  std::deque<std::pair<expression, uint64_t>> pending_queries;
 
   /// A tracking counter of spawned exporters. Used for lifetime management.
   size_t running_exporters = 0;
 
+  /// The maximum number of concurrently running exporters.
+  size_t max_running_exporters = defaults::explore::max_running_exporters;
+
   /// Flag that stores if the input source is done sending table slices. Used
   /// for lifetime management.
   bool initial_query_completed = false;
@@ -24,6 +24,10 @@
 #include "vast/table_slice.hpp"
 #include "vast/uuid.hpp"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace vast::system {
 
 struct exporter_state {
@@ -73,6 +77,13 @@ struct exporter_state {
 
   /// Stores the user-defined export query.
   expression expr;
+
+  /// Stores the fields that the results get trimmed to, or nothing to include
+  /// all fields.
+  std::vector<std::string> fields;
+
+  /// Caches the columns that the results get trimmed to per layout.
+  std::unordered_map<type, std::vector<size_t>> projections;
 };
 
 /// The EXPORTER receives index hits, looks up the corresponding events in the
@@ -81,8 +92,10 @@ struct exporter_state {
 /// @param self The actor handle of the exporter.
 /// @param expr The AST of the query.
 /// @param opts The query options.
+/// @param fields The fields to include in the results, or nothing to include
+///               all fields.
 exporter_actor::behavior_type
 exporter(exporter_actor::stateful_pointer<exporter_state> self, expression expr,
-         query_options opts);
+         query_options opts, std::vector<std::string> fields);
 
 } // namespace vast::system
@@ -19,6 +19,8 @@
 
 #include <caf/typed_event_based_actor.hpp>
 
+#include <vector>
+
 namespace vast::system {
 
 /// The interface for file system I/O. The filesystem actor implementation must
@@ -29,6 +31,10 @@ using filesystem_actor = caf::typed_actor<
   // if needed.
   caf::replies_to<atom::write, path, chunk_ptr>::with< //
     atom::ok>,
+  // Writes the concatenation of multiple chunks to a given path. Creates
+  // intermediate directories if needed.
+  caf::replies_to<atom::write, path, std::vector<chunk_ptr>>::with< //
+    atom::ok>,
   // Reads a chunk of data from a given path and returns the chunk.
   caf::replies_to<atom::read, path>::with< //
     chunk_ptr>,
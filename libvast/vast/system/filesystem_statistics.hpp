@@ -17,6 +17,9 @@
 
 #include <caf/meta/type_name.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 namespace vast::system {
@@ -48,4 +51,26 @@ struct filesystem_statistics {
   }
 };
 
+/// A histogram of operation latencies. The upper bound of bucket *i* is
+/// 2^*i* microseconds; the last bucket collects everything beyond.
+struct latency_histogram {
+  static constexpr size_t num_buckets = 24;
+
+  /// Records a single latency.
+  void add(std::chrono::steady_clock::duration x) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(x).count();
+    size_t i = 0;
+    while (i + 1 < num_buckets && (int64_t{1} << i) < us)
+      ++i;
+    ++buckets[i];
+  }
+
+  /// @returns The upper bound of the bucket in microseconds.
+  static constexpr uint64_t upper_bound(size_t bucket) {
+    return uint64_t{1} << bucket;
+  }
+
+  std::array<uint64_t, num_buckets> buckets = {};
+};
+
 } // namespace vast::system
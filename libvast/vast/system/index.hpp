@@ -25,22 +25,33 @@
 #include "vast/system/flush_listener_actor.hpp"
 #include "vast/system/index_actor.hpp"
 #include "vast/system/partition.hpp"
+#include "vast/system/predicate_cache.hpp"
 #include "vast/system/query_supervisor.hpp"
+#include "vast/time.hpp"
 #include "vast/uuid.hpp"
 
 #include <caf/actor.hpp>
+#include <caf/actor_clock.hpp>
 #include <caf/behavior.hpp>
+#include <caf/broadcast_downstream_manager.hpp>
 #include <caf/fwd.hpp>
 #include <caf/meta/omittable_if_empty.hpp>
 #include <caf/meta/type_name.hpp>
 #include <caf/response_promise.hpp>
 
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace vast::system {
 
-/// The state of the active partition.
+/// Helper class used to route table slices to the active partition of their
+/// layout in the CAF stream stage. An empty filter accepts all layouts.
+struct layout_selector {
+  bool operator()(const std::string& filter, const table_slice& x) const;
+};
+
+/// The state of an active partition.
 struct active_partition_info {
   /// The partition actor.
   active_partition_actor actor;
@@ -54,6 +65,9 @@ struct active_partition_info {
   /// The UUID of the partition.
   uuid id;
 
+  /// The time when the partition last received events; not persisted.
+  caf::actor_clock::time_point last_write;
+
   template <class Inspector>
   friend auto inspect(Inspector& f, active_partition_info& x) {
     return f(caf::meta::type_name("active_partition_info"), x.actor,
@@ -120,9 +134,12 @@ struct query_state {
 struct index_state {
   // -- type aliases -----------------------------------------------------------
 
+  using index_downstream_manager
+    = caf::broadcast_downstream_manager<table_slice, std::string,
+                                        layout_selector>;
+
   using index_stream_stage_ptr
-    = caf::stream_stage_ptr<table_slice,
-                            caf::broadcast_downstream_manager<table_slice>>;
+    = caf::stream_stage_ptr<table_slice, index_downstream_manager>;
 
   // -- constructor ------------------------------------------------------------
 
@@ -161,6 +178,12 @@ struct index_state {
   /// Sends a notification to all listeners and clears the listeners list.
   void notify_flush_listeners();
 
+  // -- telemetry --------------------------------------------------------------
+
+  /// Reports the effectiveness of the predicate cache since the last report
+  /// to the ACCOUNTANT.
+  void send_report();
+
   // -- data members ----------------------------------------------------------
 
   /// Pointer to the parent actor.
@@ -169,8 +192,10 @@ struct index_state {
   /// The streaming stage.
   index_stream_stage_ptr stage;
 
-  /// The single active (read/write) partition.
-  active_partition_info active_partition = {};
+  /// The active (read/write) partitions, keyed by the name of the layout that
+  /// they accept. Unless `partition_per_layout` is set, there exists at most
+  /// one active partition with an empty key that accepts all layouts.
+  std::unordered_map<std::string, active_partition_info> active_partitions;
 
   /// Partitions that are currently in the process of persisting.
   // TODO: An alternative to keeping an explicit set of unpersisted partitions
@@ -191,6 +216,9 @@ struct index_state {
   /// The maximum number of events that a partition can hold.
   size_t partition_capacity;
 
+  /// Whether every layout gets its own active partition.
+  bool partition_per_layout = false;
+
   // The maximum size of the partition LRU cache (or the maximum number of
   // read-only partition loaded to memory).
   size_t max_inmem_partitions;
@@ -216,6 +244,12 @@ struct index_state {
   // Handle of the accountant.
   accountant_actor accountant;
 
+  /// Caches the results of predicates for passive partitions; may be null.
+  predicate_cache_ptr cache;
+
+  /// The cache statistics at the time of the last telemetry report.
+  predicate_cache::statistics reported_cache_stats;
+
   /// List of actors that wait for the next flush event.
   std::vector<flush_listener_actor> flush_listeners;
 
@@ -240,11 +274,18 @@ pack(flatbuffers::FlatBufferBuilder& builder, const index_state& x);
 /// @param taste_partitions How many lookup partitions to schedule immediately.
 /// @param num_workers The maximum amount of concurrent lookups.
 /// @param meta_index_fp_rate The false positive rate for the meta index.
+/// @param predicate_cache_size The maximum number of bytes for caching
+///        predicate results of passive partitions, or 0 to disable caching.
+/// @param partition_per_layout Whether to build homogeneous partitions that
+///        contain events of a single layout only.
+/// @param active_partition_timeout The time without new events after which
+///        an active partition gets persisted, or 0 to keep it until full.
 /// @pre `partition_capacity > 0
 index_actor::behavior_type
 index(index_actor::stateful_pointer<index_state> self,
       filesystem_actor filesystem, path dir, size_t partition_capacity,
       size_t in_mem_partitions, size_t taste_partitions, size_t num_workers,
-      double meta_index_fp_rate);
+      double meta_index_fp_rate, size_t predicate_cache_size,
+      bool partition_per_layout, duration active_partition_timeout);
 
 } // namespace vast::system
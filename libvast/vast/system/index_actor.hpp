@@ -44,7 +44,14 @@ using index_actor = caf::typed_actor<
   // Replaces the SYNOPSIS of the PARTITION witht he given partition id.
   caf::reacts_to<atom::replace, uuid, std::shared_ptr<partition_synopsis>>,
   // Erases the given events from the INDEX, and returns their ids.
-  caf::replies_to<atom::erase, uuid>::with<ids>>
+  caf::replies_to<atom::erase, uuid>::with<ids>,
+  // Bounds the number of events that match an expression from the META INDEX
+  // alone.
+  caf::replies_to<atom::estimate, expression>::with<uint64_t, uint64_t>,
+  // The internal telemetry loop of the INDEX.
+  caf::reacts_to<atom::telemetry>,
+  // The internal loop of the INDEX that persists idle active partitions.
+  caf::reacts_to<atom::ping>>
   // Conform to the protocol of the QUERY SUPERVISOR MASTER actor.
   ::extend_with<query_supervisor_master_actor>
   // Conform to the procol of the STATUS CLIENT actor.
@@ -27,6 +27,7 @@
 #include "vast/defaults.hpp"
 #include "vast/detail/make_io_stream.hpp"
 #include "vast/detail/string.hpp"
+#include "vast/detail/udp_receiver.hpp"
 #include "vast/endpoint.hpp"
 #include "vast/error.hpp"
 #include "vast/expression.hpp"
@@ -102,6 +103,15 @@ make_source(const Actor& self, caf::actor_system& sys, const invocation& inv,
                            defaults::import::table_slice_size);
   if (slice_size == 0)
     slice_size = std::numeric_limits<decltype(slice_size)>::max();
+  auto receiver_options = detail::udp_receiver::options{
+    get_or(options, "vast.import.udp-batch-size",
+           defaults::import::udp_batch_size),
+    get_or(options, "vast.import.udp-max-datagram-size",
+           defaults::import::udp_max_datagram_size),
+    get_or(options, "vast.import.udp-buffers", defaults::import::udp_buffers),
+    get_or(options, "vast.import.udp-socket-buffer-size",
+           defaults::import::udp_socket_buffer_size),
+  };
   // Parse schema local to the import command.
   auto schema = get_schema(options, category);
   if (!schema)
@@ -171,7 +181,7 @@ make_source(const Actor& self, caf::actor_system& sys, const invocation& inv,
     [&](auto&&... args) {
       if (udp_port)
         return sys.middleman().spawn_broker<SpawnOptions>(
-          datagram_source<Reader>, *udp_port,
+          datagram_source<Reader>, *udp_port, receiver_options,
           std::forward<decltype(args)>(args)...);
       else
         return sys.spawn<SpawnOptions>(source<Reader>,
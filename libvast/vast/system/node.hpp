@@ -18,6 +18,7 @@
 #include "vast/error.hpp"
 #include "vast/path.hpp"
 #include "vast/system/archive.hpp"
+#include "vast/system/async_filesystem.hpp"
 #include "vast/system/component_registry.hpp"
 #include "vast/system/spawn_arguments.hpp"
 
@@ -76,7 +77,9 @@ struct node_state {
 /// @param name The unique name of the node.
 /// @param dir The directory where to store persistent state.
 /// @param shutdown_grace_period Time to give components to shutdown cleanly.
+/// @param filesystem_config The configuration of the filesystem.
 caf::behavior node(node_actor* self, std::string name, path dir,
-                   std::chrono::milliseconds shutdown_grace_period);
+                   std::chrono::milliseconds shutdown_grace_period,
+                   async_filesystem_config filesystem_config);
 
 } // namespace vast::system
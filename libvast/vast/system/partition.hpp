@@ -29,10 +29,12 @@
 #include "vast/system/indexer.hpp"
 #include "vast/system/instrumentation.hpp"
 #include "vast/system/partition_actor.hpp"
+#include "vast/system/predicate_cache.hpp"
 #include "vast/table_slice_column.hpp"
 #include "vast/type.hpp"
 #include "vast/uuid.hpp"
 #include "vast/value_index.hpp"
+#include "vast/zone_map.hpp"
 
 #include <caf/optional.hpp>
 #include <caf/stream_slot.hpp>
@@ -86,6 +88,9 @@ struct active_partition_state {
   /// Maps type names to IDs. Used the answer #type queries.
   std::unordered_map<std::string, ids> type_ids;
 
+  /// Summarizes every table slice to rule out slices before evaluation.
+  zone_map zones;
+
   /// Partition synopsis for this partition. This is built up in parallel
   /// to the one in the index, so it can be shrinked and serialized into
   /// a `Partition` flatbuffer upon completion of this partition. Will be
@@ -125,7 +130,7 @@ struct active_partition_state {
   size_t persisted_indexers;
 
   /// Temporary storage for the serialized indexers of this partition, before
-  /// they get written into the flatbuffer.
+  /// they get written to disk behind the flatbuffer.
   std::map<caf::actor_id, vast::chunk_ptr> chunks;
 
   /// A once_flag for things that need to be done only once at shutdown.
@@ -144,7 +149,9 @@ struct passive_partition_state {
 
   // -- utility functions ------------------------------------------------------
 
-  indexer_actor indexer_at(size_t position) const;
+  /// Returns the value index at a position in the combined layout, or
+  /// `nullptr` if it cannot be deserialized.
+  const value_index* index_at(size_t position) const;
 
   // -- data members -----------------------------------------------------------
 
@@ -160,6 +167,12 @@ struct passive_partition_state {
   /// Maps type names to ids. Used the answer #type queries.
   std::unordered_map<std::string, ids> type_ids;
 
+  /// Summarizes every table slice to rule out slices before evaluation.
+  zone_map zones;
+
+  /// Caches the results of predicates across queries; may be null.
+  predicate_cache_ptr cache;
+
   /// A readable name for this partition
   std::string name;
 
@@ -180,9 +193,9 @@ struct passive_partition_state {
   /// A typed view into the `partition_chunk`.
   const fbs::partition::v0* flatbuffer;
 
-  /// Maps qualified fields to indexer actors. This is mutable since
-  /// indexers are spawned lazily on first access.
-  mutable std::vector<indexer_actor> indexers;
+  /// Maps qualified fields to value indexes. This is mutable since value
+  /// indexes are deserialized lazily on first access.
+  mutable std::vector<value_index_ptr> indexes;
 };
 
 // -- flatbuffers --------------------------------------------------------------
@@ -190,6 +203,14 @@ struct passive_partition_state {
 caf::expected<flatbuffers::Offset<fbs::Partition>>
 pack(flatbuffers::FlatBufferBuilder& builder, const active_partition_state& x);
 
+/// Serializes a partition without copying the serialized indexers into a
+/// builder.
+/// @param x The partition state with a chunk for every indexer.
+/// @returns A sequence of chunks whose concatenation is the finished partition
+///          flatbuffer. The serialized indexers appear as-is.
+caf::expected<std::vector<chunk_ptr>>
+pack_chunks(const active_partition_state& x);
+
 caf::error unpack(const fbs::partition::v0& x, passive_partition_state& y);
 
 caf::error unpack(const fbs::partition::v0& x, partition_synopsis& y);
@@ -207,13 +228,17 @@ active_partition_actor::behavior_type active_partition(
   uuid id, filesystem_actor filesystem, caf::settings index_opts,
   caf::settings synopsis_opts);
 
-/// Spawns a read-only partition.
+/// Spawns a read-only partition. It evaluates queries directly on its value
+/// indexes, which it deserializes on first use, rather than delegating to
+/// INDEXER actors.
 /// @param self The partition actor.
 /// @param id The UUID of this partition.
 /// @param filesystem The actor handle of the filesystem actor.
 /// @param path The path where the partition flatbuffer can be found.
+/// @param cache The cache for predicate results shared between all passive
+///              partitions, or `nullptr` to evaluate all predicates anew.
 partition_actor::behavior_type passive_partition(
   partition_actor::stateful_pointer<passive_partition_state> self, uuid id,
-  filesystem_actor filesystem, vast::path path);
+  filesystem_actor filesystem, vast::path path, predicate_cache_ptr cache);
 
 } // namespace vast::system
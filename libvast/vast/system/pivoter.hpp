@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include "vast/data.hpp"
+#include "vast/defaults.hpp"
 #include "vast/expression.hpp"
 #include "vast/fwd.hpp"
 #include "vast/system/node.hpp"
@@ -56,6 +58,15 @@ struct pivoter_state {
   ///       string.
   std::unordered_set<std::string> requested_ids;
 
+  /// The pivot values per field that were not queried for yet. Rather than
+  /// issuing one query per table slice, the PIVOTER collects the values into
+  /// large membership predicates.
+  std::unordered_map<std::string, list> pending_ids;
+
+  /// The number of pending values that triggers a query even if another
+  /// query is still running.
+  size_t batch_size = defaults::pivot::batch_size;
+
   /// A cache for the connections between a source type and the target type,
   /// to avoid multiple computations of those.
   mutable std::unordered_map<record_type, caf::optional<record_field>> cache;
@@ -75,6 +86,16 @@ struct pivoter_state {
 
   /// A handle to the sink for the resulting table silces.
   caf::actor sink;
+
+  // -- member functions -------------------------------------------------------
+
+  /// Spawns an EXPORTER for the pending values of every field and clears
+  /// them.
+  void flush();
+
+  /// Terminates the PIVOTER if the initial query completed and no values or
+  /// queries are outstanding.
+  void quit_if_done();
 };
 
 /// The PIVOTER receives table slices and constructs new queries for the target
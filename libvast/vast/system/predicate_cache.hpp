@@ -0,0 +1,119 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/fwd.hpp"
+
+#include "vast/data.hpp"
+#include "vast/expression.hpp"
+#include "vast/ids.hpp"
+#include "vast/operator.hpp"
+#include "vast/uuid.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace vast::system {
+
+/// Caches the results of predicates that passive partitions evaluated, so
+/// that repeated queries do not have to consult the value indexes again.
+/// Since passive partitions are immutable, a result remains valid until its
+/// partition gets erased.
+///
+/// The cache evicts the least recently used results when their combined size
+/// exceeds the capacity. All member functions are thread-safe, because the
+/// cache is shared between all passive PARTITION actors of an INDEX.
+class predicate_cache {
+public:
+  /// Identifies a predicate by the column of a partition and the curried
+  /// predicate that applies to it.
+  struct key {
+    uuid partition;
+    size_t column;
+    relational_operator op;
+    data rhs;
+
+    friend bool operator==(const key& x, const key& y);
+  };
+
+  /// Counters that describe the effectiveness of the cache.
+  struct statistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+  };
+
+  /// Constructs a cache.
+  /// @param capacity The maximum number of bytes that cached results occupy.
+  explicit predicate_cache(size_t capacity);
+
+  /// Retrieves the cached result of a predicate.
+  /// @param x The predicate to look for.
+  /// @returns The result of *x*, or `std::nullopt` if it is not cached.
+  std::optional<ids> lookup(const key& x);
+
+  /// Adds the result of a predicate, evicting other results if necessary.
+  /// Results larger than the capacity are not cached.
+  /// @param x The evaluated predicate.
+  /// @param result The IDs that match *x*.
+  void insert(key x, ids result);
+
+  /// Removes all results for a partition.
+  /// @param partition The ID of the partition to forget.
+  void erase(const uuid& partition);
+
+  /// @returns the number of cached results.
+  size_t size() const;
+
+  /// @returns the approximate number of bytes occupied by cached results.
+  size_t size_bytes() const;
+
+  /// @returns the maximum number of bytes that cached results occupy.
+  size_t capacity() const;
+
+  /// @returns the counters since the construction of the cache.
+  statistics stats() const;
+
+private:
+  struct key_hash {
+    size_t operator()(const key& x) const;
+  };
+
+  struct entry {
+    key predicate;
+    ids result;
+    size_t bytes;
+  };
+
+  using entry_list = std::list<entry>;
+
+  void evict(entry_list::iterator i);
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  size_t size_bytes_ = 0;
+  statistics stats_;
+  entry_list entries_; // most recently used first
+  std::unordered_map<key, entry_list::iterator, key_hash> index_;
+};
+
+/// @relates predicate_cache
+using predicate_cache_ptr = std::shared_ptr<predicate_cache>;
+
+} // namespace vast::system
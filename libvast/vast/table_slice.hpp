@@ -23,6 +23,7 @@
 #include <caf/meta/load_callback.hpp>
 #include <caf/meta/type_name.hpp>
 
+#include <string>
 #include <vector>
 
 namespace vast {
@@ -268,6 +269,25 @@ table_slice truncate(const table_slice& slice, size_t num_rows);
 std::pair<table_slice, table_slice>
 split(const table_slice& slice, size_t partition_point);
 
+/// Resolves field names to the columns of a layout. A field selects a column
+/// if it is a suffix of the fully qualified column name or of the name of an
+/// enclosing record, e.g., both `orig_h` and `id` select `zeek.conn.id.orig_h`.
+/// @param layout The layout to resolve *fields* against.
+/// @param fields The names of the fields to select.
+/// @returns the flat indices of the selected columns in ascending order.
+std::vector<size_t>
+resolve_columns(const record_type& layout, const std::vector<std::string>& fields);
+
+/// Projects a table slice onto a subset of its columns.
+/// @param slice The input table slice.
+/// @param columns The flat indices of the columns to keep in ascending order.
+/// @returns `slice` if *columns* selects all columns, otherwise a new table
+///          slice of the same encoding and with the same offset that contains
+///          only the selected columns.
+/// @pre `slice.encoding() != table_slice_encoding::none`
+/// @pre `!columns.empty()`
+table_slice project(const table_slice& slice, const std::vector<size_t>& columns);
+
 /// Counts the number of total rows of multiple table slices.
 /// @param slices The table slices to count.
 /// @returns The sum of rows across *slices*.
@@ -61,6 +61,16 @@ public:
   /// @returns The result of the lookup or an error upon failure.
   caf::expected<ids> lookup(relational_operator op, data_view x) const;
 
+  /// Looks up multiple values at once, i.e., computes the union of the
+  /// equality lookups of all values in a list, including nil. Concrete index types may share
+  /// work between the values, e.g., by looking them up in sorted order.
+  /// Lookups of the form `x in [...]` and `x !in [...]` go through this
+  /// function.
+  /// @param xs The values to look up.
+  /// @returns The IDs of all values that equal one of *xs* or an error upon
+  ///          failure.
+  caf::expected<ids> lookup_many(view<list> xs) const;
+
   /// Merges another value index with this one.
   /// @param other The value index to merge.
   /// @returns `true` on success.
@@ -92,6 +102,10 @@ private:
   virtual caf::expected<ids>
   lookup_impl(relational_operator op, data_view x) const = 0;
 
+  /// Computes the union of the equality lookups of all non-nil values in a
+  /// list. The default implementation performs one lookup per value.
+  virtual caf::expected<ids> lookup_many_impl(view<list> xs) const;
+
   ewah_bitmap mask_;         ///< The position of all values excluding nil.
   ewah_bitmap none_;         ///< The positions of nil values.
   const vast::type type_;    ///< The type of this index.
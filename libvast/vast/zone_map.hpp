@@ -0,0 +1,126 @@
+/******************************************************************************
+ *                    _   _____   __________                                  *
+ *                   | | / / _ | / __/_  __/     Visibility                   *
+ *                   | |/ / __ |_\ \  / /          Across                     *
+ *                   |___/_/ |_/___/ /_/       Space and Time                 *
+ *                                                                            *
+ * This file is part of VAST. It is subject to the license terms in the       *
+ * LICENSE file found in the top-level directory of this distribution and at  *
+ * http://vast.io/license. No part of VAST, including this file, may be       *
+ * copied, modified, propagated, or distributed except according to the terms *
+ * contained in the LICENSE file.                                             *
+ ******************************************************************************/
+
+#pragma once
+
+#include "vast/fwd.hpp"
+
+#include "vast/aliases.hpp"
+#include "vast/data.hpp"
+#include "vast/ids.hpp"
+#include "vast/qualified_record_field.hpp"
+#include "vast/type.hpp"
+
+#include <caf/meta/type_name.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vast {
+
+/// Summarizes the arithmetic and temporal columns of every table slice in a
+/// partition by their minimum, maximum, and number of nil values. This allows
+/// for ruling out entire table slices of a partition, e.g., for queries over
+/// narrow time windows, before asking its indexers.
+class zone_map {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// The summary of a single column within a table slice.
+  struct column_range {
+    /// The position of the column in `columns()`.
+    uint64_t column = 0;
+
+    /// The smallest non-nil value, or nil if all values are nil.
+    data min;
+
+    /// The largest non-nil value, or nil if all values are nil.
+    data max;
+
+    /// The number of nil values.
+    uint64_t nils = 0;
+
+    template <class Inspector>
+    friend auto inspect(Inspector& f, column_range& x) {
+      return f(x.column, x.min, x.max, x.nils);
+    }
+  };
+
+  /// The summary of a single table slice.
+  struct zone {
+    /// The ID of the first event in the table slice.
+    id offset = 0;
+
+    /// The number of events in the table slice.
+    uint64_t rows = 0;
+
+    /// The name of the table slice layout.
+    std::string layout;
+
+    /// The summaries of all columns that support range queries.
+    std::vector<column_range> ranges;
+
+    template <class Inspector>
+    friend auto inspect(Inspector& f, zone& x) {
+      return f(x.offset, x.rows, x.layout, x.ranges);
+    }
+  };
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a summary of a table slice. Table slices must not overlap.
+  /// @param slice The table slice to summarize.
+  void add(const table_slice& slice);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Computes the IDs of all table slices that may contain events matching
+  /// an expression. The result never rules out a matching event.
+  /// @param expr The expression to check.
+  /// @returns The IDs of all table slices that could not be ruled out.
+  ids lookup(const expression& expr) const;
+
+  /// @returns `true` if the zone map contains no table slice summaries.
+  bool empty() const;
+
+  /// @returns The columns of all summarized table slices.
+  const std::vector<qualified_record_field>& columns() const;
+
+  /// @returns The summaries of all table slices, ordered by their offset.
+  const std::vector<zone>& zones() const;
+
+  // -- concepts ---------------------------------------------------------------
+
+  template <class Inspector>
+  friend auto inspect(Inspector& f, zone_map& x) {
+    return f(caf::meta::type_name("vast.zone_map"), x.columns_, x.zones_);
+  }
+
+private:
+  /// Maps the columns of a flattened layout to positions in `columns_`.
+  const std::vector<uint64_t>& columns_for(const record_type& layout);
+
+  /// The columns of all table slices, including the ones without a summary.
+  std::vector<qualified_record_field> columns_;
+
+  /// The summaries of all table slices, ordered by their offset.
+  std::vector<zone> zones_;
+
+  /// Caches the column mapping per layout. Only needed while adding table
+  /// slices, so it does not get serialized.
+  std::unordered_map<type, std::vector<uint64_t>> layout_columns_;
+};
+
+} // namespace vast
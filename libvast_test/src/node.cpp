@@ -33,8 +33,12 @@ node::node() {
   // procedure to abort too early, before the to-be-terminated components had a
   // chance to deliver their DOWN message.
   auto infinte_grace_period = std::chrono::milliseconds::zero();
+  // The deterministic scheduler cannot wait for results from I/O threads, so
+  // the filesystem performs all operations synchronously.
+  auto filesystem_config = system::async_filesystem_config{};
+  filesystem_config.threads = 0;
   test_node = self->spawn(system::node, "test", directory / "node",
-                          infinte_grace_period);
+                          infinte_grace_period, filesystem_config);
   run();
   MESSAGE("spawning components");
   spawn_component("type-registry");